@@ -147,6 +147,12 @@ AssemblyMainWindow::AssemblyMainWindow(const QString& outputdir_path, const QStr
       NQLog("AssemblyMainWindow", NQLog::Critical) << "initialization error: null pointer to AssemblyVUEyeCamera object (camera_ID=" << camera_ID_ << ")";
       NQLog("AssemblyMainWindow", NQLog::Critical) << "---------------------------------------------------------------------------------";
     }
+
+#ifdef NOUEYE
+    // fake camera: defocus blur follows the Z position of the (fake) motion stage
+    AssemblyUEyeFakeCamera* fake_camera = dynamic_cast<AssemblyUEyeFakeCamera*>(camera_);
+    if(fake_camera != nullptr){ fake_camera->setMotionModel(motion_model_); }
+#endif
     /// -------------------
 
     /// Vacuum Manager
@@ -17,6 +17,7 @@
 #include <AssemblyUEyeCameraThread.h>
 #ifdef NOUEYE
 #include <AssemblyUEyeFakeModel.h>
+#include <AssemblyUEyeFakeCamera.h>
 typedef AssemblyUEyeFakeModel AssemblyUEyeModel_t;
 #else
 #include <AssemblyUEyeModel.h>
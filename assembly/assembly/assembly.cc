@@ -58,6 +58,9 @@ int main(int argc, char** argv)
     NQLogger::instance()->addActiveModule("*");
     NQLogger::instance()->addDestiniation(stdout, nqloglevel_stdout);
 
+    // write log messages from a background thread (hot loops log at Debug/Spam)
+    NQLogger::instance()->setAsynchronous(config->getValue<bool>("LogAsynchronous", true));
+
     const QString timestamp = QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss");
 
     const QString outputdir_path = assembly::QtCacheDirectory()+"/"+timestamp;
@@ -35,7 +35,10 @@ AssemblyAssemblyV2::AssemblyAssemblyV2(const LStepExpressMotionManager* const mo
  , pickup2_Z_(0.)
 
  , use_smartMove_(false)
- , in_action_(false)
+ , motion_in_action_(false)
+ , vacuum_in_action_(-1)
+
+ , scheduler_(nullptr)
 
  , PSSPlusSpacersToMaPSAPosition_isRegistered_(false)
  , PSSPlusSpacersToMaPSAPosition_X_(0.)
@@ -67,6 +70,12 @@ AssemblyAssemblyV2::AssemblyAssemblyV2(const LStepExpressMotionManager* const mo
   pickup2_Z_ = config->getValue<double>("AssemblyAssembly_pickup2_Z");
 
   alreadyClicked_LowerPickupToolOntoMaPSA = false; alreadyClicked_LowerPickupToolOntoPSS = false; alreadyClicked_LowerMaPSAOntoBaseplate = false; alreadyClicked_LowerPSSOntoSpacers = false; alreadyClicked_LowerPSSPlusSpacersOntoGluingStage = false; alreadyClicked_LowerPSSPlusSpacersOntoMaPSA = false;
+
+  scheduler_ = new AssemblyStepScheduler(this);
+  scheduler_->set_step_timeout(config->getValue<double>("AssemblyAssemblyV2_stepTimeout", 300.));
+
+  // scheduled steps are not waited for after an emergency stop
+  connect(this->motion()->model(), SIGNAL(emergencyStop_request()), scheduler_, SLOT(abort()));
 }
 
 const LStepExpressMotionManager* AssemblyAssemblyV2::motion() const
@@ -110,6 +119,51 @@ AssemblyParameters* AssemblyAssemblyV2::parameters() const
   return params;
 }
 
+bool AssemblyAssemblyV2::motion_locked() const
+{
+  if(motion_in_action_){ return true; }
+  if(vacuum_in_action_ == -1){ return false; }
+
+  // a vacuum switch is in progress: only the scheduler may start a motion concurrently,
+  // and never while the pickup-tool vacuum (holding the moved object) is being switched
+  return !(scheduler_->is_starting_step() && (vacuum_in_action_ != vacuum_pickup_));
+}
+
+bool AssemblyAssemblyV2::vacuum_locked(const int line) const
+{
+  if(vacuum_in_action_ != -1){ return true; }
+  if(motion_in_action_ == false){ return false; }
+
+  // a motion is in progress: only the scheduler may switch a vacuum line concurrently,
+  // and never the pickup-tool vacuum
+  return !(scheduler_->is_starting_step() && (line != vacuum_pickup_));
+}
+
+void AssemblyAssemblyV2::reject_scheduled_start()
+{
+  // a scheduled step that is refused fails its schedule, instead of leaving it waiting for the step
+  if(scheduler_->is_starting_step()){ scheduler_->reject_step(); }
+}
+
+unsigned int AssemblyAssemblyV2::vacuum_resources(const int line) const
+{
+  // the pickup-tool vacuum holds the object moved by the motion stage
+  return (line == vacuum_pickup_) ? (Resource_Vacuum | Resource_Motion) : Resource_Vacuum;
+}
+
+void AssemblyAssemblyV2::abort_scheduled_steps()
+{
+  if(scheduler_->is_running() == false)
+  {
+    NQLog("AssemblyAssemblyV2", NQLog::Message) << "abort_scheduled_steps"
+       << ": no scheduled assembly step in progress, no action taken";
+
+    return;
+  }
+
+  scheduler_->abort();
+}
+
 void AssemblyAssemblyV2::use_smartMove(const int state)
 {
   if(state == 2)
@@ -151,11 +205,13 @@ void AssemblyAssemblyV2::use_smartMove(const int state)
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::GoToSensorMarkerPreAlignment_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "GoToSensorMarkerPreAlignment_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -182,7 +238,7 @@ void AssemblyAssemblyV2::GoToSensorMarkerPreAlignment_start()
   connect(this, SIGNAL(move_absolute_request(double, double, double, double)), motion_, SLOT(moveAbsolute(double, double, double, double)));
   connect(motion_, SIGNAL(motion_finished()), this, SLOT(GoToSensorMarkerPreAlignment_finish()));
 
-  in_action_ = true;
+  motion_in_action_ = true;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "GoToSensorMarkerPreAlignment_start"
      << ": emitting signal \"move_absolute_request(" << x0 << ", " << y0 << ", " << z0 << ", " << a0 << ")\"";
@@ -195,7 +251,7 @@ void AssemblyAssemblyV2::GoToSensorMarkerPreAlignment_finish()
   disconnect(this, SIGNAL(move_absolute_request(double, double, double, double)), motion_, SLOT(moveAbsolute(double, double, double, double)));
   disconnect(motion_, SIGNAL(motion_finished()), this, SLOT(GoToSensorMarkerPreAlignment_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "GoToSensorMarkerPreAlignment_finish"
      << ": emitting signal \"GoToSensorMarkerPreAlignment_finished\"";
@@ -214,11 +270,13 @@ void AssemblyAssemblyV2::GoToSensorMarkerPreAlignment_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::EnableVacuumPickupTool_start()
 {
-  if(in_action_){
+  if(this->vacuum_locked(vacuum_pickup_)){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "EnableVacuumPickupTool_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -228,7 +286,7 @@ void AssemblyAssemblyV2::EnableVacuumPickupTool_start()
   connect(this->vacuum(), SIGNAL(vacuum_toggled()), this, SLOT(EnableVacuumPickupTool_finish()));
   connect(this->vacuum(), SIGNAL(vacuum_error  ()), this, SLOT(EnableVacuumPickupTool_finish()));
 
-  in_action_ = true;
+  vacuum_in_action_ = vacuum_pickup_;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "EnableVacuumPickupTool_start"
      << ": emitting signal \"vacuum_ON_request(" << vacuum_pickup_ << ")\"";
@@ -244,7 +302,7 @@ void AssemblyAssemblyV2::EnableVacuumPickupTool_finish()
   disconnect(this->vacuum(), SIGNAL(vacuum_toggled()), this, SLOT(EnableVacuumPickupTool_finish()));
   disconnect(this->vacuum(), SIGNAL(vacuum_error  ()), this, SLOT(EnableVacuumPickupTool_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  vacuum_in_action_ = -1;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "EnableVacuumPickupTool_finish"
      << ": emitting signal \"EnableVacuumPickupTool_finished\"";
@@ -263,11 +321,13 @@ void AssemblyAssemblyV2::EnableVacuumPickupTool_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::DisableVacuumPickupTool_start()
 {
-  if(in_action_){
+  if(this->vacuum_locked(vacuum_pickup_)){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "DisableVacuumPickupTool_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -277,7 +337,7 @@ void AssemblyAssemblyV2::DisableVacuumPickupTool_start()
   connect(this->vacuum(), SIGNAL(vacuum_toggled ()), this, SLOT(DisableVacuumPickupTool_finish()));
   connect(this->vacuum(), SIGNAL(vacuum_error   ()), this, SLOT(DisableVacuumPickupTool_finish()));
 
-  in_action_ = true;
+  vacuum_in_action_ = vacuum_pickup_;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "DisableVacuumPickupTool_start"
      << ": emitting signal \"vacuum_OFF_request(" << vacuum_pickup_ << ")\"";
@@ -293,7 +353,7 @@ void AssemblyAssemblyV2::DisableVacuumPickupTool_finish()
   disconnect(this->vacuum(), SIGNAL(vacuum_toggled ()), this, SLOT(DisableVacuumPickupTool_finish()));
   disconnect(this->vacuum(), SIGNAL(vacuum_error   ()), this, SLOT(DisableVacuumPickupTool_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  vacuum_in_action_ = -1;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "DisableVacuumPickupTool_finish"
      << ": emitting signal \"DisableVacuumPickupTool_finished\"";
@@ -312,11 +372,13 @@ void AssemblyAssemblyV2::DisableVacuumPickupTool_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::EnableVacuumSpacers_start()
 {
-  if(in_action_){
+  if(this->vacuum_locked(vacuum_spacer_)){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "EnableVacuumSpacers_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -326,7 +388,7 @@ void AssemblyAssemblyV2::EnableVacuumSpacers_start()
   connect(this->vacuum(), SIGNAL(vacuum_toggled()), this, SLOT(EnableVacuumSpacers_finish()));
   connect(this->vacuum(), SIGNAL(vacuum_error  ()), this, SLOT(EnableVacuumSpacers_finish()));
 
-  in_action_ = true;
+  vacuum_in_action_ = vacuum_spacer_;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "EnableVacuumSpacers_start"
      << ": emitting signal \"vacuum_ON_request(" << vacuum_spacer_ << ")\"";
@@ -342,7 +404,7 @@ void AssemblyAssemblyV2::EnableVacuumSpacers_finish()
   disconnect(this->vacuum(), SIGNAL(vacuum_toggled()), this, SLOT(EnableVacuumSpacers_finish()));
   disconnect(this->vacuum(), SIGNAL(vacuum_error  ()), this, SLOT(EnableVacuumSpacers_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  vacuum_in_action_ = -1;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "EnableVacuumSpacers_finish"
      << ": emitting signal \"EnableVacuumSpacers_finished\"";
@@ -361,11 +423,13 @@ void AssemblyAssemblyV2::EnableVacuumSpacers_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::DisableVacuumSpacers_start()
 {
-  if(in_action_){
+  if(this->vacuum_locked(vacuum_spacer_)){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "DisableVacuumSpacers_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -375,7 +439,7 @@ void AssemblyAssemblyV2::DisableVacuumSpacers_start()
   connect(this->vacuum(), SIGNAL(vacuum_toggled ()), this, SLOT(DisableVacuumSpacers_finish()));
   connect(this->vacuum(), SIGNAL(vacuum_error   ()), this, SLOT(DisableVacuumSpacers_finish()));
 
-  in_action_ = true;
+  vacuum_in_action_ = vacuum_spacer_;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "DisableVacuumSpacers_start"
      << ": emitting signal \"vacuum_OFF_request(" << vacuum_spacer_ << ")\"";
@@ -391,7 +455,7 @@ void AssemblyAssemblyV2::DisableVacuumSpacers_finish()
   disconnect(this->vacuum(), SIGNAL(vacuum_toggled ()), this, SLOT(DisableVacuumSpacers_finish()));
   disconnect(this->vacuum(), SIGNAL(vacuum_error   ()), this, SLOT(DisableVacuumSpacers_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  vacuum_in_action_ = -1;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "DisableVacuumSpacers_finish"
      << ": emitting signal \"DisableVacuumSpacers_finished\"";
@@ -410,11 +474,13 @@ void AssemblyAssemblyV2::DisableVacuumSpacers_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::EnableVacuumBaseplate_start()
 {
-  if(in_action_){
+  if(this->vacuum_locked(vacuum_basepl_)){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "EnableVacuumBaseplate_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -424,7 +490,7 @@ void AssemblyAssemblyV2::EnableVacuumBaseplate_start()
   connect(this->vacuum(), SIGNAL(vacuum_toggled()), this, SLOT(EnableVacuumBaseplate_finish()));
   connect(this->vacuum(), SIGNAL(vacuum_error  ()), this, SLOT(EnableVacuumBaseplate_finish()));
 
-  in_action_ = true;
+  vacuum_in_action_ = vacuum_basepl_;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "EnableVacuumBaseplate_start"
      << ": emitting signal \"vacuum_ON_request(" << vacuum_basepl_ << ")\"";
@@ -440,7 +506,7 @@ void AssemblyAssemblyV2::EnableVacuumBaseplate_finish()
   disconnect(this->vacuum(), SIGNAL(vacuum_toggled()), this, SLOT(EnableVacuumBaseplate_finish()));
   disconnect(this->vacuum(), SIGNAL(vacuum_error  ()), this, SLOT(EnableVacuumBaseplate_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  vacuum_in_action_ = -1;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "EnableVacuumBaseplate_finish"
      << ": emitting signal \"EnableVacuumBaseplate_finished\"";
@@ -459,11 +525,13 @@ void AssemblyAssemblyV2::EnableVacuumBaseplate_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::DisableVacuumBaseplate_start()
 {
-  if(in_action_){
+  if(this->vacuum_locked(vacuum_basepl_)){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "DisableVacuumBaseplate_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -473,7 +541,7 @@ void AssemblyAssemblyV2::DisableVacuumBaseplate_start()
   connect(this->vacuum(), SIGNAL(vacuum_toggled ()), this, SLOT(DisableVacuumBaseplate_finish()));
   connect(this->vacuum(), SIGNAL(vacuum_error   ()), this, SLOT(DisableVacuumBaseplate_finish()));
 
-  in_action_ = true;
+  vacuum_in_action_ = vacuum_basepl_;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "DisableVacuumBaseplate_start"
      << ": emitting signal \"vacuum_OFF_request(" << vacuum_basepl_ << ")\"";
@@ -489,7 +557,7 @@ void AssemblyAssemblyV2::DisableVacuumBaseplate_finish()
   disconnect(this->vacuum(), SIGNAL(vacuum_toggled ()), this, SLOT(DisableVacuumBaseplate_finish()));
   disconnect(this->vacuum(), SIGNAL(vacuum_error   ()), this, SLOT(DisableVacuumBaseplate_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  vacuum_in_action_ = -1;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "DisableVacuumBaseplate_finish"
      << ": emitting signal \"DisableVacuumBaseplate_finished\"";
@@ -508,11 +576,13 @@ void AssemblyAssemblyV2::DisableVacuumBaseplate_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::GoFromSensorMarkerToPickupXY_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "GoFromSensorMarkerToPickupXY_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -539,7 +609,7 @@ void AssemblyAssemblyV2::GoFromSensorMarkerToPickupXY_start()
   connect(this, SIGNAL(move_relative_request(double, double, double, double)), motion_, SLOT(moveRelative(double, double, double, double)));
   connect(motion_, SIGNAL(motion_finished()), this, SLOT(GoFromSensorMarkerToPickupXY_finish()));
 
-  in_action_ = true;
+  motion_in_action_ = true;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "GoFromSensorMarkerToPickupXY_start"
      << ": emitting signal \"move_relative_request(" << dx0 << ", " << dy0 << ", " << dz0 << ", " << da0 << ")\"";
@@ -552,7 +622,7 @@ void AssemblyAssemblyV2::GoFromSensorMarkerToPickupXY_finish()
   disconnect(this, SIGNAL(move_relative_request(double, double, double, double)), motion_, SLOT(moveRelative(double, double, double, double)));
   disconnect(motion_, SIGNAL(motion_finished()), this, SLOT(GoFromSensorMarkerToPickupXY_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "GoFromSensorMarkerToPickupXY_finish"
      << ": emitting signal \"GoFromSensorMarkerToPickupXY_finished\"";
@@ -571,11 +641,13 @@ void AssemblyAssemblyV2::GoFromSensorMarkerToPickupXY_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::LowerPickupToolOntoMaPSA_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "LowerPickupToolOntoMaPSA_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -626,7 +698,7 @@ void AssemblyAssemblyV2::LowerPickupToolOntoMaPSA_start()
     connect(this, SIGNAL(move_relative_request(double, double, double, double)), smart_motion_, SLOT(move_relative(double, double, double, double)));
     connect(smart_motion_, SIGNAL(motion_completed()), this, SLOT(LowerPickupToolOntoMaPSA_finish()));
 
-    in_action_ = true;
+    motion_in_action_ = true;
 
     NQLog("AssemblyAssemblyV2", NQLog::Spam) << "LowerPickupToolOntoMaPSA_start"
        << ": emitting signal \"move_relative_request(" << dx0 << ", " << dy0 << ", " << dz0 << ", " << da0 << ")\"";
@@ -656,7 +728,7 @@ void AssemblyAssemblyV2::LowerPickupToolOntoMaPSA_finish()
   disconnect(this, SIGNAL(move_relative_request(double, double, double, double)), smart_motion_, SLOT(move_relative(double, double, double, double)));
   disconnect(smart_motion_, SIGNAL(motion_completed()), this, SLOT(LowerPickupToolOntoMaPSA_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "LowerPickupToolOntoMaPSA_finish"
      << ": emitting signal \"LowerPickupToolOntoMaPSA_finished\"";
@@ -675,11 +747,13 @@ void AssemblyAssemblyV2::LowerPickupToolOntoMaPSA_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::LowerPickupToolOntoPSS_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "LowerPickupToolOntoPSS_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -727,7 +801,7 @@ void AssemblyAssemblyV2::LowerPickupToolOntoPSS_start()
     connect(this, SIGNAL(move_relative_request(double, double, double, double)), smart_motion_, SLOT(move_relative(double, double, double, double)));
     connect(smart_motion_, SIGNAL(motion_completed()), this, SLOT(LowerPickupToolOntoPSS_finish()));
 
-    in_action_ = true;
+    motion_in_action_ = true;
 
     NQLog("AssemblyAssemblyV2", NQLog::Spam) << "LowerPickupToolOntoPSS_start"
        << ": emitting signal \"move_relative_request(" << dx0 << ", " << dy0 << ", " << dz0 << ", " << da0 << ")\"";
@@ -757,7 +831,7 @@ void AssemblyAssemblyV2::LowerPickupToolOntoPSS_finish()
   disconnect(this, SIGNAL(move_relative_request(double, double, double, double)), smart_motion_, SLOT(move_relative(double, double, double, double)));
   disconnect(smart_motion_, SIGNAL(motion_completed()), this, SLOT(LowerPickupToolOntoPSS_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "LowerPickupToolOntoPSS_finish"
      << ": emitting signal \"LowerPickupToolOntoPSS_finished\"";
@@ -776,11 +850,13 @@ void AssemblyAssemblyV2::LowerPickupToolOntoPSS_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::PickupMaPSA_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "PickupMaPSA_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -805,7 +881,7 @@ void AssemblyAssemblyV2::PickupMaPSA_start()
   connect(this, SIGNAL(move_relative_request(double, double, double, double)), motion_, SLOT(moveRelative(double, double, double, double)));
   connect(motion_, SIGNAL(motion_finished()), this, SLOT(PickupMaPSA_finish()));
 
-  in_action_ = true;
+  motion_in_action_ = true;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "PickupMaPSA_start"
      << ": emitting signal \"move_relative_request(" << dx0 << ", " << dy0 << ", " << dz0 << ", " << da0 << ")\"";
@@ -818,7 +894,7 @@ void AssemblyAssemblyV2::PickupMaPSA_finish()
   disconnect(this, SIGNAL(move_relative_request(double, double, double, double)), motion_, SLOT(moveRelative(double, double, double, double)));
   disconnect(motion_, SIGNAL(motion_finished()), this, SLOT(PickupMaPSA_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "PickupMaPSA_finish"
      << ": emitting signal \"PickupMaPSA_finished\"";
@@ -835,11 +911,13 @@ void AssemblyAssemblyV2::PickupMaPSA_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::PickupPSS_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "PickupPSS_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -864,7 +942,7 @@ void AssemblyAssemblyV2::PickupPSS_start()
   connect(this, SIGNAL(move_relative_request(double, double, double, double)), motion_, SLOT(moveRelative(double, double, double, double)));
   connect(motion_, SIGNAL(motion_finished()), this, SLOT(PickupPSS_finish()));
 
-  in_action_ = true;
+  motion_in_action_ = true;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "PickupPSS_start"
      << ": emitting signal \"move_relative_request(" << dx0 << ", " << dy0 << ", " << dz0 << ", " << da0 << ")\"";
@@ -877,7 +955,7 @@ void AssemblyAssemblyV2::PickupPSS_finish()
   disconnect(this, SIGNAL(move_relative_request(double, double, double, double)), motion_, SLOT(moveRelative(double, double, double, double)));
   disconnect(motion_, SIGNAL(motion_finished()), this, SLOT(PickupPSS_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "PickupPSS_finish"
      << ": emitting signal \"PickupPSS_finished\"";
@@ -896,11 +974,13 @@ void AssemblyAssemblyV2::PickupPSS_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::GoToXYAPositionToGlueMaPSAToBaseplate_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "GoToXYAPositionToGlueMaPSAToBaseplate_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -942,7 +1022,7 @@ void AssemblyAssemblyV2::GoToXYAPositionToGlueMaPSAToBaseplate_start()
   connect(this, SIGNAL(move_relative_request(double, double, double, double)), motion_, SLOT(moveRelative(double, double, double, double)));
   connect(motion_, SIGNAL(motion_finished()), this, SLOT(GoToXYAPositionToGlueMaPSAToBaseplate_finish()));
 
-  in_action_ = true;
+  motion_in_action_ = true;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "GoToXYAPositionToGlueMaPSAToBaseplate_start"
      << ": emitting signal \"move_relative_request(" << dx0 << ", " << dy0 << ", " << dz0 << ", " << da0 << ")\"";
@@ -955,7 +1035,7 @@ void AssemblyAssemblyV2::GoToXYAPositionToGlueMaPSAToBaseplate_finish()
   disconnect(this, SIGNAL(move_relative_request(double, double, double, double)), motion_, SLOT(moveRelative(double, double, double, double)));
   disconnect(motion_, SIGNAL(motion_finished()), this, SLOT(GoToXYAPositionToGlueMaPSAToBaseplate_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "GoToXYAPositionToGlueMaPSAToBaseplate_finish"
      << ": emitting signal \"GoToXYAPositionToGlueMaPSAToBaseplate_finished\"";
@@ -974,11 +1054,13 @@ void AssemblyAssemblyV2::GoToXYAPositionToGlueMaPSAToBaseplate_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::LowerMaPSAOntoBaseplate_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "LowerMaPSAOntoBaseplate_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -1035,7 +1117,7 @@ void AssemblyAssemblyV2::LowerMaPSAOntoBaseplate_start()
     connect(this, SIGNAL(move_relative_request(double, double, double, double)), smart_motion_, SLOT(move_relative(double, double, double, double)));
     connect(smart_motion_, SIGNAL(motion_completed()), this, SLOT(LowerMaPSAOntoBaseplate_finish()));
 
-    in_action_ = true;
+    motion_in_action_ = true;
 
     NQLog("AssemblyAssemblyV2", NQLog::Spam) << "LowerMaPSAOntoBaseplate_start"
        << ": emitting signal \"move_relative_request(" << dx0 << ", " << dy0 << ", " << dz0 << ", " << da0 << ")\"";
@@ -1065,7 +1147,7 @@ void AssemblyAssemblyV2::LowerMaPSAOntoBaseplate_finish()
   disconnect(this, SIGNAL(move_relative_request(double, double, double, double)), smart_motion_, SLOT(move_relative(double, double, double, double)));
   disconnect(smart_motion_, SIGNAL(motion_completed()), this, SLOT(LowerMaPSAOntoBaseplate_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "LowerMaPSAOntoBaseplate_finish"
      << ": emitting signal \"LowerMaPSAOntoBaseplate_finished\"";
@@ -1084,11 +1166,13 @@ void AssemblyAssemblyV2::LowerMaPSAOntoBaseplate_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::GoToXYAPositionToGluePSSToSpacers_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "GoToXYAPositionToGluePSSToSpacers_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -1130,7 +1214,7 @@ void AssemblyAssemblyV2::GoToXYAPositionToGluePSSToSpacers_start()
   connect(this, SIGNAL(move_relative_request(double, double, double, double)), motion_, SLOT(moveRelative(double, double, double, double)));
   connect(motion_, SIGNAL(motion_finished()), this, SLOT(GoToXYAPositionToGluePSSToSpacers_finish()));
 
-  in_action_ = true;
+  motion_in_action_ = true;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "GoToXYAPositionToGluePSSToSpacers_start"
      << ": emitting signal \"move_relative_request(" << dx0 << ", " << dy0 << ", " << dz0 << ", " << da0 << ")\"";
@@ -1143,7 +1227,7 @@ void AssemblyAssemblyV2::GoToXYAPositionToGluePSSToSpacers_finish()
   disconnect(this, SIGNAL(move_relative_request(double, double, double, double)), motion_, SLOT(moveRelative(double, double, double, double)));
   disconnect(motion_, SIGNAL(motion_finished()), this, SLOT(GoToXYAPositionToGluePSSToSpacers_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "GoToXYAPositionToGluePSSToSpacers_finish"
      << ": emitting signal \"GoToXYAPositionToGluePSSToSpacers_finished\"";
@@ -1162,11 +1246,13 @@ void AssemblyAssemblyV2::GoToXYAPositionToGluePSSToSpacers_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::LowerPSSOntoSpacers_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "LowerPSSOntoSpacers_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -1223,7 +1309,7 @@ void AssemblyAssemblyV2::LowerPSSOntoSpacers_start()
     connect(this, SIGNAL(move_relative_request(double, double, double, double)), smart_motion_, SLOT(move_relative(double, double, double, double)));
     connect(smart_motion_, SIGNAL(motion_completed()), this, SLOT(LowerPSSOntoSpacers_finish()));
 
-    in_action_ = true;
+    motion_in_action_ = true;
 
     NQLog("AssemblyAssemblyV2", NQLog::Spam) << "LowerPSSOntoSpacers_start"
        << ": emitting signal \"move_relative_request(" << dx0 << ", " << dy0 << ", " << dz0 << ", " << da0 << ")\"";
@@ -1253,7 +1339,7 @@ void AssemblyAssemblyV2::LowerPSSOntoSpacers_finish()
   disconnect(this, SIGNAL(move_relative_request(double, double, double, double)), smart_motion_, SLOT(move_relative(double, double, double, double)));
   disconnect(smart_motion_, SIGNAL(motion_completed()), this, SLOT(LowerPSSOntoSpacers_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "LowerPSSOntoSpacers_finish"
      << ": emitting signal \"LowerPSSOntoSpacers_finished\"";
@@ -1272,11 +1358,13 @@ void AssemblyAssemblyV2::LowerPSSOntoSpacers_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::GoToPSPMarkerIdealPosition_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "GoToPSPMarkerIdealPosition_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -1318,7 +1406,7 @@ void AssemblyAssemblyV2::GoToPSPMarkerIdealPosition_start()
   connect(this, SIGNAL(move_absolute_request(double, double, double, double)), motion_, SLOT(moveAbsolute(double, double, double, double)));
   connect(motion_, SIGNAL(motion_finished()), this, SLOT(GoToPSPMarkerIdealPosition_finish()));
 
-  in_action_ = true;
+  motion_in_action_ = true;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "GoToPSPMarkerIdealPosition_start"
      << ": emitting signal \"move_absolute_request(" << x0 << ", " << y0 << ", " << z0 << ", " << a0 << ")\"";
@@ -1331,7 +1419,7 @@ void AssemblyAssemblyV2::GoToPSPMarkerIdealPosition_finish()
   disconnect(this, SIGNAL(move_absolute_request(double, double, double, double)), motion_, SLOT(moveAbsolute(double, double, double, double)));
   disconnect(motion_, SIGNAL(motion_finished()), this, SLOT(GoToPSPMarkerIdealPosition_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "GoToPSPMarkerIdealPosition_finish"
      << ": emitting signal \"GoToPSPMarkerIdealPosition_finished\"";
@@ -1348,11 +1436,13 @@ void AssemblyAssemblyV2::GoToPSPMarkerIdealPosition_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::ApplyPSPToPSSXYOffset_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "ApplyPSPToPSSXYOffset_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -1379,7 +1469,7 @@ void AssemblyAssemblyV2::ApplyPSPToPSSXYOffset_start()
   connect(this, SIGNAL(move_relative_request(double, double, double, double)), motion_, SLOT(moveRelative(double, double, double, double)));
   connect(motion_, SIGNAL(motion_finished()), this, SLOT(ApplyPSPToPSSXYOffset_finish()));
 
-  in_action_ = true;
+  motion_in_action_ = true;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "ApplyPSPToPSSXYOffset_start"
      << ": emitting signal \"move_relative_request(" << dx0 << ", " << dy0 << ", " << dz0 << ", " << da0 << ")\"";
@@ -1392,7 +1482,7 @@ void AssemblyAssemblyV2::ApplyPSPToPSSXYOffset_finish()
   disconnect(this, SIGNAL(move_relative_request(double, double, double, double)), motion_, SLOT(moveRelative(double, double, double, double)));
   disconnect(motion_, SIGNAL(motion_finished()), this, SLOT(ApplyPSPToPSSXYOffset_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "ApplyPSPToPSSXYOffset_finish"
      << ": emitting signal \"ApplyPSPToPSSXYOffset_finished\"";
@@ -1411,11 +1501,13 @@ void AssemblyAssemblyV2::ApplyPSPToPSSXYOffset_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::RegisterPSSPlusSpacersToMaPSAPosition_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "RegisterPSSPlusSpacersToMaPSAPosition_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -1432,7 +1524,7 @@ void AssemblyAssemblyV2::RegisterPSSPlusSpacersToMaPSAPosition_start()
 
   connect(this, SIGNAL(PSSPlusSpacersToMaPSAPosition_registered()), this, SLOT(RegisterPSSPlusSpacersToMaPSAPosition_finish()));
 
-  in_action_ = true;
+  motion_in_action_ = true;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "RegisterPSSPlusSpacersToMaPSAPosition_start"
      << ": emitting signal \"PSSPlusSpacersToMaPSAPosition_registered\"";
@@ -1444,7 +1536,7 @@ void AssemblyAssemblyV2::RegisterPSSPlusSpacersToMaPSAPosition_finish()
 {
   disconnect(this, SIGNAL(PSSPlusSpacersToMaPSAPosition_registered()), this, SLOT(RegisterPSSPlusSpacersToMaPSAPosition_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "RegisterPSSPlusSpacersToMaPSAPosition_finish"
      << ": emitting signal \"RegisterPSSPlusSpacersToMaPSAPosition_finished\"";
@@ -1463,11 +1555,13 @@ void AssemblyAssemblyV2::RegisterPSSPlusSpacersToMaPSAPosition_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::GoFromPSSPlusSpacersToMaPSAPositionToGluingStageRefPointXY_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "GoFromPSSPlusSpacersToMaPSAPositionToGluingStageRefPointXY_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -1496,7 +1590,7 @@ void AssemblyAssemblyV2::GoFromPSSPlusSpacersToMaPSAPositionToGluingStageRefPoin
     connect(this, SIGNAL(move_relative_request(double, double, double, double)), smart_motion_, SLOT(move_relative(double, double, double, double)));
     connect(smart_motion_, SIGNAL(motion_completed()), this, SLOT(GoFromPSSPlusSpacersToMaPSAPositionToGluingStageRefPointXY_finish()));
 
-    in_action_ = true;
+    motion_in_action_ = true;
 
     NQLog("AssemblyAssemblyV2", NQLog::Spam) << "GoFromPSSPlusSpacersToMaPSAPositionToGluingStageRefPointXY_start"
        << ": emitting signal \"move_relative_request(" << dx0 << ", " << dy0 << ", " << dz0 << ", " << da0 << ")\"";
@@ -1526,7 +1620,7 @@ void AssemblyAssemblyV2::GoFromPSSPlusSpacersToMaPSAPositionToGluingStageRefPoin
   disconnect(this, SIGNAL(move_relative_request(double, double, double, double)), smart_motion_, SLOT(move_relative(double, double, double, double)));
   disconnect(smart_motion_, SIGNAL(motion_completed()), this, SLOT(GoFromPSSPlusSpacersToMaPSAPositionToGluingStageRefPointXY_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "GoFromPSSPlusSpacersToMaPSAPositionToGluingStageRefPointXY_finish"
      << ": emitting signal \"GoFromPSSPlusSpacersToMaPSAPositionToGluingStageRefPointXY_finished\"";
@@ -1545,11 +1639,13 @@ void AssemblyAssemblyV2::GoFromPSSPlusSpacersToMaPSAPositionToGluingStageRefPoin
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::LowerPSSPlusSpacersOntoGluingStage_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "LowerPSSPlusSpacersOntoGluingStage_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -1606,7 +1702,7 @@ void AssemblyAssemblyV2::LowerPSSPlusSpacersOntoGluingStage_start()
     connect(this, SIGNAL(move_relative_request(double, double, double, double)), smart_motion_, SLOT(move_relative(double, double, double, double)));
     connect(smart_motion_, SIGNAL(motion_completed()), this, SLOT(LowerPSSPlusSpacersOntoGluingStage_finish()));
 
-    in_action_ = true;
+    motion_in_action_ = true;
 
     NQLog("AssemblyAssemblyV2", NQLog::Spam) << "LowerPSSPlusSpacersOntoGluingStage_start"
        << ": emitting signal \"move_relative_request(" << dx0 << ", " << dy0 << ", " << dz0 << ", " << da0 << ")\"";
@@ -1636,7 +1732,7 @@ void AssemblyAssemblyV2::LowerPSSPlusSpacersOntoGluingStage_finish()
   disconnect(this, SIGNAL(move_relative_request(double, double, double, double)), smart_motion_, SLOT(move_relative(double, double, double, double)));
   disconnect(smart_motion_, SIGNAL(motion_completed()), this, SLOT(LowerPSSPlusSpacersOntoGluingStage_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "LowerPSSPlusSpacersOntoGluingStage_finish"
      << ": emitting signal \"LowerPSSPlusSpacersOntoGluingStage_finished\"";
@@ -1655,11 +1751,13 @@ void AssemblyAssemblyV2::LowerPSSPlusSpacersOntoGluingStage_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::ReturnToPSSPlusSpacersToMaPSAPosition_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "ReturnToPSSPlusSpacersToMaPSAPosition_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -1703,7 +1801,7 @@ void AssemblyAssemblyV2::ReturnToPSSPlusSpacersToMaPSAPosition_start()
     connect(this, SIGNAL(move_relative_request(double, double, double, double)), smart_motion_, SLOT(move_relative(double, double, double, double)));
     connect(smart_motion_, SIGNAL(motion_completed()), this, SLOT(ReturnToPSSPlusSpacersToMaPSAPosition_finish()));
 
-    in_action_ = true;
+    motion_in_action_ = true;
 
     NQLog("AssemblyAssemblyV2", NQLog::Spam) << "ReturnToPSSPlusSpacersToMaPSAPosition_start"
        << ": emitting signal \"move_relative_request(" << dx0 << ", " << dy0 << ", " << dz0 << ", " << da0 << ")\"";
@@ -1733,7 +1831,7 @@ void AssemblyAssemblyV2::ReturnToPSSPlusSpacersToMaPSAPosition_finish()
   disconnect(this, SIGNAL(move_relative_request(double, double, double, double)), smart_motion_, SLOT(move_relative(double, double, double, double)));
   disconnect(smart_motion_, SIGNAL(motion_completed()), this, SLOT(ReturnToPSSPlusSpacersToMaPSAPosition_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "ReturnToPSSPlusSpacersToMaPSAPosition_finish"
      << ": emitting signal \"ReturnToPSSPlusSpacersToMaPSAPosition_finished\"";
@@ -1752,11 +1850,13 @@ void AssemblyAssemblyV2::ReturnToPSSPlusSpacersToMaPSAPosition_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::LowerPSSPlusSpacersOntoMaPSA_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "LowerPSSPlusSpacersOntoMaPSA_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -1812,7 +1912,7 @@ void AssemblyAssemblyV2::LowerPSSPlusSpacersOntoMaPSA_start()
     connect(this, SIGNAL(move_relative_request(double, double, double, double)), smart_motion_, SLOT(move_relative(double, double, double, double)));
     connect(smart_motion_, SIGNAL(motion_completed()), this, SLOT(LowerPSSPlusSpacersOntoMaPSA_finish()));
 
-    in_action_ = true;
+    motion_in_action_ = true;
 
     NQLog("AssemblyAssemblyV2", NQLog::Spam) << "LowerPSSPlusSpacersOntoMaPSA_start"
        << ": emitting signal \"move_relative_request(" << dx0 << ", " << dy0 << ", " << dz0 << ", " << da0 << ")\"";
@@ -1842,7 +1942,7 @@ void AssemblyAssemblyV2::LowerPSSPlusSpacersOntoMaPSA_finish()
   disconnect(this, SIGNAL(move_relative_request(double, double, double, double)), smart_motion_, SLOT(move_relative(double, double, double, double)));
   disconnect(smart_motion_, SIGNAL(motion_completed()), this, SLOT(LowerPSSPlusSpacersOntoMaPSA_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "LowerPSSPlusSpacersOntoMaPSA_finish"
      << ": emitting signal \"LowerPSSPlusSpacersOntoMaPSA_finished\"";
@@ -1861,11 +1961,13 @@ void AssemblyAssemblyV2::LowerPSSPlusSpacersOntoMaPSA_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::PickupPSSPlusSpacers_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "PickupPSSPlusSpacers_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -1890,7 +1992,7 @@ void AssemblyAssemblyV2::PickupPSSPlusSpacers_start()
   connect(this, SIGNAL(move_relative_request(double, double, double, double)), motion_, SLOT(moveRelative(double, double, double, double)));
   connect(motion_, SIGNAL(motion_finished()), this, SLOT(PickupPSSPlusSpacers_finish()));
 
-  in_action_ = true;
+  motion_in_action_ = true;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "PickupPSSPlusSpacers_start"
      << ": emitting signal \"move_relative_request(" << dx0 << ", " << dy0 << ", " << dz0 << ", " << da0 << ")\"";
@@ -1903,7 +2005,7 @@ void AssemblyAssemblyV2::PickupPSSPlusSpacers_finish()
   disconnect(this, SIGNAL(move_relative_request(double, double, double, double)), motion_, SLOT(moveRelative(double, double, double, double)));
   disconnect(motion_, SIGNAL(motion_finished()), this, SLOT(PickupPSSPlusSpacers_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "PickupPSSPlusSpacers_finish"
      << ": emitting signal \"PickupPSSPlusSpacers_finished\"";
@@ -1922,11 +2024,13 @@ void AssemblyAssemblyV2::PickupPSSPlusSpacers_finish()
 // ----------------------------------------------------------------------------------------------------
 void AssemblyAssemblyV2::LiftUpPickupTool_start()
 {
-  if(in_action_){
+  if(this->motion_locked()){
 
     NQLog("AssemblyAssemblyV2", NQLog::Warning) << "LiftUpPickupTool_start"
        << ": logic error, an assembly step is still in progress, will not take further action";
 
+    this->reject_scheduled_start();
+
     return;
   }
 
@@ -1951,7 +2055,7 @@ void AssemblyAssemblyV2::LiftUpPickupTool_start()
   connect(this, SIGNAL(move_relative_request(double, double, double, double)), motion_, SLOT(moveRelative(double, double, double, double)));
   connect(motion_, SIGNAL(motion_finished()), this, SLOT(LiftUpPickupTool_finish()));
 
-  in_action_ = true;
+  motion_in_action_ = true;
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "LiftUpPickupTool_start"
      << ": emitting signal \"move_relative_request(" << dx0 << ", " << dy0 << ", " << dz0 << ", " << da0 << ")\"";
@@ -1964,7 +2068,7 @@ void AssemblyAssemblyV2::LiftUpPickupTool_finish()
   disconnect(this, SIGNAL(move_relative_request(double, double, double, double)), motion_, SLOT(moveRelative(double, double, double, double)));
   disconnect(motion_, SIGNAL(motion_finished()), this, SLOT(LiftUpPickupTool_finish()));
 
-  if(in_action_){ in_action_ = false; }
+  if(motion_in_action_){ motion_in_action_ = false; }
 
   NQLog("AssemblyAssemblyV2", NQLog::Spam) << "LiftUpPickupTool_finish"
      << ": emitting signal \"LiftUpPickupTool_finished\"";
@@ -1977,3 +2081,105 @@ void AssemblyAssemblyV2::LiftUpPickupTool_finish()
   emit DBLogMessage("== Assembly step completed : [Lift up pickup tool]");
 }
 // ----------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------------------------------
+// PrepareGlueMaPSAToBaseplate ------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------
+void AssemblyAssemblyV2::PrepareGlueMaPSAToBaseplate_start()
+{
+  if(this->motion_locked() || this->vacuum_locked(vacuum_basepl_) || scheduler_->is_running()){
+
+    NQLog("AssemblyAssemblyV2", NQLog::Warning) << "PrepareGlueMaPSAToBaseplate_start"
+       << ": logic error, an assembly step is still in progress, will not take further action";
+
+    return;
+  }
+
+  // the baseplate vacuum is switched on while the motion stage travels
+  scheduler_->clear();
+  scheduler_->add_step("Enable Vacuum on Baseplate", this,
+                       SLOT(EnableVacuumBaseplate_start()), SIGNAL(EnableVacuumBaseplate_finished()),
+                       this->vacuum_resources(vacuum_basepl_));
+  scheduler_->add_step("Go To XYA Position To Glue MaPSA To Baseplate", this,
+                       SLOT(GoToXYAPositionToGlueMaPSAToBaseplate_start()), SIGNAL(GoToXYAPositionToGlueMaPSAToBaseplate_finished()),
+                       Resource_Motion);
+
+  connect(scheduler_, SIGNAL(finished()), this, SLOT(PrepareGlueMaPSAToBaseplate_finish()));
+
+  scheduler_->start();
+}
+
+void AssemblyAssemblyV2::PrepareGlueMaPSAToBaseplate_finish()
+{
+  disconnect(scheduler_, SIGNAL(finished()), this, SLOT(PrepareGlueMaPSAToBaseplate_finish()));
+
+  NQLog("AssemblyAssemblyV2", NQLog::Spam) << "PrepareGlueMaPSAToBaseplate_finish"
+     << ": emitting signal \"PrepareGlueMaPSAToBaseplate_finished\"";
+
+  emit PrepareGlueMaPSAToBaseplate_finished();
+
+  if(scheduler_->was_aborted())
+  {
+    NQLog("AssemblyAssemblyV2", NQLog::Warning) << "PrepareGlueMaPSAToBaseplate_finish"
+       << ": assembly-step aborted, check the state of the motion stage and the vacuum lines";
+
+    return;
+  }
+
+  NQLog("AssemblyAssemblyV2", NQLog::Message) << "PrepareGlueMaPSAToBaseplate_finish"
+     << ": assembly-step completed";
+
+  emit DBLogMessage("== Assembly step completed : [Enable baseplate vacuum + Go to XYA position to glue MaPSA to baseplate]");
+}
+// ----------------------------------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------------------------------
+// PrepareGluePSSToSpacers ----------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------
+void AssemblyAssemblyV2::PrepareGluePSSToSpacers_start()
+{
+  if(this->motion_locked() || this->vacuum_locked(vacuum_spacer_) || scheduler_->is_running()){
+
+    NQLog("AssemblyAssemblyV2", NQLog::Warning) << "PrepareGluePSSToSpacers_start"
+       << ": logic error, an assembly step is still in progress, will not take further action";
+
+    return;
+  }
+
+  // the spacers vacuum is switched on while the motion stage travels
+  scheduler_->clear();
+  scheduler_->add_step("Go To XYA Position To Glue PS-s to Spacers", this,
+                       SLOT(GoToXYAPositionToGluePSSToSpacers_start()), SIGNAL(GoToXYAPositionToGluePSSToSpacers_finished()),
+                       Resource_Motion);
+  scheduler_->add_step("Enable Vacuum on Spacers", this,
+                       SLOT(EnableVacuumSpacers_start()), SIGNAL(EnableVacuumSpacers_finished()),
+                       this->vacuum_resources(vacuum_spacer_));
+
+  connect(scheduler_, SIGNAL(finished()), this, SLOT(PrepareGluePSSToSpacers_finish()));
+
+  scheduler_->start();
+}
+
+void AssemblyAssemblyV2::PrepareGluePSSToSpacers_finish()
+{
+  disconnect(scheduler_, SIGNAL(finished()), this, SLOT(PrepareGluePSSToSpacers_finish()));
+
+  NQLog("AssemblyAssemblyV2", NQLog::Spam) << "PrepareGluePSSToSpacers_finish"
+     << ": emitting signal \"PrepareGluePSSToSpacers_finished\"";
+
+  emit PrepareGluePSSToSpacers_finished();
+
+  if(scheduler_->was_aborted())
+  {
+    NQLog("AssemblyAssemblyV2", NQLog::Warning) << "PrepareGluePSSToSpacers_finish"
+       << ": assembly-step aborted, check the state of the motion stage and the vacuum lines";
+
+    return;
+  }
+
+  NQLog("AssemblyAssemblyV2", NQLog::Message) << "PrepareGluePSSToSpacers_finish"
+     << ": assembly-step completed";
+
+  emit DBLogMessage("== Assembly step completed : [Go to XYA position to glue PS-s to spacers + Enable spacers vacuum]");
+}
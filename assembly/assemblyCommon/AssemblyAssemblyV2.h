@@ -20,6 +20,7 @@
 
 #include <AssemblySmartMotionManager.h>
 #include <AssemblyParameters.h>
+#include <AssemblyStepScheduler.h>
 
 class AssemblyAssemblyV2 : public QObject
 {
@@ -36,6 +37,16 @@ class AssemblyAssemblyV2 : public QObject
 
   const AssemblySmartMotionManager* smart_motion() const;
 
+  AssemblyStepScheduler* scheduler() const { return scheduler_; }
+
+  // device resources of the assembly steps, for AssemblyStepScheduler
+  enum Resource {
+    Resource_Motion = 0x1,
+    Resource_Vacuum = 0x2
+  };
+
+  unsigned int vacuum_resources(const int line) const;
+
  protected:
   const LStepExpressMotionManager* const motion_;
   const ConradManager* const vacuum_;
@@ -50,7 +61,18 @@ class AssemblyAssemblyV2 : public QObject
   double pickup2_Z_;
 
   bool use_smartMove_;
-  bool in_action_;
+
+  // safety interlocks: one step at a time (motion, or vacuum switch with line index, -1 if none);
+  // only steps started by scheduler_ may overlap a motion with a vacuum switch other than the pickup tool's
+  bool motion_in_action_;
+  int vacuum_in_action_;
+
+  bool motion_locked() const;
+  bool vacuum_locked(const int line) const;
+
+  void reject_scheduled_start();
+
+  AssemblyStepScheduler* scheduler_;
 
   bool PSSPlusSpacersToMaPSAPosition_isRegistered_;
   double PSSPlusSpacersToMaPSAPosition_X_;
@@ -64,6 +86,8 @@ class AssemblyAssemblyV2 : public QObject
 
   void use_smartMove(const int);
 
+  void abort_scheduled_steps();
+
   // motion
   void GoToSensorMarkerPreAlignment_start();
   void GoToSensorMarkerPreAlignment_finish();
@@ -123,6 +147,14 @@ class AssemblyAssemblyV2 : public QObject
   void LiftUpPickupTool_finish();
   // ---------
 
+  // scheduled (concurrent) steps
+  void PrepareGlueMaPSAToBaseplate_start();
+  void PrepareGlueMaPSAToBaseplate_finish();
+
+  void PrepareGluePSSToSpacers_start();
+  void PrepareGluePSSToSpacers_finish();
+  // ---------
+
   // vacuum
   void EnableVacuumPickupTool_start();
   void EnableVacuumPickupTool_finish();
@@ -181,6 +213,11 @@ class AssemblyAssemblyV2 : public QObject
 
   // ------
 
+  // scheduled (concurrent) steps
+  void PrepareGlueMaPSAToBaseplate_finished();
+  void PrepareGluePSSToSpacers_finished();
+  // ------
+
   // vacuum
   void vacuum_ON_request(const int);
   void vacuum_OFF_request(const int);
@@ -14,6 +14,7 @@
 #include <QHBoxLayout>
 #include <QToolBox>
 #include <QLabel>
+#include <QPushButton>
 
 #include <nqlogger.h>
 
@@ -50,6 +51,12 @@ AssemblyAssemblyV2View::AssemblyAssemblyV2View(const QObject* const assembly, QW
   connect(smartMove_checkbox_, SIGNAL(stateChanged(int)), assembly, SLOT(use_smartMove(int)));
 
   smartMove_checkbox_->setChecked(true);
+
+  QPushButton* abort_button = new QPushButton(tr("Abort Concurrent Steps"));
+
+  opts_lay->addWidget(abort_button);
+
+  connect(abort_button, SIGNAL(clicked()), assembly, SLOT(abort_scheduled_steps()));
   //// -----------------------------------------------
 
   QToolBox* toolbox = new QToolBox;
@@ -189,6 +196,17 @@ AssemblyAssemblyV2View::AssemblyAssemblyV2View(const QObject* const assembly, QW
   }
   // ----------
 
+  // shortcut: Enable Vacuum on Baseplate + Go To XYA Position To Glue MaPSA To Baseplate (concurrent, same as the next two steps)
+  {
+    AssemblyAssemblyActionWidget* tmp_wid = new AssemblyAssemblyActionWidget;
+    tmp_wid->label()->setText(QString::number(assembly_step_N+1)+"+"+QString::number(assembly_step_N+2));
+    tmp_wid->button()->setText("Enable Vacuum on Baseplate + Go To XYA Position To Glue MaPSA To Baseplate");
+    PSPToBasep_lay->addWidget(tmp_wid);
+
+    tmp_wid->connect_action(assembly, SLOT(PrepareGlueMaPSAToBaseplate_start()), SIGNAL(PrepareGlueMaPSAToBaseplate_finished()));
+  }
+  // ----------
+
   // step: Enable Vacuum on Baseplate
   {
     ++assembly_step_N;
@@ -436,6 +454,17 @@ AssemblyAssemblyV2View::AssemblyAssemblyV2View(const QObject* const assembly, QW
   }
   // ----------
 
+  // shortcut: Go To XYA Position To Glue PS-s to Spacers + Enable Vacuum on Spacers (concurrent, same as the next two steps)
+  {
+    AssemblyAssemblyActionWidget* tmp_wid = new AssemblyAssemblyActionWidget;
+    tmp_wid->label()->setText(QString::number(assembly_step_N+1)+"+"+QString::number(assembly_step_N+2));
+    tmp_wid->button()->setText("Go To XYA Position To Glue PS-s to Spacers + Enable Vacuum on Spacers");
+    PSSToSpacers_lay->addWidget(tmp_wid);
+
+    tmp_wid->connect_action(assembly, SLOT(PrepareGluePSSToSpacers_start()), SIGNAL(PrepareGluePSSToSpacers_finished()));
+  }
+  // ----------
+
   // step: Go To XYA Position To Glue PS-s to Spacers
   {
     ++assembly_step_N;
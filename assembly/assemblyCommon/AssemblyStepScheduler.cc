@@ -0,0 +1,334 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#include <nqlogger.h>
+
+#include <AssemblyStepScheduler.h>
+
+#include <QMetaObject>
+
+AssemblyStepScheduler::AssemblyStepScheduler(QObject* parent)
+ : QObject(parent)
+
+ , resources_in_use_(0)
+ , running_(false)
+ , aborted_(false)
+ , starting_step_(-1)
+ , rejected_(false)
+ , generation_(0)
+ , step_timeout_(0.)
+ , timeout_timer_(nullptr)
+{
+  timeout_timer_ = new QTimer(this);
+  timeout_timer_->setInterval(1000);
+
+  connect(timeout_timer_, SIGNAL(timeout()), this, SLOT(check_timeouts()));
+}
+
+int AssemblyStepScheduler::add_step(const QString& name, const QObject* qobject, const char* start_slot, const char* stop_signal,
+                                    const unsigned int resources, const std::vector<int>& dependencies)
+{
+  if(running_)
+  {
+    NQLog("AssemblyStepScheduler", NQLog::Critical) << "add_step(" << name << ")"
+       << ": schedule is running, step not added";
+
+    return -1;
+  }
+
+  if((qobject == nullptr) || (start_slot == nullptr) || (stop_signal == nullptr))
+  {
+    NQLog("AssemblyStepScheduler", NQLog::Critical) << "add_step(" << name << ")"
+       << ": invalid (NULL) pointer to QObject, start slot or stop signal, step not added";
+
+    return -1;
+  }
+
+  const int index = steps_.size();
+
+  // dependencies on earlier steps only: the graph can not contain cycles
+  for(const auto dep : dependencies)
+  {
+    if((dep < 0) || (dep >= index))
+    {
+      NQLog("AssemblyStepScheduler", NQLog::Critical) << "add_step(" << name << ")"
+         << ": invalid dependency (" << dep << "), step not added";
+
+      return -1;
+    }
+  }
+
+  Step_t step;
+  step.name = name;
+  step.qobject = qobject;
+  step.start_slot = start_slot;
+  step.stop_signal = stop_signal;
+  step.resources = resources;
+  step.dependencies = dependencies;
+  step.state = Pending;
+  step.start_time = 0.;
+  step.stop_time = 0.;
+
+  steps_.emplace_back(step);
+
+  AssemblyStepSchedulerRelay* relay = new AssemblyStepSchedulerRelay(index, this);
+
+  connect(relay, SIGNAL(start_request()), qobject, start_slot);
+  connect(relay, SIGNAL(finished(int)), this, SLOT(finish_step(int)));
+
+  relays_.emplace_back(relay);
+
+  return index;
+}
+
+void AssemblyStepScheduler::clear()
+{
+  if(running_)
+  {
+    NQLog("AssemblyStepScheduler", NQLog::Warning) << "clear"
+       << ": schedule is running, no action taken";
+
+    return;
+  }
+
+  for(auto* relay : relays_){ delete relay; }
+
+  relays_.clear();
+  steps_.clear();
+}
+
+void AssemblyStepScheduler::start()
+{
+  if(running_)
+  {
+    NQLog("AssemblyStepScheduler", NQLog::Warning) << "start"
+       << ": schedule is already running, no action taken";
+
+    return;
+  }
+
+  for(auto& step : steps_)
+  {
+    step.state = Pending;
+    step.start_time = 0.;
+    step.stop_time = 0.;
+  }
+
+  resources_in_use_ = 0;
+  running_ = true;
+  aborted_ = false;
+  ++generation_;
+
+  clock_.start();
+
+  if(step_timeout_ > 0.){ timeout_timer_->start(); }
+
+  NQLog("AssemblyStepScheduler", NQLog::Message) << "start"
+     << ": executing schedule of " << steps_.size() << " steps";
+
+  this->dispatch();
+}
+
+void AssemblyStepScheduler::abort()
+{
+  if(running_ == false){ return; }
+
+  NQLog("AssemblyStepScheduler", NQLog::Warning) << "abort"
+     << ": schedule aborted, no further steps will be started and running steps are no longer waited for";
+
+  aborted_ = true;
+
+  this->fail_running_steps();
+  this->complete();
+}
+
+void AssemblyStepScheduler::reject_step()
+{
+  if(starting_step_ < 0){ return; }
+
+  rejected_ = true;
+}
+
+void AssemblyStepScheduler::fail_running_steps()
+{
+  for(std::size_t i=0; i<steps_.size(); ++i)
+  {
+    Step_t& step = steps_[i];
+
+    if(step.state != Running){ continue; }
+
+    disconnect(step.qobject, step.stop_signal, relays_[i], SLOT(relay()));
+
+    step.state = Failed;
+    step.stop_time = clock_.elapsed() / 1000.;
+
+    resources_in_use_ &= ~step.resources;
+  }
+}
+
+void AssemblyStepScheduler::dispatch()
+{
+  bool any_running(false);
+  bool any_pending(false);
+
+  if(aborted_ == false)
+  {
+    for(std::size_t i=0; i<steps_.size(); ++i)
+    {
+      Step_t& step = steps_[i];
+
+      if(step.state != Pending){ continue; }
+
+      bool ready = ((step.resources & resources_in_use_) == 0);
+
+      for(const auto dep : step.dependencies)
+      {
+        if(steps_[dep].state != Done){ ready = false; break; }
+      }
+
+      if(ready == false){ continue; }
+
+      step.state = Running;
+      step.start_time = clock_.elapsed() / 1000.;
+
+      resources_in_use_ |= step.resources;
+
+      connect(step.qobject, step.stop_signal, relays_[i], SLOT(relay()));
+
+      NQLog("AssemblyStepScheduler", NQLog::Spam) << "dispatch"
+         << ": emitting signal \"step_started(" << step.name << ")\"";
+
+      emit step_started(step.name);
+
+      // queued, so that steps completing immediately do not re-enter dispatch()
+      QMetaObject::invokeMethod(this, "start_step", Qt::QueuedConnection, Q_ARG(int, int(i)), Q_ARG(int, generation_));
+    }
+  }
+
+  for(const auto& step : steps_)
+  {
+    if(step.state == Running){ any_running = true; }
+    if(step.state == Pending){ any_pending = true; }
+  }
+
+  if(any_running == false)
+  {
+    if(any_pending && (aborted_ == false))
+    {
+      NQLog("AssemblyStepScheduler", NQLog::Critical) << "dispatch"
+         << ": no step can be started, schedule stopped";
+    }
+
+    this->complete();
+  }
+}
+
+void AssemblyStepScheduler::start_step(const int index, const int generation)
+{
+  // the schedule may have been aborted or restarted since the start was queued
+  if((running_ == false) || (generation != generation_)){ return; }
+  if((index < 0) || (index >= int(steps_.size())) || (steps_[index].state != Running)){ return; }
+
+  starting_step_ = index;
+  rejected_ = false;
+
+  // direct connection: the start slot runs before request() returns
+  relays_[index]->request();
+
+  starting_step_ = -1;
+
+  if(rejected_)
+  {
+    NQLog("AssemblyStepScheduler", NQLog::Critical) << "start_step"
+       << ": step " << steps_[index].name << " refused to start";
+
+    this->abort();
+  }
+}
+
+void AssemblyStepScheduler::check_timeouts()
+{
+  if((running_ == false) || (step_timeout_ <= 0.)){ return; }
+
+  const double now = clock_.elapsed() / 1000.;
+
+  for(const auto& step : steps_)
+  {
+    if((step.state == Running) && ((now - step.start_time) > step_timeout_))
+    {
+      NQLog("AssemblyStepScheduler", NQLog::Critical) << "check_timeouts"
+         << ": step " << step.name << " did not finish within " << step_timeout_ << " s";
+
+      this->abort();
+
+      return;
+    }
+  }
+}
+
+void AssemblyStepScheduler::finish_step(const int index)
+{
+  if((index < 0) || (index >= int(steps_.size())) || (steps_[index].state != Running))
+  {
+    NQLog("AssemblyStepScheduler", NQLog::Warning) << "finish_step(" << index << ")"
+       << ": step is not running, no action taken";
+
+    return;
+  }
+
+  Step_t& step = steps_[index];
+
+  disconnect(step.qobject, step.stop_signal, relays_[index], SLOT(relay()));
+
+  step.state = Done;
+  step.stop_time = clock_.elapsed() / 1000.;
+
+  resources_in_use_ &= ~step.resources;
+
+  NQLog("AssemblyStepScheduler", NQLog::Spam) << "finish_step"
+     << ": emitting signal \"step_finished(" << step.name << ", " << step.start_time << ", " << (step.stop_time - step.start_time) << ")\"";
+
+  emit step_finished(step.name, step.start_time, step.stop_time - step.start_time);
+
+  this->dispatch();
+}
+
+void AssemblyStepScheduler::complete()
+{
+  running_ = false;
+
+  timeout_timer_->stop();
+
+  // timeline of the schedule, with the time the steps would have taken one after another
+  double serial_time(0.);
+
+  for(const auto& step : steps_)
+  {
+    if(step.state != Done){ continue; }
+
+    serial_time += (step.stop_time - step.start_time);
+
+    NQLog("AssemblyStepScheduler", NQLog::Message) << "complete"
+       << ": step " << step.name << " started at " << step.start_time
+       << " s, duration " << (step.stop_time - step.start_time) << " s";
+  }
+
+  NQLog("AssemblyStepScheduler", NQLog::Message) << "complete"
+     << ": schedule " << (aborted_ ? "aborted" : "completed") << " after " << (clock_.elapsed() / 1000.)
+     << " s (sum of step durations " << serial_time << " s)";
+
+  NQLog("AssemblyStepScheduler", NQLog::Spam) << "complete"
+     << ": emitting signal \"finished\"";
+
+  emit finished();
+}
@@ -0,0 +1,147 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ASSEMBLYSTEPSCHEDULER_H
+#define ASSEMBLYSTEPSCHEDULER_H
+
+#include <vector>
+
+#include <QObject>
+#include <QString>
+#include <QElapsedTimer>
+#include <QTimer>
+
+/**
+  Relays the start request and the completion signal of a single step
+  of AssemblyStepScheduler, tagging the latter with the step index.
+  */
+class AssemblyStepSchedulerRelay : public QObject
+{
+ Q_OBJECT
+
+ public:
+  explicit AssemblyStepSchedulerRelay(const int index, QObject* parent=nullptr) : QObject(parent), index_(index) {}
+  virtual ~AssemblyStepSchedulerRelay() {}
+
+ protected:
+  const int index_;
+
+ public slots:
+  void request() { emit start_request(); }
+  void relay() { emit finished(index_); }
+
+ signals:
+  void start_request();
+  void finished(const int);
+};
+
+/**
+  Executes a graph of assembly steps. Each step is a start slot and a
+  completion signal of a QObject (the same pair used by
+  AssemblyAssemblyActionWidget::connect_action), a list of steps it depends
+  on and a bitmask of the device resources it uses. A step is started as
+  soon as all of its dependencies are done and none of its resources is
+  held by a running step, so independent steps on different devices
+  (e.g. a vacuum line and the motion stage) run concurrently.
+  The start slot is called synchronously from the scheduler, so that it can
+  tell a scheduled start (is_starting_step()) from a manual one and refuse
+  it with reject_step(). A rejected step, a step running longer than the
+  step timeout or abort() end the whole schedule; finished() is emitted in
+  all cases and was_aborted() tells them apart.
+  */
+class AssemblyStepScheduler : public QObject
+{
+ Q_OBJECT
+
+ public:
+  enum StepState { Pending, Running, Done, Failed };
+
+  typedef struct {
+    QString name;
+    const QObject* qobject;
+    const char* start_slot;
+    const char* stop_signal;
+    unsigned int resources;
+    std::vector<int> dependencies;
+
+    StepState state;
+    double start_time; // [s] since start of the schedule
+    double stop_time;
+  } Step_t;
+
+  explicit AssemblyStepScheduler(QObject* parent=nullptr);
+  virtual ~AssemblyStepScheduler() {}
+
+  /// adds a step; dependencies must refer to steps added before;
+  /// returns the index of the step, or -1 if it was rejected
+  int add_step(const QString& name, const QObject* qobject, const char* start_slot, const char* stop_signal,
+               const unsigned int resources, const std::vector<int>& dependencies=std::vector<int>());
+
+  void clear();
+
+  bool is_running() const { return running_; }
+  bool was_aborted() const { return aborted_; }
+
+  /// true while the start slot of a step is being called by the scheduler
+  bool is_starting_step() const { return (starting_step_ >= 0); }
+
+  /// called by a start slot that refuses to start the step; aborts the schedule
+  void reject_step();
+
+  /// [s] maximum duration of a step, 0 for none
+  void set_step_timeout(const double timeout) { step_timeout_ = timeout; }
+  double step_timeout() const { return step_timeout_; }
+
+  const std::vector<Step_t>& steps() const { return steps_; }
+
+ protected:
+  void dispatch();
+  void complete();
+  void fail_running_steps();
+
+  std::vector<Step_t> steps_;
+  std::vector<AssemblyStepSchedulerRelay*> relays_;
+
+  unsigned int resources_in_use_;
+  bool running_;
+  bool aborted_;
+
+  // index of the step whose start slot is being called, -1 if none
+  int starting_step_;
+  bool rejected_;
+
+  // incremented on start(), invalidates queued starts of an earlier run
+  int generation_;
+
+  double step_timeout_;
+  QTimer* timeout_timer_;
+
+  QElapsedTimer clock_;
+
+ public slots:
+  void start();
+  void abort();
+
+ protected slots:
+  void start_step(const int, const int);
+  void finish_step(const int);
+  void check_timeouts();
+
+ signals:
+  void step_started(const QString&);
+  void step_finished(const QString&, const double, const double);
+
+  void finished();
+};
+
+#endif // ASSEMBLYSTEPSCHEDULER_H
@@ -11,14 +11,31 @@
 /////////////////////////////////////////////////////////////////////////////////
 
 #include <AssemblyUEyeFakeCamera.h>
+#include <LStepExpressModel.h>
 #include <ApplicationConfig.h>
 #include <nqlogger.h>
 
 #include <unistd.h>
 
+#include <thread>
+#include <cmath>
+#include <algorithm>
+
 AssemblyUEyeFakeCamera::AssemblyUEyeFakeCamera(QObject* parent) :
   AssemblyVUEyeCamera(parent),
-  imageIndex_(0)
+  imageIndex_(0),
+  frameRate_(10.),
+  readoutLatency_(30.),
+  latencyJitter_(5.),
+  lastFrameTime_(std::chrono::steady_clock::now()),
+  randomEngine_(std::random_device{}()),
+  motion_model_(nullptr),
+  motionZValid_(false),
+  motionZ_(0.),
+  defocusEnabled_(false),
+  defocusFocalZ_(0.),
+  defocusSigmaPerMM_(20.),
+  defocusSigmaMax_(25.)
 {
     cameraState_ = State::OFF;
 
@@ -50,7 +67,18 @@ AssemblyUEyeFakeCamera::AssemblyUEyeFakeCamera(QObject* parent) :
     filenames.push_back(QString(filename + "/share/assembly/oldSpareSensor_master.png").toStdString());
     imageFilenamesForPixelClock_[4] = filenames;
 
-    imageFilenames_ = imageFilenamesForPixelClock_[24];
+    const ApplicationConfig* config = ApplicationConfig::instance();
+    if(config != nullptr)
+    {
+      frameRate_         = config->getValue<double>("AssemblyUEyeFakeCamera_frameRate"         , frameRate_);
+      readoutLatency_    = config->getValue<double>("AssemblyUEyeFakeCamera_readoutLatency"    , readoutLatency_);
+      latencyJitter_     = config->getValue<double>("AssemblyUEyeFakeCamera_latencyJitter"     , latencyJitter_);
+
+      defocusEnabled_    = config->getValue<bool>  ("AssemblyUEyeFakeCamera_defocus"           , defocusEnabled_);
+      defocusFocalZ_     = config->getValue<double>("AssemblyUEyeFakeCamera_defocusFocalZ"     , defocusFocalZ_);
+      defocusSigmaPerMM_ = config->getValue<double>("AssemblyUEyeFakeCamera_defocusSigmaPerMM" , defocusSigmaPerMM_);
+      defocusSigmaMax_   = config->getValue<double>("AssemblyUEyeFakeCamera_defocusSigmaMax"   , defocusSigmaMax_);
+    }
 }
 
 AssemblyUEyeFakeCamera::~AssemblyUEyeFakeCamera()
@@ -87,11 +115,18 @@ void AssemblyUEyeFakeCamera::open()
 
     currentExposureTime_ = 0;
 
+    // decode the full image set once, acquisitions only copy from memory
+    preloadImages();
+
     updatePixelClock();
     updateExposureTime();
 
+    selectImages(currentPixelClock_);
+
     usleep(500000);
 
+    lastFrameTime_ = std::chrono::steady_clock::now();
+
     cameraState_ = State::READY;
 
     emit cameraOpened();
@@ -190,19 +225,7 @@ void AssemblyUEyeFakeCamera::setPixelClock(unsigned int pc)
     if (currentPixelClock_!=pc) {
         currentPixelClock_ = pc;
 
-        if (currentPixelClock_==5) {
-            imageFilenames_ = imageFilenamesForPixelClock_[5];
-        } else if (currentPixelClock_>36) {
-            imageFilenames_ = imageFilenamesForPixelClock_[43];
-        } else if (currentPixelClock_>24) {
-            imageFilenames_ = imageFilenamesForPixelClock_[36];
-        } else if (currentPixelClock_>5) {
-            imageFilenames_ = imageFilenamesForPixelClock_[24];
-        } else {
-            imageFilenames_ = imageFilenamesForPixelClock_[4];
-        }
-
-        imageIndex_ = 0;
+        selectImages(currentPixelClock_);
 
         emit pixelClockChanged(currentPixelClock_);
         updateExposureTime();
@@ -221,12 +244,166 @@ void AssemblyUEyeFakeCamera::acquireImage()
 {
     if(cameraState_ != State::READY){ return; }
 
-    image_ = cv::imread(imageFilenames_[imageIndex_++], CV_LOAD_IMAGE_GRAYSCALE);
+    if(images_.empty())
+    {
+      NQLog("AssemblyUEyeFakeCamera", NQLog::Warning) << "acquireImage"
+         << ": no images available for pixel clock " << currentPixelClock_ << ", no action taken";
+
+      return;
+    }
+
+    waitForNextFrame();
+
+    applyDefocus(image_);
 
     NQLog("AssemblyUEyeFakeCamera", NQLog::Debug) << "acquireImage"
        << ": emitting signal \"imageAcquired\"";
 
     emit imageAcquired(image_);
 
-    if(imageIndex_ == imageFilenames_.size()){ imageIndex_ = 0; }
+    ++imageIndex_;
+    if(imageIndex_ >= images_.size()){ imageIndex_ = 0; }
+}
+
+void AssemblyUEyeFakeCamera::preloadImages()
+{
+    for(const auto& pc_filenames : imageFilenamesForPixelClock_)
+    {
+      for(const auto& filename : pc_filenames.second)
+      {
+        if(decodedImages_.find(filename) != decodedImages_.end()){ continue; }
+
+        const cv::Mat image = cv::imread(filename, CV_LOAD_IMAGE_GRAYSCALE);
+
+        if(image.empty())
+        {
+          NQLog("AssemblyUEyeFakeCamera", NQLog::Warning) << "preloadImages"
+             << ": failed to read image " << filename;
+
+          continue;
+        }
+
+        decodedImages_[filename] = image;
+      }
+    }
+
+    NQLog("AssemblyUEyeFakeCamera", NQLog::Message) << "preloadImages"
+       << ": " << decodedImages_.size() << " images decoded";
+}
+
+void AssemblyUEyeFakeCamera::selectImages(const unsigned int pixel_clock)
+{
+    unsigned int key = 4;
+
+    if (pixel_clock==5) {
+        key = 5;
+    } else if (pixel_clock>36) {
+        key = 43;
+    } else if (pixel_clock>24) {
+        key = 36;
+    } else if (pixel_clock>5) {
+        key = 24;
+    }
+
+    images_.clear();
+
+    for(const auto& filename : imageFilenamesForPixelClock_[key])
+    {
+      const auto it = decodedImages_.find(filename);
+
+      if(it != decodedImages_.end()){ images_.push_back(it->second); }
+    }
+
+    imageIndex_ = 0;
+}
+
+void AssemblyUEyeFakeCamera::waitForNextFrame()
+{
+    // latency of a single acquisition: exposure [ms] + readout + gaussian jitter
+    double latency = currentExposureTime_ + readoutLatency_;
+
+    if(latencyJitter_ > 0.)
+    {
+      std::normal_distribution<double> jitter(0., latencyJitter_);
+
+      latency += jitter(randomEngine_);
+    }
+
+    latency = std::max(0., latency);
+
+    const auto now = std::chrono::steady_clock::now();
+
+    auto ready = now + std::chrono::microseconds(static_cast<long>(latency * 1000.));
+
+    // frames are never delivered faster than the configured frame rate
+    if(frameRate_ > 0.)
+    {
+      const auto earliest = lastFrameTime_ + std::chrono::microseconds(static_cast<long>(1.e6 / frameRate_));
+
+      if(ready < earliest){ ready = earliest; }
+    }
+
+    std::this_thread::sleep_until(ready);
+
+    lastFrameTime_ = ready;
+}
+
+void AssemblyUEyeFakeCamera::setMotionModel(const LStepExpressModel* motion_model)
+{
+    if(motion_model_ != nullptr)
+    {
+      disconnect(motion_model_, SIGNAL(motionInformationChanged()), this, SLOT(updateMotionZ()));
+    }
+
+    motion_model_ = motion_model;
+    motionZValid_ = false;
+
+    // direct connection: the position vector is read in the thread that has just
+    // written it, the camera thread only reads the cached value
+    if(motion_model_ != nullptr)
+    {
+      connect(motion_model_, SIGNAL(motionInformationChanged()), this, SLOT(updateMotionZ()), Qt::DirectConnection);
+    }
+}
+
+void AssemblyUEyeFakeCamera::updateMotionZ()
+{
+    if(motion_model_ == nullptr){ return; }
+
+    const std::vector<double>& positions = motion_model_->getPositions();
+
+    if(positions.size() > 2)
+    {
+      motionZ_      = positions.at(2);
+      motionZValid_ = true;
+    }
+}
+
+void AssemblyUEyeFakeCamera::applyDefocus(cv::Mat& image) const
+{
+    const cv::Mat& source = images_.at(imageIndex_);
+
+    double sigma = 0.;
+
+    if(defocusEnabled_ && motionZValid_)
+    {
+      const double dz = motionZ_ - defocusFocalZ_;
+
+      sigma = std::min(std::fabs(dz) * defocusSigmaPerMM_, defocusSigmaMax_);
+    }
+
+    // always allocate a new buffer: previously emitted frames share their data
+    // with queued receivers, and the preloaded images must stay untouched
+    cv::Mat frame;
+
+    if(sigma > 0.1)
+    {
+      cv::GaussianBlur(source, frame, cv::Size(0, 0), sigma);
+    }
+    else
+    {
+      frame = source.clone();
+    }
+
+    image = frame;
 }
@@ -17,9 +17,15 @@
 
 #include <vector>
 #include <map>
+#include <string>
+#include <chrono>
+#include <random>
+#include <atomic>
 
 #include <opencv2/opencv.hpp>
 
+class LStepExpressModel;
+
 class AssemblyUEyeFakeCamera : public AssemblyVUEyeCamera
 {
  Q_OBJECT
@@ -35,6 +41,9 @@ class AssemblyUEyeFakeCamera : public AssemblyVUEyeCamera
 
   bool isAvailable() const { return true; }
 
+  // optional: Z position of the motion stage used to synthesise defocus blur
+  void setMotionModel(const LStepExpressModel* motion_model);
+
  public slots:
 
   void open();
@@ -45,13 +54,42 @@ class AssemblyUEyeFakeCamera : public AssemblyVUEyeCamera
   void setPixelClock(unsigned int pc);
   void setExposureTime(double et);
 
+  // runs in the thread emitting LStepExpressModel::motionInformationChanged
+  void updateMotionZ();
+
  protected:
 
+  void preloadImages();
+  void selectImages(const unsigned int pixel_clock);
+
+  void waitForNextFrame();
+  void applyDefocus(cv::Mat& image) const;
+
   cv::Mat image_;
-  std::vector<std::string> imageFilenames_;
+  std::vector<cv::Mat> images_;
   size_t imageIndex_;
 
   std::map<unsigned int, std::vector<std::string> > imageFilenamesForPixelClock_;
+
+  // decoded images, shared between pixel-clock settings (key: file path)
+  std::map<std::string, cv::Mat> decodedImages_;
+
+  // timing model
+  double frameRate_;       // [Hz] maximum rate of delivered frames
+  double readoutLatency_;  // [ms] latency added on top of the exposure time
+  double latencyJitter_;   // [ms] sigma of the gaussian jitter on the latency
+
+  std::chrono::steady_clock::time_point lastFrameTime_;
+  std::mt19937 randomEngine_;
+
+  // defocus model
+  const LStepExpressModel* motion_model_;
+  std::atomic<bool>   motionZValid_;
+  std::atomic<double> motionZ_; // [mm] cached, the model's position vector is not thread-safe
+  bool   defocusEnabled_;
+  double defocusFocalZ_;       // [mm] Z position of best focus
+  double defocusSigmaPerMM_;   // [pixel/mm] gaussian sigma per mm of defocus
+  double defocusSigmaMax_;     // [pixel]
 };
 
 #endif // ASSEMBLYUEYEFAKECAMERA_H
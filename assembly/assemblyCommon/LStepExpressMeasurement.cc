@@ -14,7 +14,10 @@
 #include <QString>
 #include <QDateTime>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 #include "LStepExpressMeasurement.h"
+#include "LStepExpressRowAlignment.h"
 
 LStepExpressMeasurement::LStepExpressMeasurement(LStepExpressModel* model, LStepExpressMotionManager* manager, LaserModel* laserModel, LStepExpressMeasurementTable* table, QObject*) :
   QObject(),
@@ -39,10 +42,18 @@ LStepExpressMeasurement::LStepExpressMeasurement(LStepExpressModel* model, LStep
     currentIndex_ = -1;
     tableSize_ = 0;
 
+    isContinuous_ = false;
+    scanVelocity_ = 5.0;
+    rowLength_ = 1;
+    rowPhase_ = RowApproach;
+    savedVelocity_ = 0.0;
+
     connect(model_, SIGNAL(emergencyStop_request()), this, SLOT(stopMeasurement()));
 
     connect(model_, SIGNAL(motionFinished()), this, SLOT(takeMeasurement()));
 
+    connect(model_, SIGNAL(motionInformationChanged()), this, SLOT(recordRowPosition()));
+
     connect(this, SIGNAL(nextScanStep()), this, SLOT(doNextScanStep()));
 
     connect(laserModel_, SIGNAL(deviceStateChanged(State)), this, SLOT(setLaserEnabled(State)));
@@ -60,6 +71,17 @@ void LStepExpressMeasurement::setZigZag(bool zigzag)
     isZigZag_ = zigzag;
 }
 
+void LStepExpressMeasurement::setContinuous(bool continuous)
+{
+    if(measurementInProgress_){return;}
+    isContinuous_ = continuous;
+}
+
+void LStepExpressMeasurement::setScanVelocity(double velocity)
+{
+    if(velocity > 0.0){scanVelocity_ = velocity;}
+}
+
 void LStepExpressMeasurement::setAverageMeasEnabled(bool enabled)
 {
   //    NQLog("LStepExpressMeasurement ", NQLog::Debug) << "setAverageMeasEnabled";
@@ -141,6 +163,7 @@ void LStepExpressMeasurement::generatePositions()
   table_->update();
 
   tableSize_ = table_->rowCount();
+  rowLength_ = nstepsy + 1;
   
   //  NQLog("LStepExpressMeasurement ", NQLog::Debug) << "generate positions, row count = "<<table_->rowCount()    ;
 
@@ -193,6 +216,11 @@ void LStepExpressMeasurement::takeMeasurement()
   //    NQLog("LStepExpressMeasurement ", NQLog::Debug) << "takeMeasurement"    ;  
     if(!isLaserEnabled_){return;}
     if(!measurementInProgress_){return;}
+
+    if(isContinuous_){
+        continueRowScan();
+        return;
+    }
     
     double value = 0;
     laserModel_->getMeasurement(value);
@@ -211,16 +239,119 @@ void LStepExpressMeasurement::doNextScanStep()
     double y_pos;
     double z_pos;
 
+    //in continuous mode currentIndex_ is the first point of the next row
     if(currentIndex_ < tableSize_ && clearedForMotion_){
         x_pos = table_->data(table_->index(currentIndex_,1), Qt::DisplayRole).toDouble();                                                                                
         y_pos = table_->data(table_->index(currentIndex_,2), Qt::DisplayRole).toDouble();                                                                               
 	z_pos = table_->data(table_->index(currentIndex_,3), Qt::DisplayRole).toDouble();                                                                               
+	rowPhase_ = RowApproach;
 	model_->moveAbsolute(x_pos, y_pos, z_pos, 0.0);
     }else{
 	measurementInProgress_ = false;
     }
 }
 
+//called on motionFinished in continuous mode: either the stage arrived at
+//the start of a row and the sweep is started, or the sweep is complete
+void LStepExpressMeasurement::continueRowScan()
+{
+    if(rowPhase_ == RowSweep){
+        finishRowScan();
+        return;
+    }
+
+    if(!clearedForMotion_ || currentIndex_ >= tableSize_){
+        measurementInProgress_ = false;
+        return;
+    }
+
+    const int last = std::min(currentIndex_ + rowLength_, tableSize_) - 1;
+    const double x_pos = table_->data(table_->index(last,1), Qt::DisplayRole).toDouble();
+    const double y_pos = table_->data(table_->index(last,2), Qt::DisplayRole).toDouble();
+    const double z_pos = table_->data(table_->index(last,3), Qt::DisplayRole).toDouble();
+
+    traceTime_.clear();
+    tracePosition_.clear();
+
+    laserModel_->startDataStorage();
+    rowClock_.start();
+
+    //the cached position may predate motionFinished, read it from the controller
+    traceTime_.push_back(0.0);
+    tracePosition_.push_back(model_->readPosition(1));
+
+    savedVelocity_ = model_->getVelocity(1);
+    model_->setVelocity(1, scanVelocity_);
+
+    rowPhase_ = RowSweep;
+    model_->moveAbsolute(x_pos, y_pos, z_pos, 0.0);
+}
+
+void LStepExpressMeasurement::finishRowScan()
+{
+    const double duration = rowClock_.elapsed();
+    laserModel_->stopDataStorage();
+    model_->setVelocity(1, savedVelocity_);
+    rowPhase_ = RowApproach;
+
+    if(!clearedForMotion_){
+        measurementInProgress_ = false;
+        return;
+    }
+
+    //the last poll happened before the stage stopped
+    traceTime_.push_back(duration);
+    tracePosition_.push_back(model_->readPosition(1));
+
+    std::vector<double> samples;
+    laserModel_->getDataStorage(samples);
+
+    const int first = currentIndex_;
+    const int last = std::min(currentIndex_ + rowLength_, tableSize_);
+
+    std::vector<double> targets;
+    for(int i = first; i < last; i++){
+        targets.push_back(table_->data(table_->index(i,2), Qt::DisplayRole).toDouble());
+    }
+
+    std::vector<double> values;
+    alignRowSamples(samples, duration, traceTime_, tracePosition_, targets,
+                    averageMeasEnabled_ ? 0.5*std::fabs(y_stepsize) : 0.0, values);
+
+    NQLog("LStepExpressMeasurement", NQLog::Debug) << "finishRowScan"
+       << ": " << samples.size() << " samples in " << duration << " ms for rows "
+       << first << " to " << last-1;
+
+    for(int i = first; i < last; i++){
+        table_->insertData(4, i, values[i-first]);
+    }
+    table_->update();
+    currentIndex_ = last;
+
+    emit informationChanged();
+    emit nextScanStep();
+}
+
+//stage positions polled by the model during a sweep, used to place the samples
+void LStepExpressMeasurement::recordRowPosition()
+{
+    if(!measurementInProgress_ || !isContinuous_ || rowPhase_ != RowSweep){return;}
+
+    traceTime_.push_back(rowClock_.elapsed());
+    tracePosition_.push_back(model_->getPosition(1));
+}
+
+void LStepExpressMeasurement::alignRowSamples(const std::vector<double>& samples,
+                                              double duration,
+                                              const std::vector<double>& traceTime,
+                                              const std::vector<double>& tracePosition,
+                                              const std::vector<double>& targets,
+                                              double window,
+                                              std::vector<double>& values)
+{
+    alignLaserRowSamples(samples, duration, traceTime, tracePosition, targets, window, values);
+}
+
 //FIX ME! needs to be tested in the lab
 void LStepExpressMeasurement::performScan()
 {
@@ -231,6 +362,7 @@ void LStepExpressMeasurement::performScan()
     measurementInProgress_ = true;
     clearedForMotion_ = true;
     currentIndex_ = 0;
+    rowPhase_ = RowApproach;
 
     emit nextScanStep();
 }
@@ -35,6 +35,7 @@
 #include <QLCDNumber>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QElapsedTimer>
 
 #include "LStepExpressModel.h"
 #include "LStepExpressMeasurementTable.h"
@@ -51,6 +52,15 @@ public:
     ~LStepExpressMeasurement();
     void setInit(double x_min_, double x_max_, double y_min_, double y_max_, double x_stepsize_, double y_stepsize_);
 
+    /// see alignLaserRowSamples() in LStepExpressRowAlignment.h
+    static void alignRowSamples(const std::vector<double>& samples,
+                                double duration,
+                                const std::vector<double>& traceTime,
+                                const std::vector<double>& tracePosition,
+                                const std::vector<double>& targets,
+                                double window,
+                                std::vector<double>& values);
+
 protected:
     LStepExpressModel* model_;
     LStepExpressMotionManager* manager_;
@@ -64,6 +74,8 @@ public slots:
     void generatePositions();
     void setAverageMeasEnabled(bool);
     void setZigZag(bool);
+    void setContinuous(bool);
+    void setScanVelocity(double);
     void takeMeasurement();
     void setLaserEnabled(State newState);
 
@@ -92,10 +104,27 @@ private:
     bool isLaserEnabled_;
     bool measurementInProgress_;
 
+    //continuous mode: every row is one move along y at scanVelocity_ while the
+    //laser fills its internal buffer, which is read once at the end of the row
+    enum RowPhase { RowApproach, RowSweep };
+
+    bool isContinuous_;
+    double scanVelocity_;
+    int rowLength_;
+    RowPhase rowPhase_;
+    double savedVelocity_;
+    QElapsedTimer rowClock_;
+    std::vector<double> traceTime_;
+    std::vector<double> tracePosition_;
+
+    void continueRowScan();
+    void finishRowScan();
+
 private slots:
     void performScan();
     void stopMeasurement();
     void doNextScanStep();
+    void recordRowPosition();
 
  signals:
     void nextScanStep();
@@ -28,6 +28,7 @@ LStepExpressMeasurementWidget::LStepExpressMeasurementWidget(LStepExpressModel*
     averageMeasCheckBox_ = new QCheckBox("Average measurement", this);
     buttonGeneratePos_ = new QPushButton("Generate positions", this);
     zigzagCheckBox_ = new QCheckBox("Zigzag motion (default is meander)", this);
+    continuousCheckBox_ = new QCheckBox("Continuous scan along y", this);
     buttonStartMeasurement_ = new QPushButton("Start Measurement", this);
     buttonStartMeasurement_->setEnabled(false);
     //checkBoxEnableLaser_ = new QCheckBox("Enable Laser", this);
@@ -42,6 +43,7 @@ LStepExpressMeasurementWidget::LStepExpressMeasurementWidget(LStepExpressModel*
     y_max_ = new QLineEdit();
     x_stepsize_ = new QLineEdit();
     y_stepsize_ = new QLineEdit();
+    scan_velocity_ = new QLineEdit("5.0");
     
     QLabel* label_x_min = new QLabel("x min");
     QLabel* label_x_max = new QLabel("x max");
@@ -49,6 +51,7 @@ LStepExpressMeasurementWidget::LStepExpressMeasurementWidget(LStepExpressModel*
     QLabel* label_y_max = new QLabel("y max");
     QLabel* label_x_stepsize = new QLabel("stepsize x");
     QLabel* label_y_stepsize = new QLabel("stepsize y");
+    QLabel* label_scan_velocity = new QLabel("scan velocity y");
 
     //set the layout
     QHBoxLayout* layout = new QHBoxLayout(this);
@@ -72,10 +75,14 @@ LStepExpressMeasurementWidget::LStepExpressMeasurementWidget(LStepExpressModel*
     QHBoxLayout *hlayout_y_stepsize = new QHBoxLayout(this);
     hlayout_y_stepsize->addWidget(label_y_stepsize);
     hlayout_y_stepsize->addWidget(y_stepsize_);
+    QHBoxLayout *hlayout_scan_velocity = new QHBoxLayout(this);
+    hlayout_scan_velocity->addWidget(label_scan_velocity);
+    hlayout_scan_velocity->addWidget(scan_velocity_);
 
     QHBoxLayout *hlayout_checkbox = new QHBoxLayout(this);
     hlayout_checkbox->addWidget(averageMeasCheckBox_);
     hlayout_checkbox->addWidget(zigzagCheckBox_);
+    hlayout_checkbox->addWidget(continuousCheckBox_);
 
     QVBoxLayout *layout_xy = new QVBoxLayout(this);
     layout_xy->addLayout(hlayout_x_min);
@@ -84,6 +91,7 @@ LStepExpressMeasurementWidget::LStepExpressMeasurementWidget(LStepExpressModel*
     layout_xy->addLayout(hlayout_y_min);
     layout_xy->addLayout(hlayout_y_max);
     layout_xy->addLayout(hlayout_y_stepsize);
+    layout_xy->addLayout(hlayout_scan_velocity);
     layout_xy->addLayout(hlayout_checkbox);
     layout_xy->addWidget(buttonGeneratePos_);
     
@@ -135,6 +143,7 @@ LStepExpressMeasurementWidget::LStepExpressMeasurementWidget(LStepExpressModel*
 	this, SLOT(lstepStateChanged(State)));
 
     connect(zigzagCheckBox_, SIGNAL(toggled(bool)), measurement_model_, SLOT(setZigZag(bool)));
+    connect(continuousCheckBox_, SIGNAL(toggled(bool)), measurement_model_, SLOT(setContinuous(bool)));
 
     connect(measurement_model_, SIGNAL(informationChanged()),
 	this, SLOT(updateWidget()));
@@ -151,6 +160,8 @@ LStepExpressMeasurementWidget::LStepExpressMeasurementWidget(LStepExpressModel*
 	this, SLOT(setInit()));
     connect(y_stepsize_, SIGNAL(textChanged(QString)),
 	this, SLOT(setInit()));
+    connect(scan_velocity_, SIGNAL(textChanged(QString)),
+	this, SLOT(setScanVelocity()));
 
     laserStateChanged(laserModel_->getDeviceState());
     lstepStateChanged(model_->getDeviceState());
@@ -165,6 +176,7 @@ LStepExpressMeasurementWidget::~LStepExpressMeasurementWidget()
     if(buttonStoreMeasurement_){delete buttonStoreMeasurement_; buttonStoreMeasurement_ = nullptr;}
     //if(checkBoxEnableLaser_){delete checkBoxEnableLaser_; checkBoxEnableLaser_ = nullptr;}
     if(zigzagCheckBox_){delete zigzagCheckBox_; zigzagCheckBox_ = nullptr;}
+    if(continuousCheckBox_){delete continuousCheckBox_; continuousCheckBox_ = nullptr;}
 }
 
 void LStepExpressMeasurementWidget::laserStateChanged(State /* newState */)
@@ -187,6 +199,11 @@ void LStepExpressMeasurementWidget::setInit()
     measurement_model_->setInit(x_min_->text().toDouble(),x_max_->text().toDouble(),y_min_->text().toDouble(),y_max_->text().toDouble(),x_stepsize_->text().toDouble(),y_stepsize_->text().toDouble());
 }
 
+void LStepExpressMeasurementWidget::setScanVelocity()
+{
+    measurement_model_->setScanVelocity(scan_velocity_->text().toDouble());
+}
+
 void LStepExpressMeasurementWidget::updateWidget()
 {
   //  NQLog("LStepExpressMeasurementWidget ", NQLog::Debug) << "updateWidget()";
@@ -64,6 +64,8 @@ protected:
     QPushButton *buttonStoreMeasurement_;
     //    QCheckBox *checkBoxEnableLaser_;
     QCheckBox *zigzagCheckBox_;
+    QCheckBox *continuousCheckBox_;
+    QLineEdit* scan_velocity_;
     QLineEdit* x_min_;
     QLineEdit* x_max_;
     QLineEdit* y_min_;
@@ -79,6 +81,7 @@ public slots:
     void laserStateChanged(State newState);
     void lstepStateChanged(State newState);
     void setInit();
+    void setScanVelocity();
 
 private:
     QTableView *table_view;
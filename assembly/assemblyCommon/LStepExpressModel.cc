@@ -328,6 +328,26 @@ double LStepExpressModel::getPosition(unsigned int axis)
     return position_[axis];
 }
 
+double LStepExpressModel::readPosition(unsigned int axis)
+{
+    if(controller_ == nullptr)
+    {
+      NQLog("LStepExpressModel", NQLog::Critical) << "readPosition(" << axis << ")"
+         << ": null pointer to controller, returning cached position";
+
+      return position_[axis];
+    }
+
+    NQLog("LStepExpressModel", NQLog::Debug) << "readPosition(" << axis << ")";
+
+    QMutexLocker locker(&mutex_);
+
+    double value = 0.;
+    controller_->GetPosition((VLStepExpress::Axis)axis, value);
+
+    return value;
+}
+
 void LStepExpressModel::setAccelerationJerk(const std::vector<double>& values)
 {
   if(values.size() != 4)
@@ -1351,23 +1371,17 @@ void LStepExpressModel::updateMotionInformationFromTimer()
         changed = true;
       }
 
+      // motionFinished is emitted only after the position has been read,
+      // so that listeners dispatching the next motion see the final position
+      bool finished = false;
+
       if(inMotion_)
       {
-        bool temp = true;
-        for(int i = 0; i < 4; i++)
-        {
-          bool ifaxisenabled = ( (ivalues)[i] == LStepExpress_t::AXISSTANDSANDREADY || (ivalues)[i] == LStepExpress_t::AXISACKAFTERCALIBRATION) && (axis_)[i] == 1;
-          bool ifaxisnotenabled = (axis_)[i] == 0;
-          temp *= (ifaxisenabled || ifaxisnotenabled);
-        }
-        if(temp)
+        finished = this->axesReady(ivalues);
+
+        if(finished)
         {
           inMotion_ = false;
-
-          NQLog("LStepExpressModel", NQLog::Debug) << "updateMotionInformationFromTimer"
-              << ": emitting signal \"motionFinished\"";
-
-          emit motionFinished();
         }
       }
 
@@ -1398,7 +1412,72 @@ void LStepExpressModel::updateMotionInformationFromTimer()
       }
 
       isUpdating_ = false;
+
+      if(finished)
+      {
+        NQLog("LStepExpressModel", NQLog::Debug) << "updateMotionInformationFromTimer"
+            << ": emitting signal \"motionFinished\"";
+
+        emit motionFinished();
+      }
+    }
+}
+
+bool LStepExpressModel::axesReady(const std::vector<int>& status) const
+{
+    if(status.size() < 4){ return false; }
+
+    bool ready = true;
+    for(int i = 0; i < 4; i++)
+    {
+      bool ifaxisenabled = ( status[i] == LStepExpress_t::AXISSTANDSANDREADY || status[i] == LStepExpress_t::AXISACKAFTERCALIBRATION) && (axis_)[i] == 1;
+      bool ifaxisnotenabled = (axis_)[i] == 0;
+      ready *= (ifaxisenabled || ifaxisnotenabled);
+    }
+
+    return ready;
+}
+
+void LStepExpressModel::checkMotionFinished()
+{
+    // lightweight version of updateMotionInformationFromTimer, meant to be
+    // polled at short intervals while a motion is ongoing: only the axis status
+    // is queried, the position is read once the motion has finished
+    if(controller_ == nullptr){ return; }
+
+    if((state_ != READY) || isPaused_ || isUpdating_ || (inMotion_ == false) || finishedCalibrating_){ return; }
+
+    isUpdating_ = true;
+
+    std::vector<int> ivalues;
+    controller_->GetAxisStatus(ivalues);
+
+    if(this->axesReady(ivalues) == false)
+    {
+      isUpdating_ = false;
+
+      return;
+    }
+
+    axisStatus_ = ivalues;
+
+    inMotion_ = false;
+
+    if((axis_)[0] || (axis_)[1] || (axis_)[2] || (axis_)[3])
+    {
+      std::vector<double> dvalues;
+      controller_->GetPosition(dvalues);
+      position_ = dvalues;
     }
+
+    isUpdating_ = false;
+
+    NQLog("LStepExpressModel", NQLog::Debug) << "checkMotionFinished"
+        << ": emitting signals \"motionInformationChanged\" and \"motionFinished\"";
+
+    emit motionInformationChanged();
+
+    emit motionFinished();
 }
 
 void LStepExpressModel::setDeviceEnabled(bool enabled)
@@ -61,6 +61,8 @@ class LStepExpressModel : public QObject, public AbstractDeviceModel<LStepExpres
     double getDeceleration(unsigned int axis);
     double getVelocity(unsigned int axis);
     double getPosition(unsigned int axis);
+    /// position read from the controller instead of the cache
+    double readPosition(unsigned int axis);
 
     const std::vector<double>& getPositions() const { return position_; }
 
@@ -128,6 +130,8 @@ class LStepExpressModel : public QObject, public AbstractDeviceModel<LStepExpres
 
     void emergencyStop();
 
+    void checkMotionFinished();
+
   protected:
 
     void renewController(const QString& port) override;
@@ -147,6 +151,9 @@ class LStepExpressModel : public QObject, public AbstractDeviceModel<LStepExpres
 
     void setDeviceState( State state );
 
+    /// true if all enabled axes report ready (status as from GetAxisStatus)
+    bool axesReady(const std::vector<int>& status) const;
+
     std::vector<int> axis_;
     std::vector<int> axisDirection_;
     std::vector<int> dim_;
@@ -16,6 +16,8 @@
 #include <ApplicationConfig.h>
 #include <nqlogger.h>
 
+#include <cmath>
+
 #include <unistd.h>
 
 LStepExpressMotionManager::LStepExpressMotionManager(LStepExpressModel* model, QObject* parent)
@@ -24,6 +26,11 @@ LStepExpressMotionManager::LStepExpressMotionManager(LStepExpressModel* model, Q
  , model_(model)
  , model_connected_(false)
  , inMotion_(false)
+
+ , mergeMotions_(true)
+ , lookAheadTimer_(nullptr)
+ , segmentPending_(false)
+ , segmentMerged_(0)
 {
   qRegisterMetaType<LStepExpressMotion>("LStepExpressMotion");
   qRegisterMetaType<QQueue<LStepExpressMotion> >("QQueue<LStepExpressMotion>");
@@ -46,6 +53,8 @@ LStepExpressMotionManager::LStepExpressMotionManager(LStepExpressModel* model, Q
   a_lowerBound_ = config->getValue<double>("MotionStageLowerBound_A", -180.);
   a_upperBound_ = config->getValue<double>("MotionStageUpperBound_A",  180.);
 
+  mergeMotions_ = config->getValue<bool>("LStepExpressMotionManager_MergeMotions", true);
+
   if(model_ == nullptr)
   {
     NQLog("LStepExpressMotionManager", NQLog::Fatal) << "initialization error"
@@ -56,6 +65,19 @@ LStepExpressMotionManager::LStepExpressMotionManager(LStepExpressModel* model, Q
 
   connect(this, SIGNAL(emergencyStop_request()), this, SLOT(emergency_stop()));
 
+  // while a motion is ongoing, poll the axis status at a faster rate than the
+  // model's own update timer, so that the next queued motion is dispatched
+  // as soon as the controller reports the axes ready
+  const int lookAheadInterval = config->getValue<int>("LStepExpressMotionManager_LookAheadInterval", 50);
+
+  if(lookAheadInterval > 0)
+  {
+    lookAheadTimer_ = new QTimer(this);
+    lookAheadTimer_->setInterval(lookAheadInterval);
+
+    connect(lookAheadTimer_, SIGNAL(timeout()), model_, SLOT(checkMotionFinished()));
+  }
+
   this->connect_model();
 }
 
@@ -123,8 +145,26 @@ void LStepExpressMotionManager::run()
 {
     if(inMotion_){ return; }
 
+    // a new sequence of motions starts when the manager was idle
+    const bool idle = (segmentPending_ == false);
+
+    if(segmentPending_)
+    {
+      segmentPending_ = false;
+
+      const double time = segmentClock_.elapsed() / 1000.;
+
+      segmentTimes_.emplace_back(time);
+
+      NQLog("LStepExpressMotionManager", NQLog::Debug) << "run"
+         << ": motion #" << segmentTimes_.size() << " finished after " << time << " s"
+         << " (" << segmentMerged_ << " queued motion(s))";
+    }
+
     if(motions_.empty())
     {
+      if(lookAheadTimer_ != nullptr){ lookAheadTimer_->stop(); }
+
       NQLog("LStepExpressMotionManager", NQLog::Spam) << "run"
          << ": emitting signal \"motion_finished\"";
 
@@ -142,8 +182,44 @@ void LStepExpressMotionManager::run()
 
     LStepExpressMotion motion = motions_.dequeue();
 
+    // look-ahead: merge the following queued motions into the current one
+    // as long as they continue along the same direction, which saves the
+    // full stop (and the status round-trip) at the intermediate points
+    int merged(1);
+
+    if(mergeMotions_)
+    {
+      std::vector<double> start;
+
+      if((model_->isUpdating() == false) && (model_->isInMotion() == false))
+      {
+        start = model_->getPositions();
+      }
+
+      while((motions_.empty() == false) && this->mergeMotion(motion, motions_.head(), start))
+      {
+        motions_.dequeue();
+
+        ++merged;
+      }
+
+      if(merged > 1)
+      {
+        NQLog("LStepExpressMotionManager", NQLog::Spam) << "run"
+           << ": merged " << merged << " co-linear motions into a single motion";
+      }
+    }
+
     inMotion_ = true;
 
+    if(idle){ segmentTimes_.clear(); }
+
+    segmentPending_ = true;
+    segmentMerged_ = merged;
+    segmentClock_.start();
+
+    if(lookAheadTimer_ != nullptr){ lookAheadTimer_->start(); }
+
     if(motion.getMode() == true)
     {
       NQLog("LStepExpressMotionManager", NQLog::Spam) << "run: emitting signal \"signalMoveAbsolute("
@@ -170,6 +246,48 @@ void LStepExpressMotionManager::run()
     return;
 }
 
+bool LStepExpressMotionManager::mergeMotion(LStepExpressMotion& motion, const LStepExpressMotion& next, const std::vector<double>& start)
+{
+  if(motion.getMode() != next.getMode()){ return false; }
+
+  const bool absolute = motion.getMode();
+
+  // absolute motions need the position the motion starts from
+  if(absolute && (start.size() != 4)){ return false; }
+
+  const double p1[4] = {motion.getX(), motion.getY(), motion.getZ(), motion.getA()};
+  const double p2[4] = {next  .getX(), next  .getY(), next  .getZ(), next  .getA()};
+
+  double d1[4], d2[4];
+  for(int i=0; i<4; ++i)
+  {
+    d1[i] = absolute ? (p1[i] - start[i]) : p1[i];
+    d2[i] = absolute ? (p2[i] - p1[i])    : p2[i];
+  }
+
+  double n1(0.), n2(0.), dot(0.);
+  for(int i=0; i<4; ++i)
+  {
+    n1  += d1[i] * d1[i];
+    n2  += d2[i] * d2[i];
+    dot += d1[i] * d2[i];
+  }
+
+  // same direction: cos(angle) = 1 within tolerance (null motions always merge)
+  if((n1 > 0.) && (n2 > 0.) && (dot < (1. - 1e-9) * std::sqrt(n1 * n2))){ return false; }
+
+  if(absolute)
+  {
+    motion = next;
+  }
+  else
+  {
+    motion = LStepExpressMotion(p1[0]+p2[0], p1[1]+p2[1], p1[2]+p2[2], p1[3]+p2[3], false);
+  }
+
+  return true;
+}
+
 bool LStepExpressMotionManager::AxisIsReady(const int axis) const
 {
   const bool axis_ready = (model_->getAxisStatusText(axis) == "@");
@@ -196,6 +314,32 @@ void LStepExpressMotionManager::appendMotions(const QQueue<LStepExpressMotion>&
     this->run();
 }
 
+double LStepExpressMotionManager::appendMotions(const std::vector<LStepExpressMotion>& targets, const LStepExpressPathPlanner& planner)
+{
+    for(const auto& target : targets)
+    {
+      if(target.getMode() == false)
+      {
+        NQLog("LStepExpressMotionManager", NQLog::Critical) << "appendMotions"
+           << ": path planning requires absolute targets, no action taken";
+
+        return 0.0;
+      }
+    }
+
+    const LStepExpressMotion start(this->get_position_X(), this->get_position_Y(), this->get_position_Z(), this->get_position_A(), true);
+
+    QQueue<LStepExpressMotion> motions;
+    const double time = planner.plan(start, targets, motions);
+
+    NQLog("LStepExpressMotionManager", NQLog::Message) << "appendMotions"
+       << ": " << motions.size() << " planned motions, estimated time " << time << " s";
+
+    this->appendMotions(motions);
+
+    return time;
+}
+
 void LStepExpressMotionManager::moveRelative(const std::vector<double>& values)
 {
     if(values.size() != 4){
@@ -15,10 +15,13 @@
 
 #include <LStepExpressModel.h>
 #include <LStepExpressMotion.h>
+#include <LStepExpressPathPlanner.h>
 
 #include <vector>
 
 #include <QQueue>
+#include <QTimer>
+#include <QElapsedTimer>
 
 class LStepExpressMotionManager : public QObject
 {
@@ -42,12 +45,23 @@ class LStepExpressMotionManager : public QObject
 
     void myMoveToThread(QThread*);
 
+    /// queues the absolute targets in the order computed by the planner,
+    /// starting from the current position; returns the estimated time [s]
+    double appendMotions(const std::vector<LStepExpressMotion>& targets, const LStepExpressPathPlanner& planner);
+
+    /// duration [s] of each motion dispatched since the queue was last idle
+    const std::vector<double>& segment_times() const { return segmentTimes_; }
+
   protected:
 
     void run();
 
     bool AxisIsReady(const int) const;
 
+    /// merges next into motion if both move along the same direction
+    /// (for absolute motions, as seen from start); returns false otherwise
+    static bool mergeMotion(LStepExpressMotion& motion, const LStepExpressMotion& next, const std::vector<double>& start);
+
     LStepExpressModel* model_;
 
     bool model_connected_;
@@ -56,6 +70,15 @@ class LStepExpressMotionManager : public QObject
 
     QQueue<LStepExpressMotion> motions_;
 
+    bool mergeMotions_;
+
+    QTimer* lookAheadTimer_;
+
+    QElapsedTimer segmentClock_;
+    bool segmentPending_;
+    int segmentMerged_;
+    std::vector<double> segmentTimes_;
+
     //Bounds to the motion stage movements
     double x_lowerBound_;
     double x_upperBound_;
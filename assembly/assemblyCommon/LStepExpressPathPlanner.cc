@@ -0,0 +1,237 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#include <LStepExpressPathPlanner.h>
+#include <LStepExpressSettings.h>
+
+#include <nqlogger.h>
+
+#include <algorithm>
+#include <cmath>
+
+LStepExpressPathPlanner::LStepExpressPathPlanner()
+ : settleTime_(0.2)
+ , maxPasses_(50)
+{
+  for(int i=0; i<4; ++i)
+  {
+    velocity_[i] = 10.0;
+    acceleration_[i] = 100.0;
+    deceleration_[i] = 100.0;
+  }
+}
+
+void LStepExpressPathPlanner::setAxis(const unsigned int axis, const double velocity, const double acceleration, const double deceleration)
+{
+  if(axis > 3 || velocity <= 0.0 || acceleration <= 0.0 || deceleration <= 0.0)
+  {
+    NQLog("LStepExpressPathPlanner", NQLog::Warning) << "setAxis"
+       << "(axis=" << axis << ", velocity=" << velocity << ", acceleration=" << acceleration
+       << ", deceleration=" << deceleration << "): invalid input, no action taken";
+
+    return;
+  }
+
+  velocity_[axis] = velocity;
+  acceleration_[axis] = acceleration;
+  deceleration_[axis] = deceleration;
+}
+
+void LStepExpressPathPlanner::readSettings(LStepExpressSettings* settings)
+{
+  if(settings == nullptr){ return; }
+
+  const char* names[4] = { "X-", "Y-", "Z-", "A-" };
+
+  for(unsigned int i=0; i<4; ++i)
+  {
+    // velocity is given in revolutions per second, accelerations in m/s^2
+    const QString axis(names[i]);
+    const double pitch = settings->getValueForKey(axis + "SpindlePitch").toDouble();
+    const double velocity = settings->getValueForKey(axis + "Velocity").toDouble();
+    const double acceleration = settings->getValueForKey(axis + "Acceleration").toDouble();
+    const double deceleration = settings->getValueForKey(axis + "Deceleration").toDouble();
+
+    this->setAxis(i, velocity * pitch, acceleration * 1000.0, deceleration * 1000.0);
+  }
+}
+
+double LStepExpressPathPlanner::axisTime(const unsigned int axis, const double distance) const
+{
+  if(distance <= 0.0){ return 0.0; }
+
+  const double v = velocity_[axis];
+  const double a = acceleration_[axis];
+  const double d = deceleration_[axis];
+
+  // distance needed to reach full speed and stop again
+  const double ramp = 0.5*v*v/a + 0.5*v*v/d;
+
+  if(distance >= ramp)
+  {
+    return (distance - ramp)/v + v/a + v/d;
+  }
+
+  // triangular profile
+  const double vPeak = std::sqrt(2.0*distance*a*d/(a+d));
+
+  return vPeak/a + vPeak/d;
+}
+
+double LStepExpressPathPlanner::moveTime(const LStepExpressMotion& from, const LStepExpressMotion& to) const
+{
+  double t = axisTime(0, std::fabs(to.getX() - from.getX()));
+  t = std::max(t, axisTime(1, std::fabs(to.getY() - from.getY())));
+  t = std::max(t, axisTime(2, std::fabs(to.getZ() - from.getZ())));
+  t = std::max(t, axisTime(3, std::fabs(to.getA() - from.getA())));
+
+  return t + settleTime_;
+}
+
+double LStepExpressPathPlanner::pathTime(const LStepExpressMotion& start,
+                                         const std::vector<LStepExpressMotion>& targets,
+                                         const std::vector<int>& order) const
+{
+  double time = 0.0;
+  const LStepExpressMotion* previous = &start;
+
+  for(size_t i=0; i<order.size(); ++i)
+  {
+    const LStepExpressMotion& next = targets[order[i]];
+    time += moveTime(*previous, next);
+    previous = &next;
+  }
+
+  return time;
+}
+
+double LStepExpressPathPlanner::plan(const LStepExpressMotion& start,
+                                     const std::vector<LStepExpressMotion>& targets,
+                                     std::vector<int>& order) const
+{
+  const int n = targets.size();
+
+  order.clear();
+  if(n == 0){ return 0.0; }
+
+  // nearest neighbour path from the start position
+  std::vector<bool> visited(n, false);
+  const LStepExpressMotion* current = &start;
+  for(int i=0; i<n; ++i)
+  {
+    int best = -1;
+    double bestTime = 0.0;
+    for(int j=0; j<n; ++j)
+    {
+      if(visited[j]){ continue; }
+      const double t = moveTime(*current, targets[j]);
+      if(best < 0 || t < bestTime){ best = j; bestTime = t; }
+    }
+    visited[best] = true;
+    order.push_back(best);
+    current = &targets[best];
+  }
+
+  // 2-opt on the open path: reversing order[i..k] replaces the edges
+  // (i-1,i) and (k,k+1) by (i-1,k) and (i,k+1); the start stays fixed
+  // and the end of the path is free
+  auto node = [&](const int i) -> const LStepExpressMotion& {
+    return (i < 0) ? start : targets[order[i]];
+  };
+
+  for(int pass=0; pass<maxPasses_; ++pass)
+  {
+    bool improved = false;
+
+    for(int i=0; i<n-1; ++i)
+    {
+      for(int k=i+1; k<n; ++k)
+      {
+        double delta = moveTime(node(i-1), node(k)) - moveTime(node(i-1), node(i));
+        if(k < n-1)
+        {
+          delta += moveTime(node(i), node(k+1)) - moveTime(node(k), node(k+1));
+        }
+
+        if(delta < -1e-9)
+        {
+          std::reverse(order.begin()+i, order.begin()+k+1);
+          improved = true;
+        }
+      }
+    }
+
+    // or-opt: move a segment of up to three targets, possibly reversed,
+    // behind another position of the path
+    for(int length=1; length<=3; ++length)
+    {
+      for(int i=0; i+length<=n; ++i)
+      {
+        const int e = i+length-1;
+
+        double removed = moveTime(node(i-1), node(i));
+        if(e+1 < n)
+        {
+          removed += moveTime(node(e), node(e+1)) - moveTime(node(i-1), node(e+1));
+        }
+
+        for(int j=-1; j<n; ++j)
+        {
+          if(j >= i-1 && j <= e){ continue; }
+
+          const bool hasNext = (j+1 < n);
+          const double cut = hasNext ? moveTime(node(j), node(j+1)) : 0.0;
+
+          const double forward = moveTime(node(j), node(i)) - cut
+            + (hasNext ? moveTime(node(e), node(j+1)) : 0.0);
+          const double reversed = moveTime(node(j), node(e)) - cut
+            + (hasNext ? moveTime(node(i), node(j+1)) : 0.0);
+
+          const bool reverse = (reversed < forward);
+          if(std::min(forward, reversed) - removed < -1e-9)
+          {
+            std::vector<int> segment(order.begin()+i, order.begin()+e+1);
+            if(reverse){ std::reverse(segment.begin(), segment.end()); }
+
+            order.erase(order.begin()+i, order.begin()+e+1);
+            const int position = (j > e) ? j+1-length : j+1;
+            order.insert(order.begin()+position, segment.begin(), segment.end());
+
+            improved = true;
+            break;
+          }
+        }
+      }
+    }
+
+    if(!improved){ break; }
+  }
+
+  return pathTime(start, targets, order);
+}
+
+double LStepExpressPathPlanner::plan(const LStepExpressMotion& start,
+                                     const std::vector<LStepExpressMotion>& targets,
+                                     QQueue<LStepExpressMotion>& motions) const
+{
+  std::vector<int> order;
+  const double time = this->plan(start, targets, order);
+
+  for(size_t i=0; i<order.size(); ++i)
+  {
+    const LStepExpressMotion& target = targets[order[i]];
+    motions.enqueue(LStepExpressMotion(target.getX(), target.getY(), target.getZ(), target.getA(), true));
+  }
+
+  return time;
+}
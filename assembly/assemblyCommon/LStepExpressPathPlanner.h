@@ -0,0 +1,77 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef LSTEPEXPRESSPATHPLANNER_H
+#define LSTEPEXPRESSPATHPLANNER_H
+
+#include <LStepExpressMotion.h>
+
+#include <vector>
+
+#include <QQueue>
+
+class LStepExpressSettings;
+
+/*
+  Orders a set of absolute targets such that the motion stage visits all of
+  them in close to minimal time. The duration of a single move is estimated
+  from a trapezoidal velocity profile per axis (axes move simultaneously, the
+  slowest axis dominates) plus a constant settling time. The visiting order
+  is seeded with a nearest-neighbour path from the start position and then
+  improved with 2-opt segment reversals and or-opt segment moves.
+*/
+class LStepExpressPathPlanner
+{
+  public:
+
+    LStepExpressPathPlanner();
+
+    /// velocity in mm/s, acceleration and deceleration in mm/s^2
+    void setAxis(const unsigned int axis, const double velocity, const double acceleration, const double deceleration);
+
+    /// reads velocity, acceleration, deceleration and spindle pitch of all axes
+    void readSettings(LStepExpressSettings* settings);
+
+    void setSettleTime(const double seconds) { settleTime_ = seconds; }
+    void setMaxPasses(const int passes) { maxPasses_ = passes; }
+
+    double moveTime(const LStepExpressMotion& from, const LStepExpressMotion& to) const;
+
+    /// total estimated time for visiting the targets in the given order
+    double pathTime(const LStepExpressMotion& start,
+                    const std::vector<LStepExpressMotion>& targets,
+                    const std::vector<int>& order) const;
+
+    /// computes the visiting order and returns the estimated time in seconds
+    double plan(const LStepExpressMotion& start,
+                const std::vector<LStepExpressMotion>& targets,
+                std::vector<int>& order) const;
+
+    /// as above, but fills the ordered targets into a queue of absolute motions
+    double plan(const LStepExpressMotion& start,
+                const std::vector<LStepExpressMotion>& targets,
+                QQueue<LStepExpressMotion>& motions) const;
+
+  protected:
+
+    double axisTime(const unsigned int axis, const double distance) const;
+
+    double velocity_[4];
+    double acceleration_[4];
+    double deceleration_[4];
+
+    double settleTime_;
+    int maxPasses_;
+};
+
+#endif // LSTEPEXPRESSPATHPLANNER_H
@@ -0,0 +1,86 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef LSTEPEXPRESSROWALIGNMENT_H
+#define LSTEPEXPRESSROWALIGNMENT_H
+
+#include <vector>
+#include <cmath>
+
+/// Maps laser samples stored at a constant rate over duration onto the
+/// stage positions given by the trace (linear interpolation in time) and
+/// returns one value per target position: the mean of all samples within
+/// window, or the nearest sample if window is zero or no sample is close
+/// enough. Out of range samples (+/-9999) are ignored, targets without any
+/// valid sample get 9999.
+/// Kept free of Qt so that it can be checked in assembly_test.
+inline void alignLaserRowSamples(const std::vector<double>& samples,
+                                 double duration,
+                                 const std::vector<double>& traceTime,
+                                 const std::vector<double>& tracePosition,
+                                 const std::vector<double>& targets,
+                                 double window,
+                                 std::vector<double>& values)
+{
+    values.assign(targets.size(), 9999.);
+    if(samples.empty() || traceTime.empty()){return;}
+
+    //the controller stores at a fixed rate, so the samples are spread evenly
+    //over the storage period; their positions follow from the polled trace
+    const double dt = duration / samples.size();
+    std::vector<double> position;
+    std::vector<double> value;
+    position.reserve(samples.size());
+    value.reserve(samples.size());
+
+    size_t j = 0;
+    for(size_t i = 0; i < samples.size(); i++){
+        if(std::fabs(samples[i]) >= 9999.){continue;}
+
+        const double t = (i + 0.5) * dt;
+        while(j + 1 < traceTime.size() && traceTime[j+1] < t){j++;}
+
+        double p;
+        if(t <= traceTime.front()){
+            p = tracePosition.front();
+        }else if(j + 1 >= traceTime.size()){
+            p = tracePosition.back();
+        }else{
+            const double span = traceTime[j+1] - traceTime[j];
+            const double f = span > 0. ? (t - traceTime[j]) / span : 0.;
+            p = tracePosition[j] + f * (tracePosition[j+1] - tracePosition[j]);
+        }
+
+        position.push_back(p);
+        value.push_back(samples[i]);
+    }
+
+    if(position.empty()){return;}
+
+    for(size_t k = 0; k < targets.size(); k++){
+        double sum = 0.;
+        int n = 0;
+        size_t nearest = 0;
+        for(size_t i = 0; i < position.size(); i++){
+            const double d = std::fabs(position[i] - targets[k]);
+            if(d < std::fabs(position[nearest] - targets[k])){nearest = i;}
+            if(window > 0. && d <= window){
+                sum += value[i];
+                n++;
+            }
+        }
+        values[k] = n > 0 ? sum / n : value[nearest];
+    }
+}
+
+#endif // LSTEPEXPRESSROWALIGNMENT_H
@@ -98,6 +98,37 @@ void LaserModel::getMeasurement(double& value)
     }
 }
 
+//clears the buffer of the controller and starts storing values of the current head
+void LaserModel::startDataStorage()
+{
+    if(state_ == OFF) return;
+
+    QMutexLocker locker(&mutex_);
+    bool storing = false;
+    int count = 0;
+    controller_->DataStorageStatus(storing, count);
+    if(storing) controller_->StopDataStorage();
+    controller_->InitDataStorage();
+    controller_->StartDataStorage();
+}
+
+void LaserModel::stopDataStorage()
+{
+    if(state_ == OFF) return;
+
+    QMutexLocker locker(&mutex_);
+    controller_->StopDataStorage();
+}
+
+void LaserModel::getDataStorage(std::vector<double>& values)
+{
+    values.clear();
+    if(state_ == OFF) return;
+
+    QMutexLocker locker(&mutex_);
+    controller_->OutputDataStorage(laserHead_, values);
+}
+
 //dummy method for testing
 void LaserModel::setMeasurement(double value)
 {
@@ -45,6 +45,11 @@ public:
     void setLaserHead(int out);
     void setMeasurement(double value); //dummy method for testing
 
+    // internal data storage of the controller, used for continuous scans
+    void startDataStorage();
+    void stopDataStorage();
+    void getDataStorage(std::vector<double>& values);
+
 public slots:
 
     void setDeviceEnabled(bool enabled = true);
@@ -0,0 +1,73 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include <LStepExpressRowAlignment.h>
+
+/// continuous row scan: samples of a linear sweep are placed on the right targets
+bool checkLaserRowAlignment()
+{
+  // 1000 ms sweep from y=0 to y=10 mm, laser value 2y+1, stage polled every 100 ms
+  std::vector<double> traceTime, tracePosition;
+  for (int i=0;i<=10;++i) {
+    traceTime.push_back(100.*i);
+    tracePosition.push_back(1.*i);
+  }
+
+  std::vector<double> samples;
+  for (int i=0;i<100;++i) samples.push_back(2.*(0.1*i + 0.05) + 1.);
+  samples[37] = 9999.;
+
+  std::vector<double> targets;
+  for (int i=0;i<=10;++i) targets.push_back(1.*i);
+
+  bool ok = true;
+  std::vector<double> values;
+
+  alignLaserRowSamples(samples, 1000., traceTime, tracePosition, targets, 0., values);
+  for (size_t k=0;k<targets.size();++k) {
+    if (std::fabs(values[k] - (2.*targets[k] + 1.))>0.11) ok = false;
+  }
+
+  alignLaserRowSamples(samples, 1000., traceTime, tracePosition, targets, 0.5, values);
+  for (size_t k=1;k+1<targets.size();++k) {
+    if (std::fabs(values[k] - (2.*targets[k] + 1.))>0.11) ok = false;
+  }
+
+  // a stale final trace point (stage still reported at 9 mm) shifts the end of the row
+  std::vector<double> staleTime(traceTime.begin(), traceTime.end()-1);
+  std::vector<double> stalePosition(tracePosition.begin(), tracePosition.end()-1);
+  alignLaserRowSamples(samples, 1000., staleTime, stalePosition, targets, 0., values);
+  if (std::fabs(values.back() - 21.)<0.5) ok = false;
+
+  std::vector<double> invalid(10, -9999.);
+  alignLaserRowSamples(invalid, 1000., traceTime, tracePosition, targets, 0., values);
+  for (size_t k=0;k<values.size();++k) if (values[k]!=9999.) ok = false;
+
+  alignLaserRowSamples(std::vector<double>(), 1000., traceTime, tracePosition, targets, 0., values);
+  if (values.size()!=targets.size() || values.front()!=9999.) ok = false;
+
+  return ok;
+}
+
+int main(int /* argc */, char ** /* argv */)
+{
+  const bool ok = checkLaserRowAlignment();
+
+  std::cout << "alignLaserRowSamples : " << (ok ? "ok" : "FAILED") << std::endl;
+
+  return ok ? 0 : 1;
+}
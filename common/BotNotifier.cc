@@ -0,0 +1,347 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <curl/curl.h>
+
+#include <nqlogger.h>
+
+#include "BotNotifier.h"
+
+BotNotifier* BotNotifier::instance_ = NULL;
+
+static size_t discardResponse(char* /* data */, size_t size, size_t nmemb, void* /* user */)
+{
+  return size * nmemb;
+}
+
+BotNotifier::BotNotifier()
+  : running_(true),
+    sending_(false),
+    queued_(0),
+    queueSize_(256),
+    coalesceInterval_(2.0),
+    minimumInterval_(10.0),
+    retries_(5),
+    backoff_(2.0),
+    timeout_(10.0),
+    postCount_(0),
+    dropCount_(0)
+{
+  curl_global_init(CURL_GLOBAL_ALL);
+
+  thread_ = std::thread(&BotNotifier::run, this);
+}
+
+BotNotifier::~BotNotifier()
+{
+  stop();
+}
+
+BotNotifier* BotNotifier::instance()
+{
+  static std::once_flag created;
+
+  std::call_once(created, []() {
+    instance_ = new BotNotifier();
+    std::atexit(BotNotifier::shutdown);
+  });
+
+  return instance_;
+}
+
+void BotNotifier::shutdown()
+{
+  if (instance_) instance_->stop();
+}
+
+void BotNotifier::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) return;
+    running_ = false;
+  }
+  condition_.notify_one();
+
+  // pending messages are posted once more, without waiting for the rate limit
+  if (thread_.joinable()) thread_.join();
+
+  curl_global_cleanup();
+}
+
+BotNotifier::Clock::duration BotNotifier::seconds(double s)
+{
+  return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(s));
+}
+
+void BotNotifier::setQueueSize(size_t size)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  queueSize_ = size;
+}
+
+void BotNotifier::setCoalesceInterval(double seconds)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  coalesceInterval_ = seconds;
+}
+
+void BotNotifier::setMinimumInterval(double seconds)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  minimumInterval_ = seconds;
+}
+
+void BotNotifier::setRetries(int retries, double backoff)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  retries_ = retries;
+  backoff_ = backoff;
+}
+
+void BotNotifier::setTimeout(double seconds)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  timeout_ = seconds;
+}
+
+size_t BotNotifier::getPostCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return postCount_;
+}
+
+size_t BotNotifier::getDropCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return dropCount_;
+}
+
+void BotNotifier::post(const std::string& webhook, const std::string& head,
+                       const std::string& tail, const std::string& text)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (!running_) return;
+
+  const std::string key = webhook + '\n' + head + '\n' + tail;
+
+  std::map<std::string,Destination_t>::iterator it = destinations_.find(key);
+  if (it==destinations_.end()) {
+    Destination_t destination;
+    destination.webhook = webhook;
+    destination.head = head;
+    destination.tail = tail;
+    destination.dropped = 0;
+    destination.due = Clock::now();
+    destination.nextAllowed = Clock::now();
+    destination.failures = 0;
+    it = destinations_.insert(std::make_pair(key, destination)).first;
+  }
+
+  Destination_t& destination = it->second;
+
+  // repeated texts are only counted
+  for (Text_t& t : destination.texts) {
+    if (t.text==text) {
+      t.count++;
+      return;
+    }
+  }
+
+  if (queued_>=queueSize_) {
+    destination.dropped++;
+    dropCount_++;
+    return;
+  }
+
+  // the first message opens the coalescing window (unless a retry is pending)
+  if (destination.texts.empty() && destination.failures==0) {
+    destination.due = std::max(Clock::now() + seconds(coalesceInterval_),
+                               destination.nextAllowed);
+  }
+
+  Text_t t;
+  t.text = text;
+  t.count = 1;
+  destination.texts.push_back(t);
+  queued_++;
+
+  condition_.notify_one();
+}
+
+bool BotNotifier::flush(double timeout)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  return idleCondition_.wait_for(lock, seconds(timeout),
+                                 [this]() { return queued_==0 && !sending_; });
+}
+
+std::string BotNotifier::digest(const std::vector<Text_t>& texts, size_t dropped)
+{
+  std::string text;
+
+  for (const Text_t& t : texts) {
+    if (!text.empty()) text += "\\n";
+    text += t.text;
+    if (t.count>1) text += " (" + std::to_string(t.count) + "x)";
+  }
+
+  if (dropped>0) {
+    if (!text.empty()) text += "\\n";
+    text += "(" + std::to_string(dropped) + " further messages dropped)";
+  }
+
+  return text;
+}
+
+int BotNotifier::send(const std::string& webhook, const std::string& data, double timeout)
+{
+  // one handle per webhook, so that libcurl can reuse the connection
+  CURL* curl = static_cast<CURL*>(handles_[webhook]);
+  if (!curl) {
+    curl = curl_easy_init();
+    if (!curl) {
+      NQLogWarning("BotNotifier") << "could not create curl handle";
+      return 1;
+    }
+    handles_[webhook] = curl;
+  }
+
+  curl_easy_setopt(curl, CURLOPT_URL, webhook.c_str());
+  curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data.c_str());
+  curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(data.size()));
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, discardResponse);
+  curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+  curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(timeout * 1000));
+
+  CURLcode res = curl_easy_perform(curl);
+
+  if (res!=CURLE_OK) {
+    NQLogWarning("BotNotifier") << "posting to webhook failed: " << curl_easy_strerror(res);
+    return 1;
+  }
+
+  long code = 0;
+  curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
+
+  if (code>=200 && code<300) return 0;
+
+  NQLogWarning("BotNotifier") << "webhook responded with HTTP status " << static_cast<int>(code);
+
+  // rate limited or server side problem: worth another try
+  if (code==429 || code>=500) return 1;
+
+  return -1;
+}
+
+void BotNotifier::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+
+    Destination_t* next = 0;
+    for (auto& d : destinations_) {
+      if (d.second.texts.empty()) continue;
+      if (next==0 || d.second.due<next->due) next = &d.second;
+    }
+
+    if (next==0) {
+      idleCondition_.notify_all();
+      if (!running_) break;
+      condition_.wait(lock);
+      continue;
+    }
+
+    if (running_ && Clock::now()<next->due) {
+      condition_.wait_until(lock, next->due);
+      continue;
+    }
+
+    // map entries are never erased, so the reference stays valid while unlocked
+    Destination_t& destination = *next;
+
+    std::vector<Text_t> texts;
+    texts.swap(destination.texts);
+    const size_t dropped = destination.dropped;
+    destination.dropped = 0;
+    queued_ -= texts.size();
+
+    const std::string webhook = destination.webhook;
+    const std::string data = destination.head + digest(texts, dropped) + destination.tail;
+    const bool lastAttempt = !running_ || destination.failures>=retries_;
+    const double timeout = timeout_;
+
+    sending_ = true;
+    lock.unlock();
+
+    const int result = send(webhook, data, timeout);
+
+    lock.lock();
+    sending_ = false;
+
+    const Clock::time_point now = Clock::now();
+
+    if (result==0) {
+      postCount_++;
+      destination.failures = 0;
+      destination.nextAllowed = now + seconds(minimumInterval_);
+      destination.due = std::max(destination.due, destination.nextAllowed);
+    } else if (result>0 && !lastAttempt) {
+
+      // put the texts back in front of those queued in the meantime
+      std::vector<Text_t> merged = texts;
+      for (const Text_t& t : destination.texts) {
+        bool found = false;
+        for (Text_t& m : merged) {
+          if (m.text==t.text) {
+            m.count += t.count;
+            found = true;
+            break;
+          }
+        }
+        if (!found) merged.push_back(t);
+      }
+      queued_ += merged.size() - destination.texts.size();
+      destination.texts.swap(merged);
+      destination.dropped += dropped;
+
+      destination.failures++;
+      const double delay = std::min(backoff_ * (1 << std::min(destination.failures-1, 10)), 600.0);
+      destination.due = now + seconds(delay);
+
+      NQLogWarning("BotNotifier") << "retry #" << destination.failures << " in " << delay << " s";
+    } else {
+      // messages dropped from the full queue are already counted
+      size_t count = 0;
+      for (const Text_t& t : texts) count += t.count;
+      dropCount_ += count;
+
+      destination.failures = 0;
+      destination.nextAllowed = now + seconds(minimumInterval_);
+      destination.due = std::max(destination.due, destination.nextAllowed);
+
+      NQLogWarning("BotNotifier") << "giving up, " << static_cast<int>(count + dropped) << " messages dropped";
+    }
+  }
+
+  for (auto& h : handles_) {
+    curl_easy_cleanup(static_cast<CURL*>(h.second));
+  }
+  handles_.clear();
+}
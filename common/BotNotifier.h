@@ -0,0 +1,130 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef BOTNOTIFIER_H
+#define BOTNOTIFIER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+/** @addtogroup common
+ *  @{
+ */
+
+/**
+  Posts webhook messages of SlackBot and MattermostBot from a background
+  thread, so that the posting thread never waits for the network.
+
+  Messages for the same destination (webhook, channel and user name) are
+  collected for a short coalescing interval and posted as a single digest,
+  in which repeated texts are counted instead of being repeated. Digests
+  of a destination are at least a minimum interval apart, so that a burst
+  of alarms becomes one post. Failed posts are retried with exponential
+  back-off. The connection to each webhook is kept open between posts.
+  The queue is bounded; messages beyond its size are dropped and counted
+  in the next digest.
+ */
+class BotNotifier
+{
+public:
+
+  typedef std::chrono::steady_clock Clock;
+
+  static BotNotifier* instance();
+
+  /**
+    Queues text for webhook. The posted data is head, the text
+    of the digest and tail, i.e. head and tail carry the payload fields
+    other than the text.
+   */
+  void post(const std::string& webhook, const std::string& head,
+            const std::string& tail, const std::string& text);
+
+  /// waits until all queued messages are posted or dropped; returns false on timeout
+  bool flush(double timeout);
+
+  void setQueueSize(size_t size);
+  void setCoalesceInterval(double seconds);
+  void setMinimumInterval(double seconds);
+  void setRetries(int retries, double backoff);
+  void setTimeout(double seconds);
+
+  size_t getPostCount() const;
+  size_t getDropCount() const;
+
+protected:
+
+  BotNotifier();
+  ~BotNotifier();
+
+  static BotNotifier* instance_;
+  static void shutdown();
+
+  typedef struct {
+    std::string text;
+    int count;
+  } Text_t;
+
+  typedef struct {
+    std::string webhook;
+    std::string head;
+    std::string tail;
+    std::vector<Text_t> texts;
+    size_t dropped;
+    Clock::time_point due;
+    Clock::time_point nextAllowed;
+    int failures;
+  } Destination_t;
+
+  void stop();
+  void run();
+
+  /// posts data; returns 0 on success, 1 for errors worth a retry, -1 otherwise
+  int send(const std::string& webhook, const std::string& data, double timeout);
+
+  static std::string digest(const std::vector<Text_t>& texts, size_t dropped);
+
+  static Clock::duration seconds(double s);
+
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+  std::condition_variable idleCondition_;
+  bool running_;
+  bool sending_;
+  std::thread thread_;
+
+  std::map<std::string,Destination_t> destinations_;
+  size_t queued_;
+
+  size_t queueSize_;
+  double coalesceInterval_;
+  double minimumInterval_;
+  int retries_;
+  double backoff_;
+  double timeout_;
+
+  size_t postCount_;
+  size_t dropCount_;
+
+  // accessed by the worker thread only
+  std::map<std::string,void*> handles_;
+};
+
+/** @} */
+
+#endif // BOTNOTIFIER_H
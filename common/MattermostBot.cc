@@ -10,14 +10,10 @@
 //                                                                             //
 /////////////////////////////////////////////////////////////////////////////////
 
-#include <iostream>
-#include <future>
-
-#include <curl/curl.h>
-
 #include <nqlogger.h>
 #include <ApplicationConfig.h>
 
+#include "BotNotifier.h"
 #include "MattermostBot.h"
 
 MattermostBot::MattermostBot(QObject *parent)
@@ -58,56 +54,29 @@ MattermostBot::~MattermostBot()
 
 }
 
-int mattermostpost(std::string webhook, std::string data)
-{
-  curl_global_init(CURL_GLOBAL_ALL);
-
-  CURL *curl;
-  CURLcode res;
-
-  curl = curl_easy_init();
-  if (curl) {
-
-    curl_easy_setopt(curl, CURLOPT_URL, webhook.c_str());
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data.c_str());
-
-    res = curl_easy_perform(curl);
-
-    if (res!=CURLE_OK) {
-      NQLogWarning("MattermostBot") << "MattermostBot failed: " << curl_easy_strerror(res);
-    }
-
-    curl_easy_cleanup(curl);
-  }
-
-  curl_global_cleanup();
-
-  return true;
-}
-
 void MattermostBot::postMessage(const QString& message)
 {
   QMutexLocker locker(&mutex_);
 
-  std::string data = "payload={\"channel\": \"";
+  std::string head = "payload={\"channel\": \"";
 
   if (channel_.isNull()) {
-    data += ApplicationConfig::instance()->getValue("mattermostchannel");
+    head += ApplicationConfig::instance()->getValue("mattermostchannel");
   } else {
-    data += channel_.toStdString();
+    head += channel_.toStdString();
   }
 
-  data += "\", \"username\": \"";
+  head += "\", \"username\": \"";
 
   if (username_.isNull()) {
-    data += ApplicationConfig::instance()->getValue("mattermostusername");
+    head += ApplicationConfig::instance()->getValue("mattermostusername");
   } else {
-    data += username_.toStdString();
+    head += username_.toStdString();
   }
 
-  data += "\", \"text\": \"";
-  data += message.toStdString();
-  data += "\"}";
+  head += "\", \"text\": \"";
+
+  std::string tail = "\"}";
 
   std::string webhook;
   if (webhook_.isNull()) {
@@ -116,9 +85,6 @@ void MattermostBot::postMessage(const QString& message)
     webhook = webhook_.toStdString();
   }
 
-#ifndef DARWIN
-  auto handle = std::async(std::launch::async, mattermostpost, webhook, data);
-#else
-  mattermostpost(webhook, data);
-#endif
+  // posted from a background thread, bursts of messages are combined
+  BotNotifier::instance()->post(webhook, head, tail, message.toStdString());
 }
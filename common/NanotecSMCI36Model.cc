@@ -56,6 +56,8 @@ NanotecSMCI36Model::NanotecSMCI36Model(const char* port,
   ioPolarityMask_ = 0xffffffff;
   io_ = 0xffffffff;
 
+  configurationValid_ = false;
+
   timer1_ = new QTimer(this);
   timer1_->setInterval(updateInterval1_ * 1000);
   connect( timer1_, SIGNAL(timeout()), this, SLOT(updateInformation1()) );
@@ -128,6 +130,7 @@ void NanotecSMCI36Model::setMotorID(int id)
 
   if (motorID_ != id) {
     controller_->SetMotorID(id);
+    configurationValid_ = false;
     motorID_ = id;
 
     emit informationChanged();
@@ -142,6 +145,7 @@ void NanotecSMCI36Model::setPhaseCurrent(int current)
 
   if (phaseCurrent_ != current) {
     controller_->SetPhaseCurrent(current);
+    configurationValid_ = false;
     phaseCurrent_ = current;
 
     emit informationChanged();
@@ -156,6 +160,7 @@ void NanotecSMCI36Model::setStandStillPhaseCurrent(int current)
 
   if (standStillPhaseCurrent_ != current) {
     controller_->SetStandStillPhaseCurrent(current);
+    configurationValid_ = false;
     standStillPhaseCurrent_ = current;
 
     emit informationChanged();
@@ -170,6 +175,7 @@ void NanotecSMCI36Model::setStepMode(int mode)
 
   if (stepMode_ != mode) {
     controller_->SetStepMode(mode);
+    configurationValid_ = false;
     stepMode_ = mode;
 
     emit informationChanged();
@@ -196,6 +202,7 @@ void NanotecSMCI36Model::setErrorCorrectionMode(int mode)
 
   if (errorCorrectionMode_ != mode) {
     controller_->SetErrorCorrectionMode(mode);
+    configurationValid_ = false;
     errorCorrectionMode_ = mode;
 
     emit informationChanged();
@@ -215,6 +222,7 @@ void NanotecSMCI36Model::setRampMode(int mode)
 
   if (rampMode_ != mode) {
     controller_->SetRampMode(mode);
+    configurationValid_ = false;
     rampMode_ = mode;
 
     emit informationChanged();
@@ -280,6 +288,7 @@ void NanotecSMCI36Model::setMaxEncoderDeviation(int steps)
 
   if (maxEncoderDeviation_ != steps) {
     controller_->SetMaxEncoderDeviation(steps);
+    configurationValid_ = false;
     maxEncoderDeviation_ = steps;
 
     emit informationChanged();
@@ -308,6 +317,7 @@ void NanotecSMCI36Model::setEncoderDirection(bool direction)
 
   if (encoderDirection_ != direction) {
     controller_->SetEncoderDirection(direction);
+    configurationValid_ = false;
     encoderDirection_ = direction;
     emit informationChanged();
   }
@@ -333,6 +343,7 @@ void NanotecSMCI36Model::setMinFrequency(int frequency)
 
   if (minFrequency_ != frequency) {
     controller_->SetMinimumFrequency(frequency);
+    configurationValid_ = false;
     minFrequency_ = frequency;
 
     emit informationChanged();
@@ -347,6 +358,7 @@ void NanotecSMCI36Model::setMaxFrequency(int frequency)
 
   if (maxFrequency_ != frequency) {
     controller_->SetMaximumFrequency(frequency);
+    configurationValid_ = false;
     maxFrequency_ = frequency;
     emit informationChanged();
   }
@@ -360,6 +372,7 @@ void NanotecSMCI36Model::setMaxFrequency2(int frequency)
 
   if (maxFrequency2_ != frequency) {
     controller_->SetMaximumFrequency2(frequency);
+    configurationValid_ = false;
     maxFrequency2_ = frequency;
 
     emit informationChanged();
@@ -374,6 +387,7 @@ void NanotecSMCI36Model::setQuickstopRampHzPerSecond(int ramp)
 
   if (quickstopRamp_ != ramp) {
     controller_->SetQuickstopRampHzPerSecond(ramp);
+    configurationValid_ = false;
     quickstopRamp_ = ramp;
 
     emit informationChanged();
@@ -388,6 +402,7 @@ void NanotecSMCI36Model::setAccelerationRampHzPerSecond(int ramp)
 
   if (accelRamp_ != ramp) {
     controller_->SetAccelerationRampHzPerSecond(ramp);
+    configurationValid_ = false;
     accelRamp_ = ramp;
 
     emit informationChanged();
@@ -400,9 +415,10 @@ void NanotecSMCI36Model::setDecelerationRampHzPerSecond(int ramp)
 
   // NQLogMessage("NanotecSMCI36Model") << "setDecelerationRampHzPerSecond(" << ramp << ")";
 
-  if (accelRamp_ != ramp) {
+  if (decelRamp_ != ramp) {
     controller_->SetDecelerationRampHzPerSecond(ramp);
-    accelRamp_ = ramp;
+    configurationValid_ = false;
+    decelRamp_ = ramp;
 
     emit informationChanged();
   }
@@ -466,6 +482,7 @@ void NanotecSMCI36Model::setIOMask(unsigned int mask)
 
   if (ioMask_ != mask) {
     controller_->SetIOMask(mask);
+    configurationValid_ = false;
     ioMask_ = mask;
 
     emit informationChanged();
@@ -480,6 +497,7 @@ void NanotecSMCI36Model::setReversePolarityMask(unsigned int mask)
 
   if (ioPolarityMask_ != mask) {
     controller_->SetReversePolarityMask(mask);
+    configurationValid_ = false;
     ioPolarityMask_ = mask;
 
     emit informationChanged();
@@ -510,6 +528,7 @@ void NanotecSMCI36Model::setInputPinFunction(int pin, int function)
 
   if (inputPinFunction_[pin] != function) {
     controller_->SetInputPinFunction(pin, function);
+    configurationValid_ = false;
     inputPinFunction_[pin] = function;
 
     emit informationChanged();
@@ -578,6 +597,7 @@ void NanotecSMCI36Model::setOutputPinFunction(int pin, int function)
 
   if (outputPinFunction_[pin] != function) {
     controller_->SetOutputPinFunction(pin, function);
+    configurationValid_ = false;
     outputPinFunction_[pin] = function;
 
     emit informationChanged();
@@ -677,6 +697,7 @@ void NanotecSMCI36Model::initialize()
   bool enabled = ( controller_ != NULL ) && ( controller_->DeviceAvailable() );
 
   if ( enabled ) {
+    configurationValid_ = false;
     setDeviceState(READY);
     updateInformation1();
     updateInformation2();
@@ -761,7 +782,11 @@ void NanotecSMCI36Model::updateInformation2()
     // NQLog("NanotecSMCI36Model", NQLog::Debug) << " running in dedicated DAQ thread";
   }
 
-  if ( state_ == READY ) {
+  if ( state_ == READY && !configurationValid_ ) {
+
+    // static configuration registers; all setters write through to the
+    // cached values, so they are only read back when marked invalid
+    configurationValid_ = true;
 
     int driveAddress = controller_->GetDriveAddress();
     int motorID = controller_->GetMotorID();
@@ -851,6 +876,21 @@ void NanotecSMCI36Model::updateInformation2()
   }
 }
 
+/// Forces a read back of all configuration registers from the controller.
+void NanotecSMCI36Model::refreshConfiguration()
+{
+  configurationValid_ = false;
+  updateInformation2();
+}
+
+void NanotecSMCI36Model::setStatusUpdateInterval(double interval)
+{
+  if (interval <= 0) return;
+
+  updateInterval1_ = interval;
+  timer1_->setInterval(updateInterval1_ * 1000);
+}
+
 /// Attempts to enable/disable the (communication with) the NanotecSMCI36 controller.
 void NanotecSMCI36Model::setDeviceEnabled(bool enabled)
 {
@@ -55,6 +55,8 @@ public:
 
   int getDriveAddress() const { return driveAddress_; }
 
+  double getStatusUpdateInterval() const { return updateInterval1_; }
+
   bool isReady() const;
   unsigned int getStatus() const { return status_; }
   const QString getStatusText() const;
@@ -163,18 +165,26 @@ public slots:
   void updateInformation1();
   void updateInformation2();
 
+  void refreshConfiguration();
+  void setStatusUpdateInterval(double interval);
+
 protected:
 
   const QString NanotecSMCI36_PORT;
 
   void initialize();
 
-  /// Time interval between cache refreshes; in seconds.
-  const double updateInterval1_;
+  /// Time interval between status and position polls; in seconds.
+  double updateInterval1_;
   QTimer* timer1_;
+  /// Time interval between checks of the configuration cache; in seconds.
   const double updateInterval2_;
   QTimer* timer2_;
 
+  /// False after a configuration setter, a reconnect or refreshConfiguration();
+  /// updateInformation2() only talks to the controller while this is false.
+  bool configurationValid_;
+
   void setDeviceState( State state );
 
   int driveAddress_;
@@ -0,0 +1,306 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <ctime>
+
+#include <QScriptProgram>
+#include <QDateTime>
+
+#include <nqlogger.h>
+
+#include "ScriptRuntime.h"
+
+static thread_local ScriptRuntime* currentRuntime = 0;
+
+ScriptRuntime::ScriptRuntime(QScriptEngine* engine)
+  : QScriptEngineAgent(engine),
+    aborted_(false),
+    scriptId_(-1),
+    line_(-1),
+    lineWaitTime_(0)
+{
+  engine->setAgent(this);
+}
+
+QScriptValue ScriptRuntime::evaluate(const QString& script, const QString& fileName)
+{
+  QScriptSyntaxCheckResult check = QScriptEngine::checkSyntax(script);
+  if (check.state()!=QScriptSyntaxCheckResult::Valid) {
+    NQLogWarning("ScriptRuntime") << QString("syntax error in line %1: %2")
+      .arg(check.errorLineNumber()).arg(check.errorMessage());
+    return QScriptValue();
+  }
+
+  QScriptProgram program(script, fileName);
+
+  fileName_ = fileName;
+  scriptId_ = -1;
+  lineTimings_.clear();
+  line_ = -1;
+  lineWaitTime_ = 0;
+  start_ = Clock::now();
+  periodDeadline_ = start_;
+
+  currentRuntime = this;
+  QScriptValue result = engine()->evaluate(program);
+  currentRuntime = 0;
+
+  closeLine(Clock::now());
+
+  if (engine()->hasUncaughtException()) {
+    NQLogWarning("ScriptRuntime") << QString("uncaught exception in line %1: %2")
+      .arg(engine()->uncaughtExceptionLineNumber()).arg(result.toString());
+  }
+
+  report();
+
+  return result;
+}
+
+void ScriptRuntime::abort()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    aborted_ = true;
+  }
+  condition_.notify_all();
+
+  engine()->abortEvaluation();
+}
+
+bool ScriptRuntime::wait(double seconds)
+{
+  return waitUntil(Clock::now() + ScriptRuntime::seconds(seconds));
+}
+
+bool ScriptRuntime::waitPeriod(double seconds)
+{
+  Clock::time_point now = Clock::now();
+
+  periodDeadline_ += ScriptRuntime::seconds(seconds);
+  if (periodDeadline_<now) {
+    double overrun = std::chrono::duration<double>(now - periodDeadline_).count();
+    NQLogWarning("ScriptRuntime") << QString("period of %1 s overrun by %2 s in line %3")
+      .arg(seconds).arg(overrun, 0, 'f', 1).arg(line_);
+    periodDeadline_ = now;
+  }
+
+  return waitUntil(periodDeadline_);
+}
+
+bool ScriptRuntime::waitUntil(uint utime)
+{
+  double delta = (double)utime - (double)std::time(0);
+
+  // later periods are scheduled relative to the requested time
+  periodDeadline_ = Clock::now() + seconds(std::max(delta, 0.0));
+
+  return waitUntil(periodDeadline_);
+}
+
+bool ScriptRuntime::waitFor(QScriptValue condition, double timeout, double interval)
+{
+  if (!condition.isFunction()) {
+    NQLogWarning("ScriptRuntime") << "waitFor: condition is not a function";
+    return false;
+  }
+
+  Clock::time_point deadline = Clock::now() + seconds(timeout);
+  Clock::time_point poll = Clock::now();
+
+  while (!aborted_) {
+    QScriptValue result = condition.call();
+    if (engine()->hasUncaughtException()) return false;
+    if (result.toBool()) return true;
+
+    if (Clock::now()>=deadline) return false;
+
+    poll += seconds(interval);
+    if (!waitUntil(std::min(poll, deadline))) return false;
+  }
+
+  return false;
+}
+
+ScriptRuntime* ScriptRuntime::current()
+{
+  return currentRuntime;
+}
+
+bool ScriptRuntime::sleep(double seconds)
+{
+  ScriptRuntime* runtime = current();
+  if (runtime) return runtime->wait(seconds);
+
+  std::this_thread::sleep_for(ScriptRuntime::seconds(seconds));
+
+  return true;
+}
+
+bool ScriptRuntime::waitLogged(double seconds, const QString& tag, const MessageFunction_t& message)
+{
+  static QString TIME_FORMAT = "yyyy-MM-dd hh:mm:ss";
+
+  QString text;
+  QDateTime dt = QDateTime::currentDateTime().addSecs(seconds);
+
+  text = QString("wait for %1 second(s)").arg(seconds);
+  message(text);
+  NQLog(tag) << text;
+
+  text = QString("estimated time of completion: %1 ...").arg(dt.toString(TIME_FORMAT));
+  message(text);
+  NQLog(tag) << text;
+
+  if (!sleep(seconds)) {
+    message("aborted");
+    NQLog(tag) << "aborted";
+    return false;
+  }
+
+  message("done");
+  NQLog(tag) << "done";
+
+  return true;
+}
+
+bool ScriptRuntime::waitPeriodLogged(double seconds, const QString& tag, const MessageFunction_t& message)
+{
+  ScriptRuntime* runtime = current();
+  if (!runtime) return waitLogged(seconds, tag, message);
+
+  if (!runtime->waitPeriod(seconds)) {
+    NQLog(tag) << "aborted";
+    return false;
+  }
+
+  return true;
+}
+
+bool ScriptRuntime::waitUntilLogged(uint utime, const QString& tag, const MessageFunction_t& message)
+{
+  static QString TIME_FORMAT = "yyyy-MM-dd hh:mm:ss";
+
+  QString text = QString("wait until %1 ...").arg(QDateTime::fromTime_t(utime).toString(TIME_FORMAT));
+  message(text);
+  NQLog(tag) << text;
+
+  ScriptRuntime* runtime = current();
+  bool completed;
+  if (runtime) {
+    completed = runtime->waitUntil(utime);
+  } else {
+    completed = sleep(std::max(0.0, (double)utime - (double)std::time(0)));
+  }
+
+  if (!completed) {
+    message("aborted");
+    NQLog(tag) << "aborted";
+    return false;
+  }
+
+  message("done");
+  NQLog(tag) << "done";
+
+  return true;
+}
+
+bool ScriptRuntime::waitForLogged(QScriptValue condition, double timeout, double interval, const QString& tag)
+{
+  ScriptRuntime* runtime = current();
+  if (!runtime) return false;
+
+  if (!runtime->waitFor(condition, timeout, interval)) {
+    if (runtime->isAborted()) NQLog(tag) << "aborted";
+    return false;
+  }
+
+  return true;
+}
+
+void ScriptRuntime::scriptLoad(qint64 id, const QString& /* program */,
+                               const QString& fileName, int /* baseLineNumber */)
+{
+  if (scriptId_==-1 && fileName==fileName_) scriptId_ = id;
+}
+
+void ScriptRuntime::positionChange(qint64 scriptId, int lineNumber, int /* columnNumber */)
+{
+  if (scriptId!=scriptId_) return;
+
+  Clock::time_point now = Clock::now();
+  closeLine(now);
+
+  line_ = lineNumber;
+  lineStart_ = now;
+}
+
+bool ScriptRuntime::waitUntil(const Clock::time_point& deadline)
+{
+  Clock::time_point start = Clock::now();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  condition_.wait_until(lock, deadline, [this]{ return aborted_.load(); });
+  lock.unlock();
+
+  lineWaitTime_ += std::chrono::duration<double>(Clock::now() - start).count();
+
+  return !aborted_;
+}
+
+void ScriptRuntime::closeLine(const Clock::time_point& now)
+{
+  if (line_<0) return;
+
+  LineTiming_t& timing = lineTimings_[line_];
+  timing.hits++;
+  timing.time += std::chrono::duration<double>(now - lineStart_).count();
+  timing.waitTime += lineWaitTime_;
+
+  line_ = -1;
+  lineWaitTime_ = 0;
+}
+
+void ScriptRuntime::report() const
+{
+  double total = std::chrono::duration<double>(Clock::now() - start_).count();
+
+  NQLog("ScriptRuntime", NQLog::Message) << QString("%1 finished after %2 s")
+    .arg(fileName_).arg(total, 0, 'f', 1);
+
+  std::vector<std::pair<int,LineTiming_t> > lines(lineTimings_.begin(), lineTimings_.end());
+  std::sort(lines.begin(), lines.end(),
+            [](const std::pair<int,LineTiming_t>& a, const std::pair<int,LineTiming_t>& b) {
+              return a.second.time > b.second.time;
+            });
+  if (lines.size()>10) lines.resize(10);
+
+  for (std::vector<std::pair<int,LineTiming_t> >::const_iterator it = lines.begin();
+       it!=lines.end();
+       ++it) {
+    NQLog("ScriptRuntime", NQLog::Message) << QString("line %1: %2 s in %3 pass(es), %4 s waiting, %5 s busy")
+      .arg(it->first, 4)
+      .arg(it->second.time, 0, 'f', 3)
+      .arg(it->second.hits)
+      .arg(it->second.waitTime, 0, 'f', 3)
+      .arg(it->second.time - it->second.waitTime, 0, 'f', 3);
+  }
+}
+
+ScriptRuntime::Clock::duration ScriptRuntime::seconds(double s)
+{
+  return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(s));
+}
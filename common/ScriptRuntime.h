@@ -0,0 +1,135 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SCRIPTRUNTIME_H
+#define SCRIPTRUNTIME_H
+
+#include <map>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+
+#include <QString>
+#include <QScriptEngine>
+#include <QScriptEngineAgent>
+#include <QScriptValue>
+
+/** @addtogroup common
+ *  @{
+ */
+
+/**
+  Runs a DAQ script in a QScriptEngine with deadline-based, interruptible
+  waits and per-statement timing.
+
+  The script is syntax checked and compiled once into a QScriptProgram
+  before it is evaluated. All waits sleep on a condition variable until
+  an absolute deadline, so that abort() ends them immediately. waitPeriod()
+  advances its deadline by the period instead of sleeping for it, so that
+  the time spent in device calls between two waits does not accumulate.
+
+  As engine agent the runtime measures the wall-clock time spent on each
+  line of the script, including the time spent waiting, and logs the most
+  expensive lines when the script ends.
+
+  The engine takes ownership of the runtime.
+ */
+class ScriptRuntime : public QScriptEngineAgent
+{
+public:
+
+  typedef std::chrono::steady_clock Clock;
+
+  typedef struct {
+    int hits;
+    double time;
+    double waitTime;
+  } LineTiming_t;
+
+  explicit ScriptRuntime(QScriptEngine* engine);
+
+  /// compiles and evaluates script in the calling thread
+  QScriptValue evaluate(const QString& script, const QString& fileName);
+
+  /// ends running waits and the script; may be called from any thread
+  void abort();
+  bool isAborted() const { return aborted_; }
+
+  /// waits for seconds; returns false if aborted
+  bool wait(double seconds);
+  /// waits until seconds after the end of the previous period; returns false if aborted
+  bool waitPeriod(double seconds);
+  /// waits until the unix time utime; returns false if aborted
+  bool waitUntil(uint utime);
+  /// calls condition every interval seconds until it returns true; returns false on timeout or abort
+  bool waitFor(QScriptValue condition, double timeout, double interval);
+
+  const std::map<int,LineTiming_t>& getLineTimings() const { return lineTimings_; }
+
+  /// runtime of the script evaluated by the calling thread, 0 outside of scripts
+  static ScriptRuntime* current();
+
+  /**
+    Sleeps for seconds, interruptible if called from a script; returns
+    false if the script was aborted. Meant for polling loops of scriptable
+    device objects.
+   */
+  static bool sleep(double seconds);
+
+  typedef std::function<void(const QString&)> MessageFunction_t;
+
+  /**
+    Waits of the scriptable globals objects of the DAQ applications. They
+    use the runtime of the calling thread, or plain sleeps outside of
+    scripts, and report their progress to message and to the log of
+    module tag. They return false if the script was aborted.
+   */
+  static bool waitLogged(double seconds, const QString& tag, const MessageFunction_t& message);
+  static bool waitPeriodLogged(double seconds, const QString& tag, const MessageFunction_t& message);
+  static bool waitUntilLogged(uint utime, const QString& tag, const MessageFunction_t& message);
+  /// false outside of scripts
+  static bool waitForLogged(QScriptValue condition, double timeout, double interval, const QString& tag);
+
+  void scriptLoad(qint64 id, const QString& program,
+                  const QString& fileName, int baseLineNumber);
+  void positionChange(qint64 scriptId, int lineNumber, int columnNumber);
+
+protected:
+
+  bool waitUntil(const Clock::time_point& deadline);
+
+  void closeLine(const Clock::time_point& now);
+  void report() const;
+
+  static Clock::duration seconds(double s);
+
+  std::atomic<bool> aborted_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+
+  QString fileName_;
+  qint64 scriptId_;
+  Clock::time_point start_;
+  Clock::time_point periodDeadline_;
+
+  int line_;
+  Clock::time_point lineStart_;
+  double lineWaitTime_;
+  std::map<int,LineTiming_t> lineTimings_;
+};
+
+/** @} */
+
+#endif // SCRIPTRUNTIME_H
@@ -4,6 +4,7 @@
 
 #include <QMutexLocker>
 
+#include "ScriptRuntime.h"
 #include "ScriptableArduinoPres.h"
 
 ScriptableArduinoPres::ScriptableArduinoPres(ArduinoPresModel* ArduinoPresModel,
@@ -34,7 +35,7 @@ void ScriptableArduinoPres::waitForPressureAAbove(float pressure,
     double temp = ArduinoPresModel_->getPressureA();
     locker.unlock();
     if (temp>pressure) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 }
 
@@ -46,7 +47,7 @@ void ScriptableArduinoPres::waitForPressureBAbove(float pressure,
     double temp = ArduinoPresModel_->getPressureB();
     locker.unlock();
     if (temp>pressure) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 }
 
@@ -58,7 +59,7 @@ void ScriptableArduinoPres::waitForPressureABelow(float pressure,
     double temp = ArduinoPresModel_->getPressureA();
     locker.unlock();
     if (temp<pressure) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 }
 
@@ -70,7 +71,7 @@ void ScriptableArduinoPres::waitForPressureBBelow(float pressure,
     double temp = ArduinoPresModel_->getPressureB();
     locker.unlock();
     if (temp<pressure) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 }
 
@@ -86,7 +87,7 @@ void ScriptableArduinoPres::waitForStablePressureA(float deltaP,
     if (fabs(oldTemp-temp)<=deltaP) count++;
     oldTemp = temp;
     if (count>=delay) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 }
 
@@ -102,6 +103,6 @@ void ScriptableArduinoPres::waitForStablePressureB(float deltaP,
     if (fabs(oldTemp-temp)<=deltaP) count++;
     oldTemp = temp;
     if (count>=delay) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 }
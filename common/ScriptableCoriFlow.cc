@@ -4,6 +4,7 @@
 
 #include <QMutexLocker>
 
+#include "ScriptRuntime.h"
 #include "ScriptableCoriFlow.h"
 
 ScriptableCoriFlow::ScriptableCoriFlow(CoriFlowModel* CoriFlowModel,
@@ -29,7 +30,7 @@ void ScriptableCoriFlow::waitForTempBelow(float /* temperature */,
     double temp = CoriFlowModel_->getTemp();
     locker.unlock();
     if (temp<temp) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 }
 
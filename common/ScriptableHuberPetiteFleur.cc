@@ -16,6 +16,7 @@
 
 #include <QMutexLocker>
 
+#include "ScriptRuntime.h"
 #include "ScriptableHuberPetiteFleur.h"
 
 ScriptableHuberPetiteFleur::ScriptableHuberPetiteFleur(HuberPetiteFleurModel* huberPetiteFleurModel,
@@ -70,7 +71,7 @@ void ScriptableHuberPetiteFleur::waitForTemperatureAbove(float temperature,
     double temp = huberPetiteFleurModel_->getBathTemperature();
     locker.unlock();
     if (temp>temperature) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 }
 
@@ -82,7 +83,7 @@ void ScriptableHuberPetiteFleur::waitForTemperatureBelow(float temperature,
     double temp = huberPetiteFleurModel_->getBathTemperature();
     locker.unlock();
     if (temp<temperature) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 }
 
@@ -98,7 +99,7 @@ void ScriptableHuberPetiteFleur::waitForStableTemperature(float deltaT,
     if (fabs(oldTemp-temp)<=deltaT) count++;
     oldTemp = temp;
     if (count>=delay) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 }
 
@@ -4,6 +4,7 @@
 
 #include <QMutexLocker>
 
+#include "ScriptRuntime.h"
 #include "ScriptableIota.h"
 
 ScriptableIota::ScriptableIota(IotaModel* IotaModel,
@@ -76,7 +77,7 @@ void ScriptableIota::waitForPressureAbove(float pressure,
     double temp = IotaModel_->getActPressure();
     locker.unlock();
     if (temp>pressure) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 }
 
@@ -88,7 +89,7 @@ void ScriptableIota::waitForFlowAbove(float flow,
     double temp = IotaModel_->getActFlow();
     locker.unlock();
     if (temp>flow) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 }
 
@@ -100,7 +101,7 @@ void ScriptableIota::waitForPressureBelow(float pressure,
     double temp = IotaModel_->getActPressure();
     locker.unlock();
     if (temp<pressure) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 }
 
@@ -112,7 +113,7 @@ void ScriptableIota::waitForFlowBelow(float flow,
     double temp = IotaModel_->getActFlow();
     locker.unlock();
     if (temp<flow) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 }
 
@@ -128,7 +129,7 @@ void ScriptableIota::waitForStablePressure(float deltaP,
     if (fabs(oldTemp-temp)<=deltaP) count++;
     oldTemp = temp;
     if (count>=delay) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 }
 
@@ -144,6 +145,6 @@ void ScriptableIota::waitForStableFlow(float deltaF,
     if (fabs(oldTemp-temp)<=deltaF) count++;
     oldTemp = temp;
     if (count>=delay) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 }
@@ -22,6 +22,7 @@
 #include "nqlogger.h"
 
 #include "Ringbuffer.h"
+#include "ScriptRuntime.h"
 #include "ScriptableKeithley.h"
 
 ScriptableKeithley::ScriptableKeithley(KeithleyModel* keithleyModel, QObject *parent) :
@@ -106,7 +107,7 @@ void ScriptableKeithley::waitForStableTemperature(const QString & channels,
     }
     if (stable) break;
 
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
     t += 60;
   }
 
@@ -126,7 +127,7 @@ void ScriptableKeithley::waitForTemperatureAbove(unsigned int channel,
     double temp = keithleyModel_->getTemperature(channel);
     locker.unlock();
     if (temp>temperature) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 
   keithleyModel_->statusMessage("done");
@@ -145,7 +146,7 @@ void ScriptableKeithley::waitForTemperatureBelow(unsigned int channel,
     double temp = keithleyModel_->getTemperature(channel);
     locker.unlock();
     if (temp<temperature) break;
-    sleep(60);
+    if (!ScriptRuntime::sleep(60)) break;
   }
 
   keithleyModel_->statusMessage("done");
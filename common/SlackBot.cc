@@ -10,14 +10,10 @@
 //                                                                             //
 /////////////////////////////////////////////////////////////////////////////////
 
-#include <iostream>
-#include <future>
-
-#include <curl/curl.h>
-
 #include <nqlogger.h>
 #include <ApplicationConfig.h>
 
+#include "BotNotifier.h"
 #include "SlackBot.h"
 
 SlackBot::SlackBot(QObject *parent)
@@ -50,56 +46,29 @@ SlackBot::~SlackBot()
 
 }
 
-int slackpost(std::string webhook, std::string data)
-{
-  curl_global_init(CURL_GLOBAL_ALL);
-
-  CURL *curl;
-  CURLcode res;
-
-  curl = curl_easy_init();
-  if (curl) {
-
-    curl_easy_setopt(curl, CURLOPT_URL, webhook.c_str());
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data.c_str());
-
-    res = curl_easy_perform(curl);
-
-    if (res!=CURLE_OK) {
-      NQLogWarning("SlackBot") << "SlackBot failed: " << curl_easy_strerror(res);
-    }
-
-    curl_easy_cleanup(curl);
-  }
-
-  curl_global_cleanup();
-
-  return true;
-}
-
 void SlackBot::postMessage(const QString& message)
 {
   QMutexLocker locker(&mutex_);
 
-  std::string data = "payload={\"channel\": \"";
+  std::string head = "payload={\"channel\": \"";
 
   if (channel_.isNull()) {
-    data += ApplicationConfig::instance()->getValue("slackchannel");
+    head += ApplicationConfig::instance()->getValue("slackchannel");
   } else {
-    data += channel_.toStdString();
+    head += channel_.toStdString();
   }
 
-  data += "\", \"username\": \"";
+  head += "\", \"username\": \"";
 
   if (username_.isNull()) {
-    data += ApplicationConfig::instance()->getValue("slackusername");
+    head += ApplicationConfig::instance()->getValue("slackusername");
   } else {
-    data += username_.toStdString();
+    head += username_.toStdString();
   }
 
-  data += "\", \"text\": \"";
-  data += message.toStdString();
-  data += "\", \"icon_emoji\": \":ghost:\"}";
+  head += "\", \"text\": \"";
+
+  std::string tail = "\", \"icon_emoji\": \":ghost:\"}";
 
   std::string webhook;
   if (webhook_.isNull()) {
@@ -108,9 +77,6 @@ void SlackBot::postMessage(const QString& message)
     webhook = webhook_.toStdString();
   }
 
-#ifndef DARWIN
-  auto handle = std::async(std::launch::async, slackpost, webhook, data);
-#else
-  slackpost(webhook, data);
-#endif
+  // posted from a background thread, bursts of messages are combined
+  BotNotifier::instance()->post(webhook, head, tail, message.toStdString());
 }
@@ -0,0 +1,31 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#include "nqimage.h"
+
+QImage NQImage::rotate90(const QImage& image)
+{
+  if (image.isNull()) return QImage();
+
+  if (image.depth()!=32) {
+    return rotate90(image.convertToFormat(QImage::Format_RGB32));
+  }
+
+  QImage rotated(image.height(), image.width(), image.format());
+
+  // 32 bit scan lines are never padded, so the rotated image is one contiguous block
+  QRgb* dst = reinterpret_cast<QRgb*>(rotated.bits());
+  forEachRotated90(image, [dst](int index, QRgb rgb) { dst[index] = rgb; });
+
+  return rotated;
+}
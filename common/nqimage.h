@@ -0,0 +1,74 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef NQIMAGE_H
+#define NQIMAGE_H
+
+#include <algorithm>
+
+#include <QImage>
+
+/** @addtogroup common
+ *  @{
+ */
+
+/**
+  Cache-blocked 90 degree rotation of 32 bit images. The source image is
+  walked in square tiles, so that reads and the strided writes of the
+  transposed pixels stay within a small working set, instead of running the
+  generic affine transform of QImage::transformed.
+  */
+class NQImage
+{
+public:
+
+  /// tile edge length in pixels; one tile of 32 bit pixels is 16 kB
+  static const int TileSize = 64;
+
+  /// same result as image.transformed(QMatrix().rotate(90))
+  static QImage rotate90(const QImage& image);
+
+  /**
+    Hands every pixel of the 32 bit image to op(index, rgb), where index is
+    the linear pixel index in the image rotated clockwise by 90 degrees,
+    i.e. an image of height() x width() pixels. This allows writing the
+    rotated pixels into a final buffer or an accumulator without an
+    intermediate image.
+    */
+  template <class Operation> static void forEachRotated90(const QImage& image, Operation op) {
+    const int width = image.width();
+    const int height = image.height();
+
+    for (int ty=0;ty<height;ty+=TileSize) {
+      const int yEnd = std::min(ty+TileSize, height);
+
+      for (int tx=0;tx<width;tx+=TileSize) {
+        const int xEnd = std::min(tx+TileSize, width);
+
+        for (int y=ty;y<yEnd;++y) {
+          const QRgb* src = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+
+          // source pixel (x, y) ends up at (height-1-y, x)
+          int index = tx*height + height-1-y;
+          for (int x=tx;x<xEnd;++x,index+=height) {
+            op(index, src[x]);
+          }
+        }
+      }
+    }
+  }
+};
+
+/** @} */
+
+#endif // NQIMAGE_H
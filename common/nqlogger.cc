@@ -19,6 +19,9 @@
  ****************************************************************************/
 
 #include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 
 #include <QDateTime>
 #include <QMutexLocker>
@@ -28,20 +31,73 @@
 NQLog::NQLog(const QString& module, LogLevel level)
 : module_(module),
   level_(level),
-  stream_(&buffer_)
+  stream_(0)
 {
-
+  // only messages that reach at least one destination are formatted
+  if (NQLogger::instance()->isEnabled(module_, level_)) {
+    stream_ = new QTextStream(&buffer_);
+  }
 }
 
 NQLog::~NQLog()
 {
-  NQLogger::instance()->write(module_, level_, buffer_);
+  if (stream_) {
+    delete stream_;
+    NQLogger::instance()->write(module_, level_, buffer_);
+  }
 }
 
+/**
+  Single-producer/single-consumer ring buffer. Each logging thread owns one
+  queue and is its only producer; the logger drains all queues while holding
+  its drain mutex, so there is exactly one consumer at any time.
+ */
+class NQLogQueue
+{
+public:
+
+  static const size_t Capacity = 4096;
+
+  NQLogQueue() : entries_(Capacity), head_(0), tail_(0) { }
+
+  bool push(NQLogEntry&& entry) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t next = (head + 1) % Capacity;
+    if (next==tail_.load(std::memory_order_acquire)) return false;
+    entries_[head] = std::move(entry);
+    head_.store(next, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(NQLogEntry& entry) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail==head_.load(std::memory_order_acquire)) return false;
+    entry = std::move(entries_[tail]);
+    tail_.store((tail + 1) % Capacity, std::memory_order_release);
+    return true;
+  }
+
+  bool empty() const {
+    return tail_.load(std::memory_order_acquire)==head_.load(std::memory_order_acquire);
+  }
+
+protected:
+
+  std::vector<NQLogEntry> entries_;
+  std::atomic<size_t> head_;
+  std::atomic<size_t> tail_;
+};
+
 NQLogger* NQLogger::instance_ = NULL;
 
 NQLogger::NQLogger(QObject *parent) :
-        QObject(parent)
+        QObject(parent),
+        minimumLevel_(NQLog::Fatal + 1),
+        matchAllModules_(false),
+        lastSecond_(-1),
+        asynchronous_(false),
+        sequence_(0),
+        writerRunning_(false)
 {
 
 }
@@ -50,37 +106,70 @@ NQLogger* NQLogger::instance(QObject *parent)
 {
   if (instance_==NULL) {
     instance_ = new NQLogger(parent);
+    std::atexit(NQLogger::shutdown);
   }
 
   return instance_;
 }
 
-void NQLogger::write(const QString& module, NQLog::LogLevel level, const QString& buffer)
+void NQLogger::shutdown()
 {
-  if (activeModules_.empty()) return;
+  if (instance_) instance_->setAsynchronous(false);
+}
 
-  bool filtered = true;
-  for (std::pair<QString,bool> v : activeModules_) {
-    if (v.second==false) {
-      if (module==v.first) {
-        filtered = false;
-        break;
-      }
-    } else {
-      if (v.first.length()==0 || module.startsWith(v.first)) {
-        filtered = false;
-        break;
-      }
-    }
+bool NQLogger::isEnabled(const QString& module, NQLog::LogLevel level)
+{
+  if (!isLevelEnabled(level)) return false;
+
+  return isModuleActive(module);
+}
+
+bool NQLogger::isModuleActive(const QString& module)
+{
+  if (matchAllModules_) return true;
+
+  {
+    QReadLocker locker(&moduleLock_);
+    QHash<QString,bool>::const_iterator it = moduleCache_.constFind(module);
+    if (it!=moduleCache_.constEnd()) return it.value();
   }
 
-  if (filtered) return;
+  QWriteLocker locker(&moduleLock_);
 
-  QString dateString = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
+  bool active = exactModules_.contains(module);
+  for (const QString& prefix : modulePrefixes_) {
+    if (active) break;
+    active = module.startsWith(prefix);
+  }
 
-  QString message = dateString;
+  moduleCache_.insert(module, active);
 
-  switch (level) {
+  return active;
+}
+
+void NQLogger::updateMinimumLevel()
+{
+  int level = NQLog::Fatal + 1;
+  for (std::pair<NQLog::LogLevel,QTextStream*> v : destinations_) {
+    level = std::min(level, static_cast<int>(v.first));
+  }
+  minimumLevel_.store(level, std::memory_order_relaxed);
+}
+
+QString NQLogger::format(const NQLogEntry& entry)
+{
+  // the date part only changes once per second
+  const qint64 second = entry.msecs / 1000;
+  if (second!=lastSecond_) {
+    lastSecond_ = second;
+    lastSecondString_ = QDateTime::fromMSecsSinceEpoch(second * 1000).toString("yyyy-MM-dd hh:mm:ss.");
+  }
+
+  QString message = lastSecondString_;
+  message.reserve(lastSecondString_.length() + entry.module.length() + entry.buffer.length() + 12);
+  message += QString("%1").arg(entry.msecs % 1000, 3, 10, QChar('0'));
+
+  switch (entry.level) {
   case NQLog::Debug: message += " D"; break;
   case NQLog::Spam: message += " S"; break;
   case NQLog::Message: message += " M"; break;
@@ -90,19 +179,159 @@ void NQLogger::write(const QString& module, NQLog::LogLevel level, const QString
   }
 
   message += " [";
-  message += module;
+  message += entry.module;
   message += "] ";
-  message += buffer;
+  message += entry.buffer;
   message += "\n";
 
-  for (std::pair<NQLog::LogLevel,QTextStream*> v : destinations_) {
-    if (level>=v.first) {
-      QTextStream* stream = v.second;
-      QMutexLocker locker(&mutex_);
-      stream->operator <<(message);
-      stream->flush();
+  return message;
+}
+
+void NQLogger::writeEntries(std::vector<NQLogEntry>& entries, bool flushStreams)
+{
+  if (entries.empty()) return;
+
+  QMutexLocker locker(&mutex_);
+
+  std::vector<bool> written(destinations_.size(), false);
+
+  for (const NQLogEntry& entry : entries) {
+    const QString message = format(entry);
+    for (size_t i=0;i<destinations_.size();++i) {
+      if (entry.level>=destinations_[i].first) {
+        destinations_[i].second->operator <<(message);
+        written[i] = true;
+      }
     }
   }
+
+  if (!flushStreams) return;
+
+  for (size_t i=0;i<destinations_.size();++i) {
+    if (written[i]) destinations_[i].second->flush();
+  }
+}
+
+void NQLogger::write(const QString& module, NQLog::LogLevel level, const QString& buffer)
+{
+  if (!isEnabled(module, level)) return;
+
+  NQLogEntry entry;
+  entry.sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+  entry.msecs = QDateTime::currentMSecsSinceEpoch();
+  entry.level = level;
+  entry.module = module;
+  entry.buffer = buffer;
+
+  if (asynchronous_.load(std::memory_order_acquire)) {
+    enqueue(std::move(entry));
+    if (level>=NQLog::Critical) flush();
+    return;
+  }
+
+  std::vector<NQLogEntry> entries;
+  entries.push_back(std::move(entry));
+  writeEntries(entries, true);
+}
+
+void NQLogger::enqueue(NQLogEntry&& entry)
+{
+  thread_local std::shared_ptr<NQLogQueue> queue;
+
+  if (!queue) {
+    queue = std::make_shared<NQLogQueue>();
+    std::lock_guard<std::mutex> lock(queuesMutex_);
+    queues_.push_back(queue);
+  }
+
+  // queue full: wake up the writer and wait for it to make room, or make
+  // room ourselves once the writer is stopped
+  while (!queue->push(std::move(entry))) {
+    if (!asynchronous_.load()) {
+      drainQueues();
+      continue;
+    }
+    writerCondition_.notify_one();
+    std::this_thread::yield();
+  }
+
+  // setAsynchronous(false) may have switched modes after write() checked
+  // asynchronous_ and done its final drain already; the fences pair with the
+  // one in setAsynchronous, so that either that drain sees the entry or the
+  // check below sees the switch
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!asynchronous_.load()) drainQueues();
+}
+
+void NQLogger::drainQueues()
+{
+  std::lock_guard<std::mutex> drainLock(drainMutex_);
+
+  std::vector<std::shared_ptr<NQLogQueue> > queues;
+  {
+    std::lock_guard<std::mutex> lock(queuesMutex_);
+    // queues of finished threads are dropped once they are empty
+    queues_.erase(std::remove_if(queues_.begin(), queues_.end(),
+                                 [](const std::shared_ptr<NQLogQueue>& q) {
+                                   return q.use_count()==1 && q->empty();
+                                 }),
+                  queues_.end());
+    queues = queues_;
+  }
+
+  std::vector<NQLogEntry> entries;
+  NQLogEntry entry;
+  for (std::shared_ptr<NQLogQueue>& queue : queues) {
+    while (queue->pop(entry)) entries.push_back(std::move(entry));
+  }
+
+  // restore the global order of messages from different threads
+  std::sort(entries.begin(), entries.end(),
+            [](const NQLogEntry& a, const NQLogEntry& b) { return a.sequence<b.sequence; });
+
+  writeEntries(entries, true);
+}
+
+void NQLogger::runWriter()
+{
+  std::unique_lock<std::mutex> lock(writerMutex_);
+
+  while (writerRunning_) {
+    writerCondition_.wait_for(lock, std::chrono::milliseconds(50));
+
+    lock.unlock();
+    drainQueues();
+    lock.lock();
+  }
+}
+
+void NQLogger::flush()
+{
+  drainQueues();
+}
+
+void NQLogger::setAsynchronous(bool asynchronous)
+{
+  if (asynchronous==asynchronous_.load()) return;
+
+  if (asynchronous) {
+    {
+      std::lock_guard<std::mutex> lock(writerMutex_);
+      writerRunning_ = true;
+    }
+    writerThread_ = std::thread(&NQLogger::runWriter, this);
+    asynchronous_.store(true, std::memory_order_release);
+  } else {
+    asynchronous_.store(false);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    {
+      std::lock_guard<std::mutex> lock(writerMutex_);
+      writerRunning_ = false;
+    }
+    writerCondition_.notify_one();
+    if (writerThread_.joinable()) writerThread_.join();
+    drainQueues();
+  }
 }
 
 void NQLogger::addActiveModule(const QString& module)
@@ -113,16 +342,38 @@ void NQLogger::addActiveModule(const QString& module)
     activeModules_.insert(std::pair<QString,bool>(temp,true));
   }
   activeModules_.insert(std::pair<QString,bool>(module,false));
+
+  // precompile the filter: exact names, prefixes and a catch-all flag
+  QWriteLocker locker(&moduleLock_);
+
+  exactModules_.clear();
+  modulePrefixes_.clear();
+  moduleCache_.clear();
+  bool matchAll = false;
+  for (std::pair<QString,bool> v : activeModules_) {
+    if (v.second==false) {
+      exactModules_.insert(v.first);
+    } else if (v.first.length()==0) {
+      matchAll = true;
+    } else {
+      modulePrefixes_.append(v.first);
+    }
+  }
+  matchAllModules_ = matchAll;
 }
 
 void NQLogger::addDestiniation(QIODevice * device, NQLog::LogLevel level)
 {
   QTextStream* stream = new QTextStream(device);
+  QMutexLocker locker(&mutex_);
   destinations_.push_back(std::pair<NQLog::LogLevel,QTextStream*>(level,stream));
+  updateMinimumLevel();
 }
 
 void NQLogger::addDestiniation(FILE * fileHandle, NQLog::LogLevel level)
 {
   QTextStream* stream = new QTextStream(fileHandle);
+  QMutexLocker locker(&mutex_);
   destinations_.push_back(std::pair<NQLog::LogLevel,QTextStream*>(level,stream));
+  updateMinimumLevel();
 }
@@ -24,11 +24,20 @@
 #include <vector>
 #include <set>
 #include <string>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 
 #include <QObject>
 #include <QIODevice>
 #include <QTextStream>
 #include <QMutex>
+#include <QReadWriteLock>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
 
 /** @addtogroup common
  *  @{
@@ -50,47 +59,50 @@ public:
     NQLog(const QString& module, LogLevel level = Message);
     ~NQLog();
 
-    inline NQLog &operator<<(QChar t) { stream_ << '\'' << t << '\''; return *this;}
-    inline NQLog &operator<<(char t) { stream_ << t; return *this; }
+    /// false if no destination accepts this message; nothing is formatted then
+    bool isEnabled() const { return stream_!=0; }
+
+    inline NQLog &operator<<(QChar t) { if (stream_) *stream_ << '\'' << t << '\''; return *this;}
+    inline NQLog &operator<<(char t) { if (stream_) *stream_ << t; return *this; }
 
 #if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
-    inline NQLog &operator<<(QBool t) { stream_ << (bool(t != 0) ? "true" : "false"); return *this; }
+    inline NQLog &operator<<(QBool t) { if (stream_) *stream_ << (bool(t != 0) ? "true" : "false"); return *this; }
 #endif
-    inline NQLog &operator<<(bool t) { stream_ << (t ? "true" : "false"); return *this; }
+    inline NQLog &operator<<(bool t) { if (stream_) *stream_ << (t ? "true" : "false"); return *this; }
 
-    inline NQLog &operator<<(signed short t) { stream_ << t; return *this; }
-    inline NQLog &operator<<(unsigned short t) { stream_ << t; return *this; }
+    inline NQLog &operator<<(signed short t) { if (stream_) *stream_ << t; return *this; }
+    inline NQLog &operator<<(unsigned short t) { if (stream_) *stream_ << t; return *this; }
 
-    inline NQLog &operator<<(signed int t) { stream_ << t; return *this; }
-    inline NQLog &operator<<(unsigned int t) { stream_ << t; return *this; }
+    inline NQLog &operator<<(signed int t) { if (stream_) *stream_ << t; return *this; }
+    inline NQLog &operator<<(unsigned int t) { if (stream_) *stream_ << t; return *this; }
 
-    inline NQLog &operator<<(signed long t) { stream_ << t; return *this; }
-    inline NQLog &operator<<(unsigned long t) { stream_ << t; return *this; }
+    inline NQLog &operator<<(signed long t) { if (stream_) *stream_ << t; return *this; }
+    inline NQLog &operator<<(unsigned long t) { if (stream_) *stream_ << t; return *this; }
 
-    inline NQLog &operator<<(qint64 t) { stream_ << QString::number(t); return *this; }
-    inline NQLog &operator<<(quint64 t) { stream_ << QString::number(t); return *this; }
+    inline NQLog &operator<<(qint64 t) { if (stream_) *stream_ << QString::number(t); return *this; }
+    inline NQLog &operator<<(quint64 t) { if (stream_) *stream_ << QString::number(t); return *this; }
 
-    inline NQLog &operator<<(float t) { stream_ << t; return *this; }
-    inline NQLog &operator<<(double t) { stream_ << t; return *this; }
+    inline NQLog &operator<<(float t) { if (stream_) *stream_ << t; return *this; }
+    inline NQLog &operator<<(double t) { if (stream_) *stream_ << t; return *this; }
 
-    inline NQLog &operator<<(const char* t) { stream_ << QString::fromLatin1(t); return *this; }
-    inline NQLog &operator<<(const std::string& t) { stream_ << QString::fromStdString(t); return *this; }
-    inline NQLog &operator<<(const QString& t) { stream_ << '\"' << t << '\"'; return *this; }
-    inline NQLog &operator<<(const QStringRef & t) { return operator<<(t.toString()); }
-    inline NQLog &operator<<(const QLatin1String &t) { stream_ << '\"'  << t.latin1() << '\"'; return *this; }
-    inline NQLog &operator<<(const QByteArray & t) { stream_  << '\"' << t << '\"'; return *this; }
+    inline NQLog &operator<<(const char* t) { if (stream_) *stream_ << QString::fromLatin1(t); return *this; }
+    inline NQLog &operator<<(const std::string& t) { if (stream_) *stream_ << QString::fromStdString(t); return *this; }
+    inline NQLog &operator<<(const QString& t) { if (stream_) *stream_ << '\"' << t << '\"'; return *this; }
+    inline NQLog &operator<<(const QStringRef & t) { if (stream_) operator<<(t.toString()); return *this; }
+    inline NQLog &operator<<(const QLatin1String &t) { if (stream_) *stream_ << '\"'  << t.latin1() << '\"'; return *this; }
+    inline NQLog &operator<<(const QByteArray & t) { if (stream_) *stream_ << '\"' << t << '\"'; return *this; }
 
-    inline NQLog &operator<<(const void * t) { stream_ << t; return *this; }
+    inline NQLog &operator<<(const void * t) { if (stream_) *stream_ << t; return *this; }
 
-    inline NQLog &operator<<(QTextStreamFunction f) { stream_ << f; return *this; }
-    inline NQLog &operator<<(QTextStreamManipulator m) { stream_ << m; return *this; }
+    inline NQLog &operator<<(QTextStreamFunction f) { if (stream_) *stream_ << f; return *this; }
+    inline NQLog &operator<<(QTextStreamManipulator m) { if (stream_) *stream_ << m; return *this; }
 
 protected:
 
     QString module_;
     LogLevel level_;
     QString buffer_;
-    QTextStream stream_;
+    QTextStream* stream_;
 };
 
 class NQLogDebug : public NQLog
@@ -135,6 +147,17 @@ public:
   ~NQLogFatal() {}
 };
 
+class NQLogQueue;
+
+struct NQLogEntry
+{
+    quint64 sequence;
+    qint64 msecs;
+    NQLog::LogLevel level;
+    QString module;
+    QString buffer;
+};
+
 class NQLogger : public QObject
 {
     Q_OBJECT
@@ -142,6 +165,12 @@ public:
 
     static NQLogger* instance(QObject *parent = 0);
 
+    /// cheap check whether any destination accepts messages of this level
+    bool isLevelEnabled(NQLog::LogLevel level) const {
+      return level>=minimumLevel_.load(std::memory_order_relaxed);
+    }
+    bool isEnabled(const QString& module, NQLog::LogLevel level);
+
     void write(const QString& module, NQLog::LogLevel level, const QString&buffer);
 
     void addActiveModule(const QString& module);
@@ -149,15 +178,59 @@ public:
     void addDestiniation(QIODevice * device, NQLog::LogLevel level = NQLog::Message);
     void addDestiniation(FILE * fileHandle, NQLog::LogLevel level = NQLog::Message);
 
+    /**
+      In asynchronous mode messages are put into a lock-free per-thread queue
+      and written by a background thread, which flushes the destinations once
+      per batch. Critical and Fatal messages are written before write() returns.
+     */
+    void setAsynchronous(bool asynchronous);
+    bool isAsynchronous() const { return asynchronous_; }
+
+    /// writes all queued messages
+    void flush();
+
 protected:
 
     explicit NQLogger(QObject *parent = 0);
     static NQLogger* instance_;
+    static void shutdown();
+
+    bool isModuleActive(const QString& module);
+    void updateMinimumLevel();
+
+    QString format(const NQLogEntry& entry);
+    void writeEntries(std::vector<NQLogEntry>& entries, bool flushStreams);
+    void enqueue(NQLogEntry&& entry);
+    void drainQueues();
+    void runWriter();
 
     QMutex mutex_;
 
     std::set<std::pair<QString,bool> > activeModules_;
     std::vector<std::pair<NQLog::LogLevel,QTextStream*> > destinations_;
+    std::atomic<int> minimumLevel_;
+
+    // precompiled module filter
+    std::atomic<bool> matchAllModules_;
+    QSet<QString> exactModules_;
+    QStringList modulePrefixes_;
+    QHash<QString,bool> moduleCache_;
+    QReadWriteLock moduleLock_;
+
+    // cached time stamp prefix (one per second)
+    qint64 lastSecond_;
+    QString lastSecondString_;
+
+    // asynchronous writer
+    std::atomic<bool> asynchronous_;
+    std::atomic<quint64> sequence_;
+    std::mutex queuesMutex_;
+    std::vector<std::shared_ptr<NQLogQueue> > queues_;
+    std::mutex drainMutex_;
+    std::mutex writerMutex_;
+    std::condition_variable writerCondition_;
+    bool writerRunning_;
+    std::thread writerThread_;
 };
 
 /** @} */
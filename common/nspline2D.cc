@@ -1,5 +1,7 @@
 #include <cmath>
 #include <algorithm>
+#include <chrono>
+#include <future>
 
 #include "nspline2D.h"
 
@@ -34,6 +36,17 @@ extern "C" {
                int *iwrk, int *kwrk,
                int *ier);
 
+  void bispev_(double *tx, int *nx,
+               double *ty, int *ny,
+               double *c,
+               int *kx, int *ky,
+               double *x, int *mx,
+               double *y, int *my,
+               double *z,
+               double *wrk, int *lwrk,
+               int *iwrk, int *kwrk,
+               int *ier);
+
   void bispeu_(double *tx, int *nx,
                double *ty, int *ny,
                double *c,
@@ -44,7 +57,62 @@ extern "C" {
                int *ier);
 }
 
+NSpline2DWorkspace::NSpline2DWorkspace()
+  : m_(0),
+    kx_(3),
+    ky_(3),
+    nxest_(0),
+    nyest_(0),
+    nmax_(0),
+    xb_(0), xe_(0), yb_(0), ye_(0),
+    lwrk1_(0),
+    lwrk2_(0),
+    kwrk_(0)
+{
+
+}
+
+void NSpline2DWorkspace::setup(const std::vector<double>& x,
+                               const std::vector<double>& y,
+                               const std::vector<double>& w,
+                               int kx, int ky,
+                               double nxy)
+{
+  m_ = x.size();
+  kx_ = kx;
+  ky_ = ky;
+
+  nxest_ = std::max(nxy*(kx+1+std::ceil(std::sqrt(m_/2))), 2.0*(kx+1));
+  nyest_ = std::max(nxy*(ky+1+std::ceil(std::sqrt(m_/2))), 2.0*(ky+1));
+  nmax_ = std::max(nxest_, nyest_);
+
+  x_.assign(x.begin(), x.end());
+  y_.assign(y.begin(), y.end());
+  w_.assign(w.begin(), w.end());
+  z_.resize(m_);
+
+  if (m_>0) {
+    xb_ = *std::min_element(x_.begin(), x_.end());
+    xe_ = *std::max_element(x_.begin(), x_.end());
+    yb_ = *std::min_element(y_.begin(), y_.end());
+    ye_ = *std::max_element(y_.begin(), y_.end());
+  }
+
+  // sizes as documented in surfit.f, x and y are swapped for FITPACK
+  lwrk1_ = NSpline2D::calcSurfitLwrk1(m_, ky, kx, nyest_, nxest_);
+  lwrk2_ = NSpline2D::calcSurfitLwrk2(ky, kx, nyest_, nxest_);
+  kwrk_ = m_ + (nxest_ - 2*kx - 1) * (nyest_ - 2*ky - 1);
+
+  wrk1_.resize(lwrk1_);
+  wrk2_.resize(lwrk2_);
+  iwrk_.resize(kwrk_);
+}
+
 NSpline2D::NSpline2D()
+  : kx_(3),
+    ky_(3),
+    fp_(0),
+    fitTime_(0)
 {
 
 }
@@ -56,87 +124,56 @@ int NSpline2D::surfit(const std::vector<double>& x,
                       int kx, int ky, double s,
                       double nxy)
 {
-  if (x.size()!=w.size()) {
-
-  }
+  NSpline2DWorkspace workspace;
+  workspace.setup(x, y, w, kx, ky, nxy);
 
-  int m = x.size();
+  return surfit(workspace, z, s);
+}
 
-  int nxest = std::max(nxy*(kx+1+std::ceil(std::sqrt(m/2))), 2.0*(kx+1));
-  int nyest = std::max(nxy*(ky+1+std::ceil(std::sqrt(m/2))), 2.0*(ky+1));
-  int nmax = std::max(nxest, nyest);
+int NSpline2D::surfit(NSpline2DWorkspace& ws,
+                      const std::vector<double>& z,
+                      double s)
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
+  int m = ws.m_;
+  int kx = ws.kx_;
+  int ky = ws.ky_;
   double eps = 1.0e-16;
 
-  double xb = x[0];
-  double xe = xb;
-  double yb = y[0];
-  double ye = yb;
-
-  std::vector<double> rx(x.begin(), x.end());
-  std::vector<double> ry(y.begin(), y.end());
-  std::vector<double> rz(z.begin(), z.end());
-  std::vector<double> rw(w.begin(), w.end());
-
-  for (double xv : rx) {
-    xb = std::min(xb, xv);
-    xe = std::max(xe, xv);
-  }
-  for (double yv : ry) {
-    yb = std::min(yb, yv);
-    ye = std::max(ye, yv);
-  }
+  // surfit_ takes non-const arrays
+  ws.z_.assign(z.begin(), z.end());
 
   int nx;
-  tx_.resize(nxest);
+  tx_.resize(ws.nxest_);
   int ny;
-  ty_.resize(nyest);
-  c_.resize((nxest-kx-1) * (nyest-ky-1));
+  ty_.resize(ws.nyest_);
+  c_.resize((ws.nxest_-kx-1) * (ws.nyest_-ky-1));
   double fp;
   int ier;
 
-  int lwrk1 = calcSurfitLwrk1(m, ky, kx, nyest, nxest);
-  int lwrk2 = 1;
-  int kwrk = m + (nxest - 2*kx - 1) * (nyest - 2*ky - 1);
-
-  std::vector<double> wrk1(lwrk1);
-  std::vector<double> wrk2(lwrk2);
-  std::vector<int> iwrk(kwrk);
-
   int iopt = 0;
 
-  surfit_(&iopt, &m,
-          ry.data(), rx.data(), rz.data(), rw.data(),
-          &yb, &ye,
-          &xb, &xe,
-          &ky, &kx, &s,
-          &nyest, &nxest, &nmax,
-          &eps,
-          &ny, ty_.data(),
-          &nx, tx_.data(),
-          c_.data(), &fp,
-          wrk1.data(), &lwrk1,
-          wrk2.data(), &lwrk2,
-          iwrk.data(), &kwrk,
-          &ier);
-
-  while (ier>10) {
-    lwrk2 = ier;
-    wrk2.resize(lwrk2);
+  while (true) {
     surfit_(&iopt, &m,
-            ry.data(), rx.data(), rz.data(), rw.data(),
-            &yb, &ye,
-            &xb, &xe,
+            ws.y_.data(), ws.x_.data(), ws.z_.data(), ws.w_.data(),
+            &ws.yb_, &ws.ye_,
+            &ws.xb_, &ws.xe_,
             &ky, &kx, &s,
-            &nyest, &nxest, &nmax,
+            &ws.nyest_, &ws.nxest_, &ws.nmax_,
             &eps,
             &ny, ty_.data(),
             &nx, tx_.data(),
             c_.data(), &fp,
-            wrk1.data(), &lwrk1,
-            wrk2.data(), &lwrk2,
-            iwrk.data(), &kwrk,
+            ws.wrk1_.data(), &ws.lwrk1_,
+            ws.wrk2_.data(), &ws.lwrk2_,
+            ws.iwrk_.data(), &ws.kwrk_,
             &ier);
+
+    // wrk2 is sized to the documented upper bound, this should not happen
+    if (ier<=10) break;
+    ws.lwrk2_ = ier;
+    ws.wrk2_.resize(ws.lwrk2_);
   }
 
   if (ier == 0 || ier == -1 || ier == -2) {
@@ -164,6 +201,41 @@ int NSpline2D::surfit(const std::vector<double>& x,
   ky_ = ky;
   fp_ = fp;
 
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  fitTime_ = elapsed.count();
+
+  return ier;
+}
+
+std::vector<int> NSpline2D::surfit(const std::vector<NSpline2D*>& splines,
+                                   const std::vector<double>& x,
+                                   const std::vector<double>& y,
+                                   const std::vector<const std::vector<double>*>& z,
+                                   int kx, int ky, double s,
+                                   double nxy)
+{
+  size_t n = std::min(splines.size(), z.size());
+  std::vector<int> ier(n, 0);
+  if (n==0) return ier;
+
+  // the workspace only depends on x, y and the degrees: set it up once and
+  // hand out copies, FITPACK needs separate work arrays per concurrent fit
+  std::vector<double> w(x.size(), 1.0);
+  std::vector<NSpline2DWorkspace> workspaces(1);
+  workspaces[0].setup(x, y, w, kx, ky, nxy);
+  workspaces.resize(n, workspaces[0]);
+
+  std::vector<std::future<int> > fits;
+  for (size_t i=1;i<n;++i) {
+    fits.push_back(std::async(std::launch::async,
+                              [&splines, &workspaces, &z, s, i]() {
+      return splines[i]->surfit(workspaces[i], *z[i], s);
+    }));
+  }
+
+  ier[0] = splines[0]->surfit(workspaces[0], *z[0], s);
+  for (size_t i=1;i<n;++i) ier[i] = fits[i-1].get();
+
   return ier;
 }
 
@@ -308,6 +380,51 @@ bool NSpline2D::evaluate(const std::vector<double>& x,
   return true;
 }
 
+/**
+  Tensor product evaluation with bispev: the B-spline basis is computed once
+  per grid column and row instead of once per point as with bispeu.
+  */
+bool NSpline2D::evaluateGrid(const std::vector<double>& x,
+                             const std::vector<double>& y,
+                             std::vector<double>& z) const
+{
+  int mx = x.size();
+  int my = y.size();
+
+  z.resize(mx*my);
+  if (mx==0 || my==0) return true;
+
+  // the spline is stored with x and y swapped, see surfit()
+  std::vector<double> rx(x.begin(), x.end());
+  std::vector<double> ry(y.begin(), y.end());
+  std::vector<double> tx(tx_);
+  std::vector<double> ty(ty_);
+  std::vector<double> c(c_);
+  int kx = kx_;
+  int ky = ky_;
+  int nx = tx.size();
+  int ny = ty.size();
+
+  int ier;
+  int lwrk = my*(ky+1) + mx*(kx+1);
+  std::vector<double> wrk(lwrk);
+  int kwrk = mx + my;
+  std::vector<int> iwrk(kwrk);
+
+  bispev_(ty.data(), &ny,
+          tx.data(), &nx,
+          c.data(),
+          &ky, &kx,
+          ry.data(), &my,
+          rx.data(), &mx,
+          z.data(),
+          wrk.data(), &lwrk,
+          iwrk.data(), &kwrk,
+          &ier);
+
+  return ier==0;
+}
+
 int NSpline2D::calcSurfitLwrk1(int m,
                                int ky, int kx,
                                int nyest, int nxest)
@@ -335,3 +452,23 @@ int NSpline2D::calcSurfitLwrk1(int m,
   return u*v*(2 + b1 + b2) + 2*(u+v+km*(m+ne)+ne-kx-ky) + b2 + 1;
 }
 
+int NSpline2D::calcSurfitLwrk2(int ky, int kx,
+                               int nyest, int nxest)
+{
+  int u = nxest - kx - 1;
+  int v = nyest - ky - 1;
+
+  int bx = kx*v + ky + 1;
+  int by = ky*u + kx + 1;
+
+  int b2 = 0;
+
+  if (bx<=by) {
+    b2 = bx + v - ky;
+  } else {
+    b2 = by + u - kx;
+  }
+
+  return u*v*(b2 + 1) + b2;
+}
+
@@ -7,6 +7,54 @@
  *  @{
  */
 
+class NSpline2D;
+
+/**
+  Work arrays for NSpline2D::surfit. A workspace is set up once for a given
+  set of data points, weights and spline degrees and can then be reused for
+  fits of several z columns without any further allocation. A workspace must
+  not be used by more than one fit at a time.
+ */
+class NSpline2DWorkspace
+{
+
+ public:
+
+  NSpline2DWorkspace();
+
+  void setup(const std::vector<double>& x,
+             const std::vector<double>& y,
+             const std::vector<double>& w,
+             int kx = 3, int ky = 3,
+             double nxy = 1.0);
+
+  int size() const { return m_; }
+
+ protected:
+
+  friend class NSpline2D;
+
+  int m_;
+  int kx_;
+  int ky_;
+  int nxest_;
+  int nyest_;
+  int nmax_;
+  double xb_, xe_, yb_, ye_;
+
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<double> z_;
+  std::vector<double> w_;
+
+  int lwrk1_;
+  int lwrk2_;
+  int kwrk_;
+  std::vector<double> wrk1_;
+  std::vector<double> wrk2_;
+  std::vector<int> iwrk_;
+};
+
 class NSpline2D
 {
 
@@ -27,6 +75,25 @@ class NSpline2D
              int kx = 3, int ky = 3, double s = 0,
              double nxy = 1.0);
 
+  /// fits z over the data points the workspace was set up for
+  int surfit(NSpline2DWorkspace& workspace,
+             const std::vector<double>& z,
+             double s = 0);
+
+  /// fits each z column over the same x/y into the corresponding spline,
+  /// concurrently; returns the FITPACK error codes
+  static std::vector<int> surfit(const std::vector<NSpline2D*>& splines,
+                                 const std::vector<double>& x,
+                                 const std::vector<double>& y,
+                                 const std::vector<const std::vector<double>*>& z,
+                                 int kx = 3, int ky = 3, double s = 0,
+                                 double nxy = 1.0);
+
+  /// weighted sum of squared residuals of the last fit
+  double getFp() const { return fp_; }
+  /// wall clock time of the last surfit call in seconds
+  double getFitTime() const { return fitTime_; }
+
   void regrid(const std::vector<double>& x,
               const std::vector<double>& y,
               const std::vector<double>& z,
@@ -38,11 +105,21 @@ class NSpline2D
                 const std::vector<double>& y,
                 std::vector<double>& z);
 
+  /// evaluates on the grid x (ascending) times y (ascending);
+  /// z[iy*x.size()+ix] is the value at (x[ix], y[iy])
+  bool evaluateGrid(const std::vector<double>& x,
+                    const std::vector<double>& y,
+                    std::vector<double>& z) const;
+
  protected:
 
-  int calcSurfitLwrk1(int m,
-                      int ky, int kx,
-                      int nyest, int nxest);
+  friend class NSpline2DWorkspace;
+
+  static int calcSurfitLwrk1(int m,
+                             int ky, int kx,
+                             int nyest, int nxest);
+  static int calcSurfitLwrk2(int ky, int kx,
+                             int nyest, int nxest);
 
   std::vector<double> tx_;
   std::vector<double> ty_;
@@ -50,6 +127,7 @@ class NSpline2D
   int kx_;
   int ky_;
   double fp_;
+  double fitTime_;
 };
 
 /** @} */
@@ -0,0 +1,278 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cmath>
+#include <random>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+
+#include <QTransform>
+
+#include "DefoSyntheticImage.h"
+
+DefoSyntheticImage::Parameters_t DefoSyntheticImage::defaultParameters()
+{
+  Parameters_t p;
+  p.width = 2000;
+  p.height = 3000;
+  p.nx = 40;
+  p.ny = 60;
+  p.pitch = 0;
+  p.rotation = 0.5;
+  p.dotRadius = 5;
+  p.blur = 1.0;
+  p.noise = 3.0;
+  p.background = 10;
+  p.shape = Bow;
+  p.amplitude = 4.0;
+  p.missing = 0.0;
+  p.spurious = 0;
+  p.seed = 1;
+  return p;
+}
+
+DefoSyntheticImage::Shape DefoSyntheticImage::shapeFromString(const std::string& name, bool& ok)
+{
+  ok = true;
+  if (name=="bow") return Bow;
+  if (name=="saddle") return Saddle;
+  if (name=="wave") return Wave;
+  ok = false;
+  return Bow;
+}
+
+const QColor& DefoSyntheticImage::dotColor()
+{
+  static const QColor color(255, 220, 40);
+  return color;
+}
+
+const QColor& DefoSyntheticImage::seedColor()
+{
+  static const QColor color(40, 110, 255);
+  return color;
+}
+
+DefoSyntheticImage::DefoSyntheticImage(const Parameters_t& parameters)
+  : parameters_(parameters)
+{
+  generate();
+}
+
+void DefoSyntheticImage::height(double u, double v,
+                                double& h, double& dhdu, double& dhdv) const
+{
+  switch (parameters_.shape) {
+  case Saddle:
+    h = 0.5 * (u*u - v*v);
+    dhdu = u;
+    dhdv = -v;
+    break;
+  case Wave:
+    h = std::sin(M_PI*u) * std::sin(M_PI*v) / (M_PI*M_PI);
+    dhdu = std::cos(M_PI*u) * std::sin(M_PI*v) / M_PI;
+    dhdv = std::sin(M_PI*u) * std::cos(M_PI*v) / M_PI;
+    break;
+  default:
+    h = 0.5 * (u*u + v*v);
+    dhdu = u;
+    dhdv = v;
+  }
+}
+
+void DefoSyntheticImage::generate()
+{
+  const Parameters_t& p = parameters_;
+
+  pitch_ = p.pitch;
+  if (pitch_<=0) {
+    pitch_ = std::min(0.8 * p.width / std::max(p.nx-1, 1),
+                      0.8 * p.height / std::max(p.ny-1, 1));
+  }
+
+  const double cx = 0.5 * (p.width - 1);
+  const double cy = 0.5 * (p.height - 1);
+  const double hx = std::max(0.5 * pitch_ * (p.nx - 1), 1.0);
+  const double hy = std::max(0.5 * pitch_ * (p.ny - 1), 1.0);
+  const double ca = std::cos(p.rotation * M_PI / 180.);
+  const double sa = std::sin(p.rotation * M_PI / 180.);
+
+  std::mt19937 random(p.seed);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+
+  dots_.clear();
+  dots_.reserve(p.nx * p.ny);
+
+  double maxGradient = 0;
+
+  for (int j=0;j<p.ny;++j) {
+    for (int i=0;i<p.nx;++i) {
+
+      const double gx = (i - 0.5 * (p.nx - 1)) * pitch_;
+      const double gy = (j - 0.5 * (p.ny - 1)) * pitch_;
+
+      double h, dhdu, dhdv;
+      height(gx / hx, gy / hy, h, dhdu, dhdv);
+
+      // gradient per pixel, rotated with the grid
+      const double gradX = dhdu / hx;
+      const double gradY = dhdv / hy;
+
+      Dot_t dot;
+      dot.i = i;
+      dot.j = j;
+      dot.x = cx + ca * gx - sa * gy;
+      dot.y = cy + sa * gx + ca * gy;
+      dot.dx = ca * gradX - sa * gradY;
+      dot.dy = sa * gradX + ca * gradY;
+      dot.height = h;
+      dot.blue = (i==getSeedI() && j==getSeedJ());
+      dot.inReference = dot.blue || uniform(random)>=p.missing;
+      dot.inDeformed = dot.blue || uniform(random)>=p.missing;
+
+      maxGradient = std::max(maxGradient, std::hypot(dot.dx, dot.dy));
+
+      dots_.push_back(dot);
+    }
+  }
+
+  // scale the height field such that the largest displacement is the amplitude
+  const double scale = maxGradient>0 ? p.amplitude / maxGradient : 0;
+  for (std::vector<Dot_t>::iterator it = dots_.begin();it!=dots_.end();++it) {
+    it->dx *= scale;
+    it->dy *= scale;
+    it->height *= scale;
+  }
+
+  // spurious dots anywhere within the grid area plus one pitch
+  for (int image=0;image<2;++image) {
+    std::vector<Dot_t>& spurious = image ? spuriousDeformed_ : spuriousReference_;
+    spurious.clear();
+
+    for (int n=0;n<p.spurious;++n) {
+      const double gx = (2. * uniform(random) - 1.) * (hx + pitch_);
+      const double gy = (2. * uniform(random) - 1.) * (hy + pitch_);
+
+      Dot_t dot;
+      dot.i = -1;
+      dot.j = -1;
+      dot.x = cx + ca * gx - sa * gy;
+      dot.y = cy + sa * gx + ca * gy;
+      dot.dx = 0;
+      dot.dy = 0;
+      dot.height = 0;
+      dot.blue = false;
+      dot.inReference = (image==0);
+      dot.inDeformed = (image==1);
+
+      spurious.push_back(dot);
+    }
+  }
+}
+
+QImage DefoSyntheticImage::render(bool deformed) const
+{
+  const Parameters_t& p = parameters_;
+  const int width = p.width;
+  const int height = p.height;
+
+  std::vector<float> buffer(3 * width * height, p.background);
+
+  const double extent = p.dotRadius + 3 * p.blur + 1;
+  const double edge = std::sqrt(2.) * p.blur;
+
+  auto addDot = [&](double x, double y, const QColor& color, double intensity) {
+    const int x0 = std::max(0, (int)std::floor(x - extent));
+    const int x1 = std::min(width - 1, (int)std::ceil(x + extent));
+    const int y0 = std::max(0, (int)std::floor(y - extent));
+    const int y1 = std::min(height - 1, (int)std::ceil(y + extent));
+
+    const float r = intensity * color.red();
+    const float g = intensity * color.green();
+    const float b = intensity * color.blue();
+
+    for (int py=y0;py<=y1;++py) {
+      float* line = &buffer[3 * py * width];
+      for (int px=x0;px<=x1;++px) {
+        const double d = std::hypot(px - x, py - y) - p.dotRadius;
+        // disc with a gaussian blurred edge
+        const float a = edge>0 ? 0.5 * std::erfc(d / edge) : (d<=0 ? 1.f : 0.f);
+        line[3*px+0] += a * r;
+        line[3*px+1] += a * g;
+        line[3*px+2] += a * b;
+      }
+    }
+  };
+
+  for (std::vector<Dot_t>::const_iterator it = dots_.begin();it!=dots_.end();++it) {
+    if (deformed ? !it->inDeformed : !it->inReference) continue;
+    addDot(deformed ? it->x + it->dx : it->x,
+           deformed ? it->y + it->dy : it->y,
+           it->blue ? seedColor() : dotColor(), 1.0);
+  }
+
+  const std::vector<Dot_t>& spurious = getSpurious(deformed);
+  for (std::vector<Dot_t>::const_iterator it = spurious.begin();it!=spurious.end();++it) {
+    addDot(it->x, it->y, dotColor(), 0.8);
+  }
+
+  QImage image(width, height, QImage::Format_RGB32);
+
+  std::mt19937 random(2 * p.seed + (deformed ? 1 : 0));
+  std::normal_distribution<float> noise(0.f, std::max(p.noise, 1e-6));
+
+  for (int py=0;py<height;++py) {
+    QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(py));
+    const float* values = &buffer[3 * py * width];
+    for (int px=0;px<width;++px) {
+      int rgb[3];
+      for (int c=0;c<3;++c) {
+        float v = values[3*px+c];
+        if (p.noise>0) v += noise(random);
+        rgb[c] = std::min(255, std::max(0, (int)std::lround(v)));
+      }
+      line[px] = qRgb(rgb[0], rgb[1], rgb[2]);
+    }
+  }
+
+  return image;
+}
+
+QImage DefoSyntheticImage::cameraImage(const QImage& image)
+{
+  // DefoMeasurement rotates camera images clockwise by 90 degrees
+  return image.transformed(QTransform().rotate(-90));
+}
+
+bool DefoSyntheticImage::writeTruth(const std::string& filename) const
+{
+  std::ofstream ofile(filename.c_str());
+  if (!ofile.is_open()) return false;
+
+  ofile << "# pitch " << pitch_ << " seed " << getSeedI() << " " << getSeedJ() << std::endl;
+  ofile << "# i j blue mask x y dx dy height" << std::endl;
+  ofile << std::setprecision(8);
+
+  for (int image=0;image<3;++image) {
+    const std::vector<Dot_t>& dots = image==0 ? dots_ : getSpurious(image==2);
+    for (std::vector<Dot_t>::const_iterator it = dots.begin();it!=dots.end();++it) {
+      const int mask = (it->inReference ? 1 : 0) | (it->inDeformed ? 2 : 0);
+      ofile << it->i << " " << it->j << " " << (it->blue ? 1 : 0) << " " << mask << " "
+            << it->x << " " << it->y << " " << it->dx << " " << it->dy << " "
+            << it->height << std::endl;
+    }
+  }
+
+  return true;
+}
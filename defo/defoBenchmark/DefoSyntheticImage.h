@@ -0,0 +1,108 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef DEFOSYNTHETICIMAGE_H
+#define DEFOSYNTHETICIMAGE_H
+
+#include <vector>
+#include <string>
+
+#include <QImage>
+#include <QColor>
+
+/**
+  Generates synthetic reflections of the dot grid with a known surface
+  deformation. The grid of nx x ny dots, one of which is the blue seed, is
+  placed in the center of the image (in the orientation of
+  DefoMeasurement::getImage(), i.e. after the 90 degree rotation of the
+  camera image). The deformed image displaces each dot by the gradient of
+  a known height field, scaled such that the largest displacement equals
+  the amplitude. The reconstructed surface is therefore proportional to
+  the height field up to offset and tilt.
+  */
+class DefoSyntheticImage
+{
+public:
+
+  enum Shape {
+    Bow,    ///< (u^2 + v^2) / 2
+    Saddle, ///< (u^2 - v^2) / 2
+    Wave    ///< sin(pi u) sin(pi v) / pi^2
+  };
+
+  typedef struct {
+    int width;          ///< image width [px]
+    int height;         ///< image height [px]
+    int nx;             ///< dots along x
+    int ny;             ///< dots along y
+    double pitch;       ///< dot pitch [px]; 0 fills 80% of the image
+    double rotation;    ///< rotation of the grid [deg]
+    double dotRadius;   ///< dot radius [px]
+    double blur;        ///< width of the blurred dot edge [px]
+    double noise;       ///< gaussian noise per channel [gray values]
+    int background;     ///< background level [gray values]
+    Shape shape;
+    double amplitude;   ///< largest dot displacement [px]
+    double missing;     ///< fraction of dots missing in each image
+    int spurious;       ///< additional random dots in each image
+    unsigned int seed;  ///< random seed
+  } Parameters_t;
+
+  typedef struct {
+    int i, j;           ///< grid position
+    double x, y;        ///< position in the reference image [px]
+    double dx, dy;      ///< displacement in the deformed image [px]
+    double height;      ///< height field at the dot [px^2]
+    bool blue;
+    bool inReference;   ///< not missing in the reference image
+    bool inDeformed;    ///< not missing in the deformed image
+  } Dot_t;
+
+  static Parameters_t defaultParameters();
+  static Shape shapeFromString(const std::string& name, bool& ok);
+  static const QColor& dotColor();
+  static const QColor& seedColor();
+
+  explicit DefoSyntheticImage(const Parameters_t& parameters);
+
+  const Parameters_t& getParameters() const { return parameters_; }
+  const std::vector<Dot_t>& getDots() const { return dots_; }
+  const std::vector<Dot_t>& getSpurious(bool deformed) const {
+    return deformed ? spuriousDeformed_ : spuriousReference_;
+  }
+  int getSeedI() const { return parameters_.nx/2; }
+  int getSeedJ() const { return parameters_.ny/2; }
+  double getPitch() const { return pitch_; }
+
+  /// image in the orientation of DefoMeasurement::getImage()
+  QImage render(bool deformed) const;
+
+  /// image as delivered by the camera, i.e. rotated by -90 degrees
+  static QImage cameraImage(const QImage& image);
+
+  /// writes i, j, blue, x, y, dx, dy, height of all dots
+  bool writeTruth(const std::string& filename) const;
+
+protected:
+
+  void generate();
+  void height(double u, double v, double& h, double& dhdu, double& dhdv) const;
+
+  Parameters_t parameters_;
+  double pitch_;
+  std::vector<Dot_t> dots_;
+  std::vector<Dot_t> spuriousReference_;
+  std::vector<Dot_t> spuriousDeformed_;
+};
+
+#endif // DEFOSYNTHETICIMAGE_H
@@ -0,0 +1,605 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QDir>
+
+#include <ApplicationConfig.h>
+
+#include <DefoMeasurement.h>
+#include <DefoMeasurementListModel.h>
+#include <DefoPointRecognitionModel.h>
+#include <DefoPointFinder.h>
+#include <DefoPointIndexerModel.h>
+#include <DefoRecoSurface.h>
+#include <DefoSurface.h>
+#include <Defo2DSplineInterpolationModel.h>
+
+#include "DefoSyntheticImage.h"
+
+typedef struct {
+  std::string mode;
+  std::string output;
+  std::string cfgFile;
+  int repeat;
+  int blocks;
+  std::string indexer;
+  double focalLength;
+  int thresholds[3];
+  int halfSquareWidth;
+  double maxShapeError;
+  double minIndexed;
+  DefoSyntheticImage::Parameters_t image;
+} Options_t;
+
+static void usage()
+{
+  std::cout << "usage: defoBenchmark [generate <directory>] [options]" << std::endl
+            << std::endl
+            << "Renders a synthetic reference and deformed image of the dot grid." << std::endl
+            << "generate writes them, as delivered by the camera, together with" << std::endl
+            << "the true dot positions to the directory. Otherwise the reconstruction" << std::endl
+            << "chain is run on them and each stage is timed and checked against the" << std::endl
+            << "truth." << std::endl
+            << std::endl
+            << "image options:" << std::endl
+            << "  --width <px> --height <px>     image size (2000 x 3000)" << std::endl
+            << "  --nx <n> --ny <n>              number of dots (40 x 60)" << std::endl
+            << "  --pitch <px>                   dot pitch (fills 80% of the image)" << std::endl
+            << "  --rotation <deg>               rotation of the grid (0.5)" << std::endl
+            << "  --radius <px>                  dot radius (5)" << std::endl
+            << "  --blur <px>                    width of the dot edge (1)" << std::endl
+            << "  --noise <gray>                 gaussian noise (3)" << std::endl
+            << "  --background <gray>            background level (10)" << std::endl
+            << "  --shape <bow|saddle|wave>      height field (bow)" << std::endl
+            << "  --amplitude <px>               largest dot displacement (4)" << std::endl
+            << "  --missing <fraction>           missing dots per image (0)" << std::endl
+            << "  --spurious <n>                 spurious dots per image (0)" << std::endl
+            << "  --seed <n>                     random seed (1)" << std::endl
+            << std::endl
+            << "benchmark options:" << std::endl
+            << "  --cfg <file>                   configuration (defo/defo.cfg)" << std::endl
+            << "  --repeat <n>                   number of runs (3)" << std::endl
+            << "  --blocks <n>                   point finder threads (6)" << std::endl
+            << "  --indexer <name>               part of the indexer name (first indexer)" << std::endl
+            << "  --focal-length <mm>            focal length (50)" << std::endl
+            << "  --threshold1/2/3 <gray>        point finder thresholds (configuration)" << std::endl
+            << "  --half-square-width <px>       point finder search box (configuration)" << std::endl
+            << "  --max-shape-error <fraction>   fail above this relative surface error" << std::endl
+            << "  --min-indexed <fraction>       fail below this fraction of correctly indexed dots" << std::endl;
+}
+
+static bool parseArguments(int argc, char** argv, Options_t& options)
+{
+  options.mode = "run";
+  options.repeat = 3;
+  options.blocks = 6;
+  options.focalLength = 50.;
+  options.thresholds[0] = options.thresholds[1] = options.thresholds[2] = -1;
+  options.halfSquareWidth = 0;
+  options.maxShapeError = -1;
+  options.minIndexed = -1;
+  options.image = DefoSyntheticImage::defaultParameters();
+
+  int i = 1;
+  if (argc>2 && std::string(argv[1])=="generate") {
+    options.mode = "generate";
+    options.output = argv[2];
+    i = 3;
+  }
+
+  for (;i<argc;++i) {
+    std::string key = argv[i];
+    if (key=="-h" || key=="--help" || i+1>=argc) return false;
+    std::string value = argv[++i];
+
+    DefoSyntheticImage::Parameters_t& p = options.image;
+
+    if (key=="--width") p.width = std::atoi(value.c_str());
+    else if (key=="--height") p.height = std::atoi(value.c_str());
+    else if (key=="--nx") p.nx = std::atoi(value.c_str());
+    else if (key=="--ny") p.ny = std::atoi(value.c_str());
+    else if (key=="--pitch") p.pitch = std::atof(value.c_str());
+    else if (key=="--rotation") p.rotation = std::atof(value.c_str());
+    else if (key=="--radius") p.dotRadius = std::atof(value.c_str());
+    else if (key=="--blur") p.blur = std::atof(value.c_str());
+    else if (key=="--noise") p.noise = std::atof(value.c_str());
+    else if (key=="--background") p.background = std::atoi(value.c_str());
+    else if (key=="--amplitude") p.amplitude = std::atof(value.c_str());
+    else if (key=="--missing") p.missing = std::atof(value.c_str());
+    else if (key=="--spurious") p.spurious = std::atoi(value.c_str());
+    else if (key=="--seed") p.seed = std::atoi(value.c_str());
+    else if (key=="--shape") {
+      bool ok;
+      p.shape = DefoSyntheticImage::shapeFromString(value, ok);
+      if (!ok) return false;
+    }
+    else if (key=="--cfg") options.cfgFile = value;
+    else if (key=="--repeat") options.repeat = std::max(1, std::atoi(value.c_str()));
+    else if (key=="--blocks") options.blocks = std::max(1, std::atoi(value.c_str()));
+    else if (key=="--indexer") options.indexer = value;
+    else if (key=="--focal-length") options.focalLength = std::atof(value.c_str());
+    else if (key=="--threshold1") options.thresholds[0] = std::atoi(value.c_str());
+    else if (key=="--threshold2") options.thresholds[1] = std::atoi(value.c_str());
+    else if (key=="--threshold3") options.thresholds[2] = std::atoi(value.c_str());
+    else if (key=="--half-square-width") options.halfSquareWidth = std::atoi(value.c_str());
+    else if (key=="--max-shape-error") options.maxShapeError = std::atof(value.c_str());
+    else if (key=="--min-indexed") options.minIndexed = std::atof(value.c_str());
+    else return false;
+  }
+
+  return (options.image.nx>1 && options.image.ny>1 &&
+          options.image.width>0 && options.image.height>0);
+}
+
+/**
+  Lookup of the true dot nearest to a position, using a hash of cells of
+  one pitch.
+  */
+class DotLookup
+{
+public:
+
+  DotLookup(const std::vector<DefoSyntheticImage::Dot_t>& dots, double pitch, bool deformed)
+    : dots_(dots), pitch_(pitch), deformed_(deformed) {
+    for (size_t k=0;k<dots_.size();++k) {
+      if (deformed_ ? !dots_[k].inDeformed : !dots_[k].inReference) continue;
+      cells_[cell(x(dots_[k]), y(dots_[k]))].push_back(k);
+    }
+  }
+
+  /// index of the nearest dot within maxDistance, -1 if none
+  int nearest(double px, double py, double maxDistance, double& distance) const {
+    std::pair<int,int> c = cell(px, py);
+    int best = -1;
+    distance = maxDistance;
+    for (int cx=c.first-1;cx<=c.first+1;++cx) {
+      for (int cy=c.second-1;cy<=c.second+1;++cy) {
+        std::map<std::pair<int,int>,std::vector<size_t> >::const_iterator it = cells_.find(std::make_pair(cx, cy));
+        if (it==cells_.end()) continue;
+        for (std::vector<size_t>::const_iterator k = it->second.begin();k!=it->second.end();++k) {
+          double d = std::hypot(x(dots_[*k]) - px, y(dots_[*k]) - py);
+          if (d<distance) {
+            distance = d;
+            best = *k;
+          }
+        }
+      }
+    }
+    return best;
+  }
+
+  size_t size() const {
+    size_t n = 0;
+    for (std::map<std::pair<int,int>,std::vector<size_t> >::const_iterator it = cells_.begin();
+         it!=cells_.end();
+         ++it) n += it->second.size();
+    return n;
+  }
+
+protected:
+
+  double x(const DefoSyntheticImage::Dot_t& dot) const { return deformed_ ? dot.x + dot.dx : dot.x; }
+  double y(const DefoSyntheticImage::Dot_t& dot) const { return deformed_ ? dot.y + dot.dy : dot.y; }
+  std::pair<int,int> cell(double px, double py) const {
+    return std::make_pair((int)std::floor(px / pitch_), (int)std::floor(py / pitch_));
+  }
+
+  const std::vector<DefoSyntheticImage::Dot_t>& dots_;
+  double pitch_;
+  bool deformed_;
+  std::map<std::pair<int,int>,std::vector<size_t> > cells_;
+};
+
+/**
+  Relation between the grid position of a dot and the index assigned by
+  an indexer; the indexers are free to choose axis directions.
+  */
+typedef struct {
+  bool swap;
+  int signX;
+  int signY;
+} IndexConvention_t;
+
+static std::pair<int,int> expectedIndex(const DefoSyntheticImage& generator,
+                                        const DefoSyntheticImage::Dot_t& dot,
+                                        const IndexConvention_t& convention)
+{
+  int di = dot.i - generator.getSeedI();
+  int dj = dot.j - generator.getSeedJ();
+  if (convention.swap) std::swap(di, dj);
+  return std::make_pair(convention.signX * di, convention.signY * dj);
+}
+
+typedef struct {
+  size_t truth;
+  size_t found;
+  size_t matched;
+  size_t spurious;
+  double rms;
+  size_t indexed;
+  size_t correct;
+  IndexConvention_t convention;
+} PointAccuracy_t;
+
+static PointAccuracy_t checkPoints(const DefoSyntheticImage& generator,
+                                   const DefoPointCollection& points,
+                                   bool deformed)
+{
+  PointAccuracy_t result;
+
+  DotLookup lookup(generator.getDots(), generator.getPitch(), deformed);
+  const double maxDistance = 0.25 * generator.getPitch();
+
+  result.truth = lookup.size();
+  result.found = points.size();
+  result.matched = 0;
+  result.spurious = 0;
+  result.indexed = 0;
+  result.correct = 0;
+
+  double sum2 = 0;
+  std::vector<std::pair<int,const DefoPoint*> > matches;
+
+  for (DefoPointCollection::const_iterator it = points.begin();it!=points.end();++it) {
+    double distance;
+    int k = lookup.nearest(it->getX(), it->getY(), maxDistance, distance);
+    if (k<0) {
+      result.spurious++;
+      continue;
+    }
+    result.matched++;
+    sum2 += distance * distance;
+    if (it->isIndexed()) matches.push_back(std::make_pair(k, &(*it)));
+  }
+
+  result.rms = result.matched ? std::sqrt(sum2 / result.matched) : 0;
+  result.indexed = matches.size();
+
+  // choose the convention that explains most indices
+  IndexConvention_t conventions[8];
+  for (int c=0;c<8;++c) {
+    conventions[c].swap = (c & 4);
+    conventions[c].signX = (c & 1) ? -1 : 1;
+    conventions[c].signY = (c & 2) ? -1 : 1;
+  }
+
+  result.convention = conventions[0];
+  for (int c=0;c<8;++c) {
+    size_t correct = 0;
+    for (size_t m=0;m<matches.size();++m) {
+      const DefoSyntheticImage::Dot_t& dot = generator.getDots()[matches[m].first];
+      if (matches[m].second->getIndex()==expectedIndex(generator, dot, conventions[c])) correct++;
+    }
+    if (correct>result.correct) {
+      result.correct = correct;
+      result.convention = conventions[c];
+    }
+  }
+
+  return result;
+}
+
+/**
+  Fits z = a h + b + c x + d y of the reconstructed heights z against the
+  true height field h and returns the RMS of the residuals relative to the
+  fitted range of a h. Offset and tilt are removed by the reconstruction,
+  the scale depends on the geometry and calibration constants.
+  */
+static double checkSurface(const DefoSyntheticImage& generator,
+                           const DefoSurface& surface,
+                           const IndexConvention_t& convention,
+                           size_t& nPoints)
+{
+  std::map<std::pair<int,int>,const DefoSyntheticImage::Dot_t*> dotsByIndex;
+  for (std::vector<DefoSyntheticImage::Dot_t>::const_iterator it = generator.getDots().begin();
+       it!=generator.getDots().end();
+       ++it) {
+    dotsByIndex[expectedIndex(generator, *it, convention)] = &(*it);
+  }
+
+  std::vector<double> h, x, y, z;
+
+  const DefoPointField& field = surface.getPointFieldX();
+  for (DefoPointField::const_iterator column = field.begin();column!=field.end();++column) {
+    for (std::vector<DefoPoint>::const_iterator it = column->begin();it!=column->end();++it) {
+      if (!it->isValid()) continue;
+      std::map<std::pair<int,int>,const DefoSyntheticImage::Dot_t*>::const_iterator dot = dotsByIndex.find(it->getIndex());
+      if (dot==dotsByIndex.end()) continue;
+      h.push_back(dot->second->height);
+      x.push_back(dot->second->x);
+      y.push_back(dot->second->y);
+      z.push_back(it->getHeight());
+    }
+  }
+
+  nPoints = z.size();
+  if (nPoints<5) return -1;
+
+  // normal equations of the linear least squares fit
+  double A[4][5] = { { 0 } };
+  for (size_t k=0;k<nPoints;++k) {
+    const double f[4] = { h[k], 1., x[k], y[k] };
+    for (int r=0;r<4;++r) {
+      for (int c=0;c<4;++c) A[r][c] += f[r] * f[c];
+      A[r][4] += f[r] * z[k];
+    }
+  }
+
+  // gaussian elimination with partial pivoting
+  for (int c=0;c<4;++c) {
+    int pivot = c;
+    for (int r=c+1;r<4;++r) if (std::fabs(A[r][c])>std::fabs(A[pivot][c])) pivot = r;
+    if (std::fabs(A[pivot][c])<1e-300) return -1;
+    for (int k=0;k<5;++k) std::swap(A[c][k], A[pivot][k]);
+    for (int r=0;r<4;++r) {
+      if (r==c) continue;
+      const double factor = A[r][c] / A[c][c];
+      for (int k=c;k<5;++k) A[r][k] -= factor * A[c][k];
+    }
+  }
+  double p[4];
+  for (int r=0;r<4;++r) p[r] = A[r][4] / A[r][r];
+
+  double sum2 = 0;
+  double hmin = h[0], hmax = h[0];
+  for (size_t k=0;k<nPoints;++k) {
+    const double residual = z[k] - (p[0] * h[k] + p[1] + p[2] * x[k] + p[3] * y[k]);
+    sum2 += residual * residual;
+    hmin = std::min(hmin, h[k]);
+    hmax = std::max(hmax, h[k]);
+  }
+
+  const double range = std::fabs(p[0]) * (hmax - hmin);
+  if (range<=0) return -1;
+
+  return std::sqrt(sum2 / nPoints) / range;
+}
+
+/**
+  Runs the point finder on the image in blocks of concurrent threads,
+  as done by the point recognition widgets.
+  */
+static const DefoPointCollection* findPoints(DefoMeasurement* measurement,
+                                             DefoMeasurementListModel* listModel,
+                                             DefoPointRecognitionModel* pointModel,
+                                             int blocks)
+{
+  static QMutex mutex;
+
+  listModel->setMeasurementPoints(measurement, NULL);
+
+  const QRect searchArea = measurement->getImage().rect();
+  const int width = searchArea.width() / blocks;
+  const int halfSquareWidth = pointModel->getHalfSquareWidth();
+
+  std::vector<DefoPointFinder*> finders;
+  for (int i=0;i<blocks;++i) {
+    QRect area = searchArea;
+    area.setX(searchArea.x() + i*width - halfSquareWidth);
+    area.setWidth(width + 2*halfSquareWidth);
+
+    DefoPointFinder* finder = new DefoPointFinder(i, &mutex, listModel, pointModel,
+                                                  measurement, area);
+    finders.push_back(finder);
+    finder->start();
+  }
+
+  for (size_t i=0;i<finders.size();++i) finders[i]->wait();
+
+  // deliver the queued pointsFound signals
+  QCoreApplication::processEvents();
+
+  for (size_t i=0;i<finders.size();++i) delete finders[i];
+
+  return listModel->getMeasurementPoints(measurement);
+}
+
+static void printPointAccuracy(const std::string& name, const PointAccuracy_t& a)
+{
+  std::cout << std::setw(10) << name
+            << "  dots " << std::setw(6) << a.truth
+            << "  found " << std::setw(6) << a.found
+            << "  matched " << std::setw(6) << a.matched
+            << "  spurious " << std::setw(4) << a.spurious
+            << "  rms " << std::fixed << std::setprecision(3) << a.rms << " px"
+            << "  indexed " << std::setw(6) << a.indexed
+            << "  correct " << std::setw(6) << a.correct
+            << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  Options_t options;
+  if (!parseArguments(argc, argv, options)) {
+    usage();
+    return -1;
+  }
+
+  DefoSyntheticImage generator(options.image);
+
+  QElapsedTimer timer;
+  timer.start();
+  QImage refImage = generator.render(false);
+  QImage defoImage = generator.render(true);
+  double renderTime = timer.nsecsElapsed() / 1e6;
+
+  std::cout << "dots: " << options.image.nx << " x " << options.image.ny
+            << ", pitch " << generator.getPitch() << " px"
+            << ", image " << options.image.width << " x " << options.image.height
+            << ", rendered in " << renderTime << " ms" << std::endl;
+
+  if (options.mode=="generate") {
+    QDir dir(options.output.c_str());
+    if (!dir.exists() && !dir.mkpath(".")) {
+      std::cout << "cannot create directory " << options.output << std::endl;
+      return -1;
+    }
+    DefoSyntheticImage::cameraImage(refImage).save(dir.absoluteFilePath("ref.png"));
+    DefoSyntheticImage::cameraImage(defoImage).save(dir.absoluteFilePath("defo.png"));
+    generator.writeTruth(dir.absoluteFilePath("truth.txt").toStdString());
+    std::cout << "written to " << options.output << std::endl;
+    return 0;
+  }
+
+  if (options.cfgFile.empty()) {
+    ApplicationConfig::instance(std::string(Config::CMSTkModLabBasePath) + "/defo/defo.cfg");
+  } else {
+    ApplicationConfig::instance(options.cfgFile);
+  }
+
+  DefoMeasurementListModel listModel;
+  DefoMeasurement refMeasurement(DefoSyntheticImage::cameraImage(refImage), false);
+  DefoMeasurement defoMeasurement(DefoSyntheticImage::cameraImage(defoImage), false);
+
+  DefoPointRecognitionModel pointModel;
+  const char* thresholdKeys[3] = { "STEP1_THRESHOLD", "STEP2_THRESHOLD", "STEP3_THRESHOLD" };
+  for (int t=0;t<3;++t) {
+    int value = options.thresholds[t];
+    if (value<0) value = ApplicationConfig::instance()->getValue<int>(thresholdKeys[t], 35 + 15*t);
+    pointModel.setThresholdValue(static_cast<DefoPointRecognitionModel::Threshold>(t), value);
+  }
+
+  // the search box must not reach the neighbouring dots
+  int halfSquareWidth = options.halfSquareWidth;
+  if (halfSquareWidth<=0) {
+    halfSquareWidth = ApplicationConfig::instance()->getValue<int>("HALF_SQUARE_WIDTH", 15);
+    halfSquareWidth = std::min(halfSquareWidth, (int)(0.4 * generator.getPitch()));
+  }
+  pointModel.setHalfSquareWidth(halfSquareWidth);
+
+  DefoPointIndexerModel indexerModel;
+  DefoVPointIndexer* indexer = indexerModel.getIndexer(0);
+  for (int i=0;i<indexerModel.getIndexerCount();++i) {
+    QString name(indexerModel.getIndexerName(indexerModel.getIndexer(i)).c_str());
+    if (!options.indexer.empty() && name.contains(options.indexer.c_str(), Qt::CaseInsensitive)) {
+      indexer = indexerModel.getIndexer(i);
+    }
+  }
+  std::cout << "indexer: " << indexerModel.getIndexerName(indexer) << std::endl;
+
+  Defo2DSplineInterpolationModel interpolationModel;
+
+  DefoRecoSurface reco;
+  reco.setImageSize(std::pair<double,double>(refMeasurement.getWidth(),
+                                             refMeasurement.getHeight()));
+  reco.setFocalLength(options.focalLength);
+
+  const char* stageNames[] = { "find points (ref)", "find points (defo)",
+                               "index (ref)", "index (defo)",
+                               "reconstruct", "fitSpline2D", "total" };
+  const int nStages = 7;
+  std::vector<std::vector<double> > times(nStages);
+
+  PointAccuracy_t refAccuracy, defoAccuracy;
+  double shapeError = -1;
+  size_t surfacePoints = 0;
+
+  for (int run=0;run<options.repeat;++run) {
+
+    QElapsedTimer total;
+    total.start();
+
+    timer.start();
+    DefoPointCollection refPoints(*findPoints(&refMeasurement, &listModel, &pointModel, options.blocks));
+    times[0].push_back(timer.nsecsElapsed() / 1e6);
+
+    timer.start();
+    DefoPointCollection defoPoints(*findPoints(&defoMeasurement, &listModel, &pointModel, options.blocks));
+    times[1].push_back(timer.nsecsElapsed() / 1e6);
+
+    timer.start();
+    indexer->indexPoints(&refPoints, DefoSyntheticImage::seedColor());
+    times[2].push_back(timer.nsecsElapsed() / 1e6);
+
+    timer.start();
+    indexer->indexPoints(&defoPoints, DefoSyntheticImage::seedColor());
+    times[3].push_back(timer.nsecsElapsed() / 1e6);
+
+    refAccuracy = checkPoints(generator, refPoints, false);
+    defoAccuracy = checkPoints(generator, defoPoints, true);
+
+    timer.start();
+    DefoSurface surface = reco.reconstruct(defoPoints, refPoints);
+    times[4].push_back(timer.nsecsElapsed() / 1e6);
+
+    timer.start();
+    surface.fitSpline2D(interpolationModel.getKX(),
+                        interpolationModel.getKY(),
+                        interpolationModel.getSmoothing(),
+                        interpolationModel.getNXY());
+    times[5].push_back(timer.nsecsElapsed() / 1e6);
+
+    // the accuracy checks are not part of the total
+    times[6].push_back(times[0].back() + times[1].back() + times[2].back() +
+                       times[3].back() + times[4].back() + times[5].back());
+
+    shapeError = checkSurface(generator, surface, refAccuracy.convention, surfacePoints);
+  }
+
+  std::cout << std::endl
+            << std::setw(20) << "stage [ms]"
+            << std::setw(12) << "min"
+            << std::setw(12) << "mean"
+            << std::setw(12) << "max" << std::endl;
+  for (int s=0;s<nStages;++s) {
+    double sum = 0;
+    for (size_t r=0;r<times[s].size();++r) sum += times[s][r];
+    std::cout << std::setw(20) << stageNames[s] << std::fixed << std::setprecision(1)
+              << std::setw(12) << *std::min_element(times[s].begin(), times[s].end())
+              << std::setw(12) << sum / times[s].size()
+              << std::setw(12) << *std::max_element(times[s].begin(), times[s].end())
+              << std::endl;
+  }
+
+  std::cout << std::endl;
+  printPointAccuracy("reference", refAccuracy);
+  printPointAccuracy("deformed", defoAccuracy);
+
+  const IndexConvention_t& c = refAccuracy.convention;
+  std::cout << "index convention: " << (c.swap ? "swapped axes, " : "")
+            << "x " << (c.signX>0 ? "+" : "-") << ", y " << (c.signY>0 ? "+" : "-") << std::endl;
+
+  const double indexedFraction = refAccuracy.truth ?
+    (double)std::min(refAccuracy.correct, defoAccuracy.correct) / refAccuracy.truth : 0;
+  std::cout << "correctly indexed: " << std::setprecision(4) << indexedFraction << std::endl;
+
+  std::cout << "surface: " << surfacePoints << " points, relative shape error ";
+  if (shapeError<0) std::cout << "n/a" << std::endl;
+  else std::cout << std::setprecision(4) << shapeError << std::endl;
+
+  int result = 0;
+  if (options.maxShapeError>=0 && (shapeError<0 || shapeError>options.maxShapeError)) {
+    std::cout << "FAILED: shape error above " << options.maxShapeError << std::endl;
+    result = 1;
+  }
+  if (options.minIndexed>=0 && indexedFraction<options.minIndexed) {
+    std::cout << "FAILED: correctly indexed fraction below " << options.minIndexed << std::endl;
+    result = 1;
+  }
+
+  return result;
+}
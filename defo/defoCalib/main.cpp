@@ -27,6 +27,7 @@
 
 #include <DefoGeometryModel.h>
 #include <DefoPoint.h>
+#include <DefoPointFile.h>
 #include <DefoRecoSurface.h>
 #include <DefoSurface.h>
 
@@ -48,46 +49,6 @@ public:
     DefoSurface surface;
 };
 
-bool readPoints(std::string& filename, image& i) {
-
-    i.points.clear();
-
-    QFile file(filename.c_str());
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-        return false;
-
-    QXmlStreamReader stream(&file);
-
-    while (!stream.atEnd()) {
-        stream.readNextStartElement();
-        if (stream.isStartElement() && stream.name()=="DefoPoint") {
-            double x = stream.attributes().value("x").toString().toDouble();
-            double y = stream.attributes().value("y").toString().toDouble();
-            float H = stream.attributes().value("H").toString().toFloat();
-            float S = stream.attributes().value("S").toString().toFloat();
-            float V = stream.attributes().value("V").toString().toFloat();
-            DefoPoint p(x, y);
-            QColor c;
-            c.setHsvF(H, S, V);
-            p.setColor(c);
-
-            p.setValid(true);
-
-            bool indexed = (stream.attributes().value("indexed").toString().toInt()==1);
-            p.unindex();
-            if (indexed) {
-              int ix = stream.attributes().value("ix").toString().toInt();
-              int iy = stream.attributes().value("iy").toString().toInt();
-              p.setIndex(ix, iy);
-            }
-
-            i.points.push_back(p);
-        }
-    }
-
-    return true;
-}
-
 bool parseImage(std::string& dataPath, image& i) {
 
     std::string filename = dataPath + "/";
@@ -120,21 +81,12 @@ bool parseImage(std::string& dataPath, image& i) {
     }
 
     QDir dir(dataPath.c_str());
-    filename = "offlinePoints_";
-    filename += i.timestamp;
-    filename += ".xml";
-    if (dir.exists(filename.c_str())) {
-        i.hasPoints = true;
-    } else {
-        i.hasPoints = false;
-    }
+    QString basename = "offlinePoints_";
+    basename += i.timestamp.c_str();
+    i.hasPoints = DefoPointFile::exists(dir, basename);
 
     if (i.hasPoints) {
-        filename = dataPath + "/";
-        filename += "offlinePoints_";
-        filename += i.timestamp;
-        filename += ".xml";
-        readPoints(filename, i);
+        DefoPointFile::read(dir, basename, i.points);
     }
 
     return true;
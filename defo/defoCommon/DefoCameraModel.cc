@@ -15,6 +15,8 @@
 
 #include <QCoreApplication>
 #include <QPlainTextDocumentLayout>
+#include <QBuffer>
+#include <QImageReader>
 
 #include <nqlogger.h>
 
@@ -34,6 +36,10 @@ DefoCameraModel::DefoCameraModel(QObject *parent)
   
   numberOfImages_ = ApplicationConfig::instance()->getValue<int>("NUMBEROFIMAGES", 1);
 
+  // live view pictures are decoded at 1/LIVEVIEW_SCALE of their size
+  liveViewScale_ = ApplicationConfig::instance()->getValue<int>("LIVEVIEW_SCALE", 1);
+  if (liveViewScale_<1) liveViewScale_ = 1;
+
   int initValue = 0;
   parameters_[APERTURE] = initValue;
   parameters_[ISO] = initValue;
@@ -48,6 +54,11 @@ DefoCameraModel::DefoCameraModel(QObject *parent)
   setDeviceEnabled(true);
 }
 
+DefoCameraModel::~DefoCameraModel()
+{
+  cleanupPendingWrites(true);
+}
+
 void DefoCameraModel::resetParameterCache()
 {
   int resetValue = 0;
@@ -148,8 +159,15 @@ void DefoCameraModel::setDeviceState(State state)
 void DefoCameraModel::acquirePicture(bool keep)
 {
   if (numberOfImages_==1) {
-    location_ = controller_->acquirePhoto().c_str();
-    image_ = QImage(location_);
+    // download into memory and decode directly, no temporary file involved
+    std::vector<char> data;
+    if (!controller_->acquirePhoto(data)) {
+      NQLogWarning("DefoCameraModel") << "acquirePicture: failed to download picture";
+      return;
+    }
+    imageData_ = QByteArray(data.data(), data.size());
+    image_ = decodeImage(imageData_);
+    location_ = QString();
     emit newImage(location_, keep);
     emit defoMessage("new image aquired");
   } else {
@@ -177,11 +195,64 @@ void DefoCameraModel::acquirePictures(int count)
 /// Instruct the camera to take a picture and cache the file in a QImage.
 void DefoCameraModel::acquireLiveViewPicture()
 {
-  location_ = controller_->acquirePreview().c_str();
-  liveViewImage_ = QImage(location_);
+  std::vector<char> data;
+  if (!controller_->acquirePreview(data)) return;
+
+  liveViewImage_ = decodeImage(QByteArray::fromRawData(data.data(), data.size()),
+                               liveViewScale_);
+  location_ = QString();
   emit newLiveViewImage(location_);
 }
 
+/**
+  \brief Decodes an image from memory. For scale > 1 the image is decoded at
+  reduced size, which for JPEG lets the decoder skip most of the work.
+ */
+QImage DefoCameraModel::decodeImage(const QByteArray& data, int scale)
+{
+  QBuffer buffer;
+  buffer.setData(data);
+  buffer.open(QIODevice::ReadOnly);
+
+  QImageReader reader(&buffer);
+  if (scale>1) {
+    QSize size = reader.size();
+    if (size.isValid()) reader.setScaledSize(size / scale);
+  }
+
+  return reader.read();
+}
+
+std::shared_future<bool> DefoCameraModel::writeLastPicture(const QString& location)
+{
+  cleanupPendingWrites(false);
+
+  // QByteArray is implicitly shared, the writer keeps the data alive
+  const QByteArray data = imageData_;
+  std::shared_future<bool> write = std::async(std::launch::async, [data, location]() {
+        QFile file(location);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+        return file.write(data)==data.size();
+      }).share();
+  pendingWrites_.push_back(write);
+
+  return write;
+}
+
+void DefoCameraModel::cleanupPendingWrites(bool wait)
+{
+  for (auto it = pendingWrites_.begin();it!=pendingWrites_.end();) {
+    if (wait || it->wait_for(std::chrono::seconds(0))==std::future_status::ready) {
+      if (!it->get()) {
+        NQLogWarning("DefoCameraModel") << "failed to write archival copy of picture";
+      }
+      it = pendingWrites_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 void DefoCameraModel::setComment(const QString& comment)
 {
   comment_->setPlainText(comment);
@@ -202,6 +273,11 @@ const QImage & DefoCameraModel::getLastPicture() const
   return image_;
 }
 
+const QByteArray & DefoCameraModel::getLastPictureData() const
+{
+  return imageData_;
+}
+
 const QImage & DefoCameraModel::getLastLiveViewPicture() const
 {
   return liveViewImage_;
@@ -21,6 +21,8 @@
 #include <QStringList>
 
 #include <map>
+#include <list>
+#include <future>
 
 #ifdef USE_FAKEIO
 #include "devices/Canon/EOS550DFake.h"
@@ -50,12 +52,18 @@ public:
   };
 
   explicit DefoCameraModel(QObject *parent = 0);
+  virtual ~DefoCameraModel();
 
   std::vector<std::string> getOptions( const Option& option ) const;
   void setOptionSelection( const Option& option, int value );
   int getOptionValue( const Option& option) const;
 
   const QImage& getLastPicture() const;
+  /// Raw (JPEG) file content of the last picture downloaded into memory.
+  const QByteArray& getLastPictureData() const;
+  /// Writes the last picture to the given location in a background thread;
+  /// the future reports whether the write succeeded.
+  std::shared_future<bool> writeLastPicture(const QString& location);
   const QString& getLastPictureLocation() const;
   const QStringList& getLastPictureLocations() const;
   const QImage& getLastLiveViewPicture() const;
@@ -88,12 +96,20 @@ protected:
   QString location_;
   QStringList locations_;
   QImage image_;
+  QByteArray imageData_;
   QImage liveViewImage_;
+  int liveViewScale_;
   QTimer liveViewTimer_;
   QTextDocument* comment_;
   int calibAmplitude_;
   int numberOfImages_;
 
+  // pending asynchronous writes of archival copies
+  std::list<std::shared_future<bool> > pendingWrites_;
+  void cleanupPendingWrites(bool wait);
+
+  static QImage decodeImage(const QByteArray& data, int scale = 1);
+
 signals:
   void deviceStateChanged(State newState);
   void deviceOptionChanged(DefoCameraModel::Option option, int newValue);
@@ -26,11 +26,23 @@ DefoExifReader::DefoExifReader(const QString& filename)
 
 }
 
+DefoExifReader::DefoExifReader(const QByteArray& data)
+  : data_(data)
+{
+
+}
+
 bool DefoExifReader::read()
 {
   try {
 
-    Exiv2::Image::AutoPtr image = Exiv2::ImageFactory::open(filename_.toStdString().c_str());
+    Exiv2::Image::AutoPtr image;
+    if (data_.isEmpty()) {
+      image = Exiv2::ImageFactory::open(filename_.toStdString().c_str());
+    } else {
+      image = Exiv2::ImageFactory::open(reinterpret_cast<const Exiv2::byte*>(data_.constData()),
+                                        data_.size());
+    }
 
     image->readMetadata();
 
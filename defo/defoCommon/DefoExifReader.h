@@ -16,6 +16,7 @@
 #include <exiv2/exif.hpp>
 
 #include <QString>
+#include <QByteArray>
 
 class DefoExifReader {
 
@@ -23,6 +24,9 @@ public:
   DefoExifReader(
       const QString& filename
   );
+  DefoExifReader(
+      const QByteArray& data
+  );
 
   bool read();
 
@@ -32,6 +36,7 @@ public:
 
 protected:
   const QString filename_;
+  const QByteArray data_;
   Exiv2::ExifData exifData_;
 };
 
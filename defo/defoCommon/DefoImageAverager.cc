@@ -10,12 +10,14 @@
 //                                                                             //
 /////////////////////////////////////////////////////////////////////////////////
 
+#include <vector>
+
 #include <opencv2/highgui/highgui.hpp>
 
 #include <QColor>
 
 #include <nqlogger.h>
-#include <nmatrix.h>
+#include <nqimage.h>
 
 #include "DefoImageAverager.h"
 
@@ -34,66 +36,66 @@ DefoImageAverager::~DefoImageAverager()
 
 QImage DefoImageAverager::getAveragedImage()
 {
-  int width, height;
-
-  QImage ret(filenames_.front());
-  width = ret.width();
-  height = ret.height();
-
-  /*
-  NMatrix<unsigned short> red(width, height);
-  NMatrix<unsigned short> green(width, height);
-  NMatrix<unsigned short> blue(width, height);
-
-  int count = 0;
-  for (QString filename : filenames_) {
-    IplImage *img = cvLoadImage(filename.toStdString().c_str());
-    IplImage *imgRed = cvCreateImage(cvGetSize(img), 8, 1);
-    IplImage *imgGreen = cvCreateImage(cvGetSize(img), 8, 1);
-    IplImage *imgBlue = cvCreateImage(cvGetSize(img), 8, 1);
-    cvSplit(img, imgRed, imgGreen, imgBlue, NULL);
-    cvReleaseImage(&img);
-
-    for (int w=0;w<width;w++) {
-      for (int h=0;h<height;h++) {
+  return average(false);
+}
 
-      }
-    }
-  }
+/**
+  Returns the averaged image rotated clockwise by 90 degrees. The rotation
+  is fused into the accumulation, so no rotated copy of the individual
+  images is made.
   */
+QImage DefoImageAverager::getRotatedAveragedImage()
+{
+  return average(true);
+}
 
-  NMatrix<unsigned short> red(width, height);
-  NMatrix<unsigned short> green(width, height);
-  NMatrix<unsigned short> blue(width, height);
+QImage DefoImageAverager::average(bool rotate)
+{
+  QImage first(filenames_.front());
+  if (first.isNull()) return first;
+
+  const int width = first.width();
+  const int height = first.height();
+  const int size = width * height;
+
+  // interleaved red, green and blue sums in the layout of the result image
+  std::vector<unsigned short> sum(3*size, 0);
+  auto accumulate = [&sum](int index, QRgb rgb) {
+    unsigned short* s = &sum[3*index];
+    s[0] += qRed(rgb);
+    s[1] += qGreen(rgb);
+    s[2] += qBlue(rgb);
+  };
 
   int count = 0;
   for (QString filename : filenames_) {
 
-    QImage temp(filename);
+    QImage temp = (count==0) ? first : QImage(filename);
+    if (temp.width()!=width || temp.height()!=height) {
+      NQLogWarning("DefoImageAverager") << "skipping " << filename << " due to size mismatch";
+      continue;
+    }
+    if (temp.depth()!=32) temp = temp.convertToFormat(QImage::Format_RGB32);
 
-    for (int w=0;w<width;w++) {
+    if (rotate) {
+      NQImage::forEachRotated90(temp, accumulate);
+    } else {
       for (int h=0;h<height;h++) {
-        QRgb rgb = temp.pixel(w, h);
-
-        int r = qRed(rgb);
-        int g = qGreen(rgb);
-        int b = qBlue(rgb);
-
-        red(w, h) += r;
-        green(w, h) += g;
-        blue(w, h) += b;
+        const QRgb* line = reinterpret_cast<const QRgb*>(temp.constScanLine(h));
+        for (int w=0;w<width;w++) accumulate(h*width+w, line[w]);
       }
     }
 
     count++;
   }
 
-  for (int w=0;w<width;w++) {
-    for (int h=0;h<height;h++) {
-      ret.setPixel(w, h, qRgb(red(w, h)/count,
-                              green(w, h)/count,
-                              blue(w, h)/count));
-    }
+  QImage ret = rotate ? QImage(height, width, QImage::Format_RGB32)
+                      : QImage(width, height, QImage::Format_RGB32);
+
+  QRgb* dst = reinterpret_cast<QRgb*>(ret.bits());
+  for (int i=0;i<size;++i) {
+    const unsigned short* s = &sum[3*i];
+    dst[i] = qRgb(s[0]/count, s[1]/count, s[2]/count);
   }
 
   return ret;
@@ -24,9 +24,12 @@ public:
   ~DefoImageAverager();
 
   QImage getAveragedImage();
+  QImage getRotatedAveragedImage();
 
 protected:
 
+  QImage average(bool rotate);
+
   QStringList filenames_;
 };
 
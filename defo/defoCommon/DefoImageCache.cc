@@ -0,0 +1,207 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#include <chrono>
+
+#include <QMutexLocker>
+
+#include <nqlogger.h>
+#include <ApplicationConfig.h>
+
+#include "DefoMeasurement.h"
+#include "DefoImageCache.h"
+
+DefoImageCache* DefoImageCache::instance_ = NULL;
+
+static qint64 imageBytes(const QImage& image)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+  return image.sizeInBytes();
+#else
+  return image.byteCount();
+#endif
+}
+
+DefoImageCache* DefoImageCache::instance()
+{
+  if (instance_==NULL) {
+    instance_ = new DefoImageCache();
+  }
+  return instance_;
+}
+
+DefoImageCache::DefoImageCache()
+: budget_(1024LL*1024*1024),
+  usage_(0)
+{
+  ApplicationConfig* config = ApplicationConfig::instance();
+  if (config!=NULL) {
+    budget_ = static_cast<qint64>(config->getValue<int>("IMAGE_CACHE_SIZE", 1024)) * 1024 * 1024;
+  }
+
+  NQLogMessage("DefoImageCache") << "memory budget " << budget_/(1024*1024) << " MB";
+}
+
+/**
+  Returns the decoded image of the measurement. On a cache miss the image is
+  decoded in the calling thread, unless a prefetch of it is already running.
+  */
+QImage DefoImageCache::getImage(const DefoMeasurement* measurement)
+{
+  std::shared_future<QImage> pending;
+
+  {
+    QMutexLocker locker(&mutex_);
+
+    cleanupPrefetches();
+
+    auto it = index_.find(measurement);
+    if (it!=index_.end()) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->second;
+    }
+
+    auto itP = prefetches_.find(measurement);
+    if (itP!=prefetches_.end()) pending = itP->second;
+  }
+
+  if (pending.valid()) return pending.get();
+
+  QImage image = measurement->loadImage();
+
+  QMutexLocker locker(&mutex_);
+  insertEntry(measurement, image);
+
+  return image;
+}
+
+void DefoImageCache::insert(const DefoMeasurement* measurement, const QImage& image,
+                            const std::shared_future<bool>& pendingWrite)
+{
+  QMutexLocker locker(&mutex_);
+  insertEntry(measurement, image);
+  if (pendingWrite.valid()) pins_[measurement] = pendingWrite;
+}
+
+void DefoImageCache::remove(const DefoMeasurement* measurement)
+{
+  std::shared_future<QImage> pending;
+
+  {
+    QMutexLocker locker(&mutex_);
+
+    auto itP = prefetches_.find(measurement);
+    if (itP!=prefetches_.end()) {
+      pending = itP->second;
+      prefetches_.erase(itP);
+    }
+  }
+
+  // a running prefetch still reads from the measurement
+  if (pending.valid()) pending.wait();
+
+  QMutexLocker locker(&mutex_);
+  eraseEntry(measurement);
+}
+
+void DefoImageCache::prefetch(const DefoMeasurement* measurement)
+{
+  if (measurement==NULL) return;
+
+  QMutexLocker locker(&mutex_);
+
+  cleanupPrefetches();
+
+  if (index_.find(measurement)!=index_.end()) return;
+  if (prefetches_.find(measurement)!=prefetches_.end()) return;
+
+  NQLogDebug("DefoImageCache") << "prefetch " << measurement->getTimeStamp().toString().toStdString();
+
+  prefetches_[measurement] = std::async(std::launch::async, [this, measurement]() {
+      QImage image = measurement->loadImage();
+      QMutexLocker locker(&mutex_);
+      insertEntry(measurement, image);
+      return image;
+    }).share();
+}
+
+void DefoImageCache::setMemoryBudget(qint64 bytes)
+{
+  QMutexLocker locker(&mutex_);
+  budget_ = bytes;
+  evict();
+}
+
+void DefoImageCache::insertEntry(const DefoMeasurement* measurement, const QImage& image)
+{
+  if (image.isNull()) return;
+
+  eraseEntry(measurement);
+
+  entries_.push_front(Entry(measurement, image));
+  index_[measurement] = entries_.begin();
+  usage_ += imageBytes(image);
+
+  evict();
+}
+
+void DefoImageCache::eraseEntry(const DefoMeasurement* measurement)
+{
+  auto it = index_.find(measurement);
+  if (it==index_.end()) return;
+
+  usage_ -= imageBytes(it->second->second);
+  entries_.erase(it->second);
+  index_.erase(it);
+  pins_.erase(measurement);
+}
+
+/// Drops least recently used images until the budget is met; the most recent one is always kept.
+void DefoImageCache::evict()
+{
+  auto it = entries_.end();
+  while (usage_>budget_ && it!=entries_.begin()) {
+    --it;
+    if (it==entries_.begin()) break;
+    if (isPinned(it->first)) continue;
+
+    usage_ -= imageBytes(it->second);
+    index_.erase(it->first);
+    it = entries_.erase(it);
+  }
+}
+
+/// True while the image file of the measurement is being written or could not be written.
+bool DefoImageCache::isPinned(const DefoMeasurement* measurement)
+{
+  auto it = pins_.find(measurement);
+  if (it==pins_.end()) return false;
+
+  if (it->second.wait_for(std::chrono::seconds(0))!=std::future_status::ready) return true;
+  if (!it->second.get()) return true;
+
+  pins_.erase(it);
+  return false;
+}
+
+/// Forgets finished prefetches; their images have already been inserted.
+void DefoImageCache::cleanupPrefetches()
+{
+  for (auto it = prefetches_.begin();it!=prefetches_.end();) {
+    if (it->second.wait_for(std::chrono::seconds(0))==std::future_status::ready) {
+      it = prefetches_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
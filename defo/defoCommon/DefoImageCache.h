@@ -0,0 +1,82 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef DEFOIMAGECACHE_H
+#define DEFOIMAGECACHE_H
+
+#include <list>
+#include <map>
+#include <future>
+#include <unordered_map>
+
+#include <QImage>
+#include <QMutex>
+
+class DefoMeasurement;
+
+/**
+  \brief Process-wide LRU cache of decoded measurement images.
+  \par DefoMeasurement only keeps metadata; pixel data is decoded on demand
+  and kept here until the memory budget is exceeded, at which point the least
+  recently used images are dropped. The budget is read from the configuration
+  key IMAGE_CACHE_SIZE in MB. Images handed out are implicitly shared, so
+  evicting an image that is still displayed does not invalidate it.
+  */
+class DefoImageCache
+{
+public:
+
+  static DefoImageCache* instance();
+
+  QImage getImage(const DefoMeasurement* measurement);
+  /// inserts an image; while pendingWrite is not finished, or if it failed,
+  /// the file cannot be reloaded and the image is not evicted
+  void insert(const DefoMeasurement* measurement, const QImage& image,
+              const std::shared_future<bool>& pendingWrite = std::shared_future<bool>());
+  void remove(const DefoMeasurement* measurement);
+
+  /// decodes the image in the background if it is not cached yet
+  void prefetch(const DefoMeasurement* measurement);
+
+  void setMemoryBudget(qint64 bytes);
+  qint64 getMemoryBudget() const { return budget_; }
+  qint64 getMemoryUsage() const { return usage_; }
+
+protected:
+
+  DefoImageCache();
+
+  typedef std::pair<const DefoMeasurement*,QImage> Entry;
+  typedef std::list<Entry> EntryList;
+
+  void insertEntry(const DefoMeasurement* measurement, const QImage& image);
+  void eraseEntry(const DefoMeasurement* measurement);
+  void evict();
+  bool isPinned(const DefoMeasurement* measurement);
+  void cleanupPrefetches();
+
+  static DefoImageCache* instance_;
+
+  qint64 budget_;
+  qint64 usage_;
+
+  /// most recently used entry first
+  EntryList entries_;
+  std::unordered_map<const DefoMeasurement*,EntryList::iterator> index_;
+  std::map<const DefoMeasurement*,std::shared_future<QImage> > prefetches_;
+  std::unordered_map<const DefoMeasurement*,std::shared_future<bool> > pins_;
+
+  QMutex mutex_;
+};
+
+#endif // DEFOIMAGECACHE_H
@@ -263,26 +263,13 @@ void DefoImageThresholdsWidget::updateCache()
   const DefoMeasurement* measurement = selectionModel_->getSelection();
 
   if (measurement != NULL) {
-    imageCache_ = QImage(selectionModel_->getSelection()->getImage());
     int thres1 = recognitionModel_->getThresholdValue(DefoPointRecognitionModel::THRESHOLD_1);
     int thres2 = recognitionModel_->getThresholdValue(DefoPointRecognitionModel::THRESHOLD_2);
     int thres3 = recognitionModel_->getThresholdValue(DefoPointRecognitionModel::THRESHOLD_3);
 
-    for (int x=0; x<imageCache_.width(); ++x) {
-      for (int y=0; y<imageCache_.height(); ++y) {
-        int gray = qGray(imageCache_.pixel(x, y));
-
-        // Colour according to brightness
-        if (gray > thres3)
-          imageCache_.setPixel(x, y, 0x0000FF);
-        else if (gray > thres2)
-          imageCache_.setPixel(x, y, 0x00FF00);
-        else if (gray > thres1)
-          imageCache_.setPixel(x, y, 0xFF0000);
-        else
-          imageCache_.setPixel(x, y, 0);
-      }
-    }
+    // the luminance of the image is cached, only the lookup table is reapplied
+    imageCache_ = overlay_.render(measurement->getImage(), 0,
+                                  thres1, thres2, thres3);
   } else
     imageCache_ = QImage();
 }
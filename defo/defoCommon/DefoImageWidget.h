@@ -24,6 +24,7 @@
 #include "DefoMeasurementSelectionModel.h"
 #include "DefoImageZoomModel.h"
 #include "DefoPointRecognitionModel.h"
+#include "DefoThresholdOverlay.h"
 
 class DefoImageBaseWidget : public QWidget
 {
@@ -140,6 +141,7 @@ protected:
 
   DefoPointRecognitionModel* recognitionModel_;
   QImage imageCache_;
+  DefoThresholdOverlay overlay_;
 
   void updateCache();
 };
@@ -0,0 +1,516 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cmath>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+
+#include "DefoLatticePointIndexer.h"
+
+/// largest distance from a lattice site, in units of the pitch
+static const double Tolerance = 0.3;
+/// radius of the first stage around the seed, in units of the pitch
+static const double InitialRadius = 4.0;
+/// radius of the neighbourhood in the final pass, in units of the pitch
+static const double NeighbourRadius = 1.5;
+static const double GrowthFactor = 1.5;
+/// shortest difference vector entering the autocorrelation
+static const double MinDistance = 0.3;
+static const int RansacIterations = 64;
+static const size_t MinQuadraticPoints = 12;
+static const unsigned int RandomSeed = 4711;
+
+DefoLatticePointIndexer::DefoLatticePointIndexer(QObject *parent) :
+  DefoVPointIndexer(parent)
+{
+
+}
+
+void DefoLatticePointIndexer::indexPoints(DefoPointCollection *points, const QColor& seedColor)
+{
+  for (DefoPointCollection::iterator it = points->begin();
+       it != points->end();
+       ++it) {
+    it->unindex();
+  }
+
+  DefoPoint * seed = findSeed(points, seedColor);
+  if (!seed) return;
+  seed->setIndex(0, 0);
+
+  std::vector<Vector> positions;
+  positions.reserve(points->size());
+  for (DefoPointCollection::const_iterator it = points->begin();
+       it != points->end();
+       ++it) {
+    positions.push_back(Vector(it->getX(), it->getY()));
+  }
+
+  const double scale = estimateScale(positions);
+  Vector ax, ay;
+  if (scale<=0 || !estimateLattice(positions, scale, ax, ay)) return;
+
+  // offsets from the seed in units of the scale
+  std::vector<Vector> q;
+  q.reserve(positions.size());
+  double qmax = 0;
+  for (std::vector<Vector>::const_iterator it = positions.begin();
+       it != positions.end();
+       ++it) {
+    q.push_back(Vector((it->first - seed->getX()) / scale,
+                       (it->second - seed->getY()) / scale));
+    qmax = std::max(qmax, std::hypot(q.back().first, q.back().second));
+  }
+
+  // initial affine mapping given by the inverse of the lattice vectors
+  Mapping_t mapping = { { { 0 } } };
+  const double det = ax.first * ay.second - ay.first * ax.second;
+  mapping.c[0][1] =  ay.second * scale / det;
+  mapping.c[0][2] = -ay.first  * scale / det;
+  mapping.c[1][1] = -ax.second * scale / det;
+  mapping.c[1][2] =  ax.first  * scale / det;
+
+  const size_t seedPosition = seed - &points->front();
+
+  random_.seed(RandomSeed);
+
+  std::vector<Label> labels(q.size());
+  bool first = true;
+  for (double radius = InitialRadius;;radius *= GrowthFactor) {
+
+    std::vector<size_t> selection;
+    for (size_t i=0;i<q.size();++i) {
+      if (std::hypot(q[i].first, q[i].second)>radius) continue;
+      selection.push_back(i);
+      labels[i] = round(evaluate(mapping, q[i]));
+    }
+
+    std::vector<size_t> inliers;
+    if (first) {
+      inliers = findConsensus(q, labels, selection);
+    } else {
+      for (std::vector<size_t>::const_iterator it = selection.begin();
+           it != selection.end();
+           ++it) {
+        if (residual(evaluate(mapping, q[*it]), labels[*it])<Tolerance) inliers.push_back(*it);
+      }
+    }
+
+    // curvature is only determined once the fit extends beyond the seed region
+    int nParameters = (!first && inliers.size()>=MinQuadraticPoints) ? 6 : 3;
+    Mapping_t refined;
+    if (fitMapping(q, labels, inliers, nParameters, refined)) mapping = refined;
+
+    first = false;
+    if (radius>=qmax) break;
+  }
+
+  // final pass in order of distance from the seed; the deviation of the
+  // mapping from the lattice is averaged over the indexed neighbours, which
+  // follows distortions the quadratic mapping does not describe
+  std::vector<std::pair<double,size_t> > order;
+  order.reserve(q.size());
+  std::unordered_map<long long,std::vector<size_t> > cells;
+  for (size_t i=0;i<q.size();++i) {
+    order.push_back(std::pair<double,size_t>(std::hypot(q[i].first, q[i].second), i));
+    cells[cellKey(static_cast<int>(std::floor(q[i].first)),
+                  static_cast<int>(std::floor(q[i].second)))].push_back(i);
+  }
+  std::sort(order.begin(), order.end());
+
+  std::vector<Vector> deviations(q.size());
+  std::vector<bool> accepted(q.size(), false);
+
+  typedef std::map<Label,std::pair<double,size_t> > SiteMap;
+  SiteMap sites;
+
+  for (std::vector<std::pair<double,size_t> >::const_iterator it = order.begin();
+       it != order.end();
+       ++it) {
+    const size_t i = it->second;
+    const int ix = static_cast<int>(std::floor(q[i].first));
+    const int iy = static_cast<int>(std::floor(q[i].second));
+
+    Vector deviation(0., 0.);
+    int count = 0;
+    for (int cx=ix-2;cx<=ix+2;++cx) {
+      for (int cy=iy-2;cy<=iy+2;++cy) {
+        std::unordered_map<long long,std::vector<size_t> >::const_iterator cell = cells.find(cellKey(cx, cy));
+        if (cell==cells.end()) continue;
+
+        for (std::vector<size_t>::const_iterator j = cell->second.begin();
+             j != cell->second.end();
+             ++j) {
+          if (!accepted[*j]) continue;
+          if (std::hypot(q[*j].first - q[i].first, q[*j].second - q[i].second)>NeighbourRadius) continue;
+          deviation.first += deviations[*j].first;
+          deviation.second += deviations[*j].second;
+          count++;
+        }
+      }
+    }
+
+    const Vector u = evaluate(mapping, q[i]);
+    Vector corrected = u;
+    if (count>0) {
+      corrected.first -= deviation.first / count;
+      corrected.second -= deviation.second / count;
+    }
+
+    const Label label = round(corrected);
+    const double r = residual(corrected, label);
+    if (i!=seedPosition && r>=Tolerance) continue;
+
+    accepted[i] = true;
+    labels[i] = label;
+    deviations[i] = Vector(u.first - label.first, u.second - label.second);
+
+    // keep the closest point per lattice site
+    SiteMap::iterator site = sites.find(label);
+    if (site==sites.end()) {
+      sites[label] = std::pair<double,size_t>(r, i);
+    } else if (site->second.second!=seedPosition && (i==seedPosition || r<site->second.first)) {
+      site->second = std::pair<double,size_t>(r, i);
+    }
+  }
+
+  // the seed defines the origin
+  const Label origin = labels[seedPosition];
+
+  for (SiteMap::const_iterator it = sites.begin();
+       it != sites.end();
+       ++it) {
+    (*points)[it->second.second].setIndex(it->first.first - origin.first,
+                                          origin.second - it->first.second);
+  }
+
+  DefoPointCollection& pointsRef = *points;
+  std::sort(pointsRef.begin(), pointsRef.end());
+}
+
+DefoPoint * DefoLatticePointIndexer::findSeed(DefoPointCollection* points, const QColor& seedColor)
+{
+  DefoPoint * temp = 0;
+  for (DefoPointCollection::iterator it = points->begin();
+       it != points->end();
+       ++it) {
+    if (it->hasReferenceColor(seedColor)) {
+      temp = &(*it);
+    }
+  }
+
+  return temp;
+}
+
+long long DefoLatticePointIndexer::cellKey(int ix, int iy)
+{
+  return (static_cast<long long>(ix) << 32) ^ static_cast<unsigned int>(iy);
+}
+
+DefoLatticePointIndexer::Vector DefoLatticePointIndexer::evaluate(const Mapping_t& mapping,
+                                                                  const Vector& q)
+{
+  const double f[6] = { 1., q.first, q.second,
+                        q.first * q.first, q.first * q.second, q.second * q.second };
+  Vector u(0., 0.);
+  for (int k=0;k<6;++k) {
+    u.first  += mapping.c[0][k] * f[k];
+    u.second += mapping.c[1][k] * f[k];
+  }
+  return u;
+}
+
+DefoLatticePointIndexer::Label DefoLatticePointIndexer::round(const Vector& u)
+{
+  return Label(static_cast<int>(std::floor(u.first + 0.5)),
+               static_cast<int>(std::floor(u.second + 0.5)));
+}
+
+double DefoLatticePointIndexer::residual(const Vector& u, const Label& label)
+{
+  return std::max(std::fabs(u.first - label.first), std::fabs(u.second - label.second));
+}
+
+/**
+  Rough pitch from the area covered by the central 90% of the points
+  along each axis; only used to set the ranges of the lattice search.
+  */
+double DefoLatticePointIndexer::estimateScale(const std::vector<Vector>& positions) const
+{
+  const size_t n = positions.size();
+  if (n<3) return 0;
+
+  std::vector<double> x, y;
+  x.reserve(n);
+  y.reserve(n);
+  for (std::vector<Vector>::const_iterator it = positions.begin();
+       it != positions.end();
+       ++it) {
+    x.push_back(it->first);
+    y.push_back(it->second);
+  }
+
+  const size_t low = n / 20;
+  const size_t high = n - 1 - n / 20;
+
+  std::nth_element(x.begin(), x.begin() + low, x.end());
+  const double xlow = x[low];
+  std::nth_element(x.begin(), x.begin() + high, x.end());
+  const double xhigh = x[high];
+  std::nth_element(y.begin(), y.begin() + low, y.end());
+  const double ylow = y[low];
+  std::nth_element(y.begin(), y.begin() + high, y.end());
+  const double yhigh = y[high];
+
+  const double fraction = static_cast<double>(high - low) / n;
+  const double area = (xhigh - xlow) * (yhigh - ylow);
+  if (area<=0) return 0;
+
+  return std::sqrt(area / (n * fraction * fraction));
+}
+
+/**
+  Histograms the difference vectors of all point pairs closer than twice
+  the scale, using a hash of cells of one scale, and takes the shortest
+  two non-parallel peaks. Both signs of each difference are filled, so
+  the histogram is the short range autocorrelation of the point set.
+  */
+bool DefoLatticePointIndexer::estimateLattice(const std::vector<Vector>& positions,
+                                              double scale,
+                                              Vector& ax, Vector& ay) const
+{
+  const int nBins = 33;
+  const double range = 2. * scale;
+  const double binWidth = 2. * range / nBins;
+
+  std::unordered_map<long long,std::vector<size_t> > cells;
+  for (size_t i=0;i<positions.size();++i) {
+    cells[cellKey(static_cast<int>(std::floor(positions[i].first / scale)),
+                  static_cast<int>(std::floor(positions[i].second / scale)))].push_back(i);
+  }
+
+  std::vector<double> histogram(nBins * nBins, 0.);
+  std::vector<Vector> differences;
+
+  for (size_t i=0;i<positions.size();++i) {
+    const int ix = static_cast<int>(std::floor(positions[i].first / scale));
+    const int iy = static_cast<int>(std::floor(positions[i].second / scale));
+
+    for (int cx=ix-2;cx<=ix+2;++cx) {
+      for (int cy=iy-2;cy<=iy+2;++cy) {
+        std::unordered_map<long long,std::vector<size_t> >::const_iterator it = cells.find(cellKey(cx, cy));
+        if (it==cells.end()) continue;
+
+        for (std::vector<size_t>::const_iterator j = it->second.begin();
+             j != it->second.end();
+             ++j) {
+          if (*j<=i) continue;
+
+          const Vector d(positions[*j].first - positions[i].first,
+                         positions[*j].second - positions[i].second);
+          const double length = std::hypot(d.first, d.second);
+          if (length<MinDistance*scale || length>=range) continue;
+
+          differences.push_back(d);
+          for (int sign=-1;sign<=1;sign+=2) {
+            const int bx = static_cast<int>(std::floor((sign * d.first + range) / binWidth));
+            const int by = static_cast<int>(std::floor((sign * d.second + range) / binWidth));
+            if (bx<0 || bx>=nBins || by<0 || by>=nBins) continue;
+            histogram[by * nBins + bx] += 1.;
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<double> smoothed(nBins * nBins, 0.);
+  double maximum = 0;
+  for (int by=1;by<nBins-1;++by) {
+    for (int bx=1;bx<nBins-1;++bx) {
+      double sum = 0;
+      for (int k=-1;k<=1;++k) {
+        for (int l=-1;l<=1;++l) sum += histogram[(by + k) * nBins + bx + l];
+      }
+      smoothed[by * nBins + bx] = sum;
+      maximum = std::max(maximum, sum);
+    }
+  }
+  if (maximum<=0) return false;
+
+  // local maxima; neighbours and diagonals of a square lattice are equally
+  // populated, the lattice vectors are the shortest of them
+  std::vector<std::pair<double,Vector> > peaks;
+  for (int by=1;by<nBins-1;++by) {
+    for (int bx=1;bx<nBins-1;++bx) {
+      const double value = smoothed[by * nBins + bx];
+      if (value<0.5*maximum) continue;
+
+      bool isMaximum = true;
+      for (int k=-1;k<=1 && isMaximum;++k) {
+        for (int l=-1;l<=1;++l) {
+          if (smoothed[(by + k) * nBins + bx + l]>value) {
+            isMaximum = false;
+            break;
+          }
+        }
+      }
+      if (!isMaximum) continue;
+
+      const Vector centre((bx + 0.5) * binWidth - range, (by + 0.5) * binWidth - range);
+      const double length = std::hypot(centre.first, centre.second);
+      if (length<MinDistance*scale) continue;
+      peaks.push_back(std::pair<double,Vector>(length, centre));
+    }
+  }
+  if (peaks.empty()) return false;
+
+  std::sort(peaks.begin(), peaks.end());
+
+  ax = refinePeak(differences, peaks.front().second);
+  const double lx = std::hypot(ax.first, ax.second);
+
+  bool found = false;
+  for (std::vector<std::pair<double,Vector> >::const_iterator it = peaks.begin();
+       it != peaks.end();
+       ++it) {
+    const Vector& p = it->second;
+    const double cross = ax.first * p.second - ax.second * p.first;
+    if (std::fabs(cross)>0.5*lx*it->first) {
+      ay = refinePeak(differences, p);
+      found = true;
+      break;
+    }
+  }
+  if (!found) return false;
+
+  // the vector closer to the image x axis runs along the first index
+  const double ly = std::hypot(ay.first, ay.second);
+  if (std::fabs(ay.first)*lx>std::fabs(ax.first)*ly) std::swap(ax, ay);
+  if (ax.first<0) ax = Vector(-ax.first, -ax.second);
+  if (ay.second<0) ay = Vector(-ay.first, -ay.second);
+
+  return true;
+}
+
+/// mean of the difference vectors of either sign close to the peak
+DefoLatticePointIndexer::Vector DefoLatticePointIndexer::refinePeak(const std::vector<Vector>& differences,
+                                                                    const Vector& peak)
+{
+  const double radius = 0.25 * std::hypot(peak.first, peak.second);
+
+  Vector sum(0., 0.);
+  int count = 0;
+  for (std::vector<Vector>::const_iterator it = differences.begin();
+       it != differences.end();
+       ++it) {
+    for (int sign=-1;sign<=1;sign+=2) {
+      const double dx = sign * it->first - peak.first;
+      const double dy = sign * it->second - peak.second;
+      if (std::hypot(dx, dy)<radius) {
+        sum.first += sign * it->first;
+        sum.second += sign * it->second;
+        count++;
+      }
+    }
+  }
+
+  if (count==0) return peak;
+  return Vector(sum.first / count, sum.second / count);
+}
+
+/**
+  Least squares fit of the first nParameters terms of the mapping to the
+  labels of the selected points; false if the points do not constrain it.
+  */
+bool DefoLatticePointIndexer::fitMapping(const std::vector<Vector>& q,
+                                         const std::vector<Label>& labels,
+                                         const std::vector<size_t>& selection,
+                                         int nParameters,
+                                         Mapping_t& mapping) const
+{
+  if (static_cast<int>(selection.size())<nParameters) return false;
+
+  // normal equations with the right hand sides of both indices
+  double A[6][8] = { { 0 } };
+  for (std::vector<size_t>::const_iterator it = selection.begin();
+       it != selection.end();
+       ++it) {
+    const Vector& p = q[*it];
+    const double f[6] = { 1., p.first, p.second,
+                          p.first * p.first, p.first * p.second, p.second * p.second };
+    for (int r=0;r<nParameters;++r) {
+      for (int c=0;c<nParameters;++c) A[r][c] += f[r] * f[c];
+      A[r][6] += f[r] * labels[*it].first;
+      A[r][7] += f[r] * labels[*it].second;
+    }
+  }
+
+  // gauss-jordan elimination with partial pivoting
+  for (int c=0;c<nParameters;++c) {
+    int pivot = c;
+    for (int r=c+1;r<nParameters;++r) {
+      if (std::fabs(A[r][c])>std::fabs(A[pivot][c])) pivot = r;
+    }
+    if (std::fabs(A[pivot][c])<1.e-9) return false;
+    if (pivot!=c) {
+      for (int k=0;k<8;++k) std::swap(A[c][k], A[pivot][k]);
+    }
+    for (int r=0;r<nParameters;++r) {
+      if (r==c) continue;
+      const double factor = A[r][c] / A[c][c];
+      for (int k=c;k<8;++k) A[r][k] -= factor * A[c][k];
+    }
+  }
+
+  for (int k=0;k<6;++k) {
+    mapping.c[0][k] = (k<nParameters) ? A[k][6] / A[k][k] : 0.;
+    mapping.c[1][k] = (k<nParameters) ? A[k][7] / A[k][k] : 0.;
+  }
+
+  return true;
+}
+
+/**
+  RANSAC over affine mappings through three selected points; returns the
+  selected points consistent with the best mapping.
+  */
+std::vector<size_t> DefoLatticePointIndexer::findConsensus(const std::vector<Vector>& q,
+                                                           const std::vector<Label>& labels,
+                                                           const std::vector<size_t>& selection)
+{
+  if (selection.size()<3) return selection;
+
+  std::uniform_int_distribution<size_t> pick(0, selection.size() - 1);
+  std::vector<size_t> best;
+
+  for (int iteration=0;iteration<RansacIterations;++iteration) {
+    std::vector<size_t> sample(3);
+    for (int k=0;k<3;++k) sample[k] = selection[pick(random_)];
+    if (sample[0]==sample[1] || sample[0]==sample[2] || sample[1]==sample[2]) continue;
+
+    Mapping_t hypothesis;
+    if (!fitMapping(q, labels, sample, 3, hypothesis)) continue;
+
+    std::vector<size_t> inliers;
+    for (std::vector<size_t>::const_iterator it = selection.begin();
+         it != selection.end();
+         ++it) {
+      if (residual(evaluate(hypothesis, q[*it]), labels[*it])<Tolerance) inliers.push_back(*it);
+    }
+
+    if (inliers.size()>best.size()) best.swap(inliers);
+  }
+
+  return best;
+}
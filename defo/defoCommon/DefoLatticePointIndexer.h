@@ -0,0 +1,86 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef DEFOLATTICEPOINTINDEXER_H
+#define DEFOLATTICEPOINTINDEXER_H
+
+#include <vector>
+#include <random>
+
+#include "DefoVPointIndexer.h"
+#include "DefoPoint.h"
+
+/**
+  \brief Indexer fitting a smooth lattice to the whole point set.
+  \par The two lattice vectors are estimated from the peaks of the
+  autocorrelation of the point positions, i.e. a histogram of the
+  difference vectors between neighbouring points. The mapping from
+  image position to fractional grid index is then refined in stages of
+  growing radius around the seed: in each stage all points inside the
+  radius are labelled with the rounded index of the current mapping and
+  a quadratic mapping is fitted to the points consistent with it. In the
+  first stage the consistent points are selected by RANSAC of affine
+  mappings, so that spurious points and a poor lattice estimate near the
+  seed cannot bias the fit. Finally the points are indexed in order of
+  distance from the seed, correcting the mapping by the mean deviation of
+  the already indexed neighbours; points farther than 0.3 pitch from a
+  lattice site, and all but the closest point of a site, stay unindexed.
+  \par Missing or spurious points only remove themselves from the fit, and
+  the quadratic terms and the neighbour correction absorb lens distortion
+  and warping of the module.
+  The indices follow the convention of DefoPropagationPointIndexer.
+  */
+class DefoLatticePointIndexer : public DefoVPointIndexer
+{
+  Q_OBJECT
+public:
+
+  explicit DefoLatticePointIndexer(QObject *parent = 0);
+
+  void indexPoints(DefoPointCollection* points, const QColor& seedColor);
+
+protected:
+
+  typedef std::pair<double,double> Vector;
+  typedef std::pair<int,int> Label;
+
+  /// fractional index u = sum c[0][k] f_k(q), v = sum c[1][k] f_k(q)
+  /// with f = (1, qx, qy, qx^2, qx qy, qy^2)
+  typedef struct {
+    double c[2][6];
+  } Mapping_t;
+
+  static long long cellKey(int ix, int iy);
+  static Vector evaluate(const Mapping_t& mapping, const Vector& q);
+  static Label round(const Vector& u);
+  static double residual(const Vector& u, const Label& label);
+  static Vector refinePeak(const std::vector<Vector>& differences, const Vector& peak);
+
+  DefoPoint * findSeed(DefoPointCollection* points, const QColor& seedColor);
+  double estimateScale(const std::vector<Vector>& positions) const;
+  bool estimateLattice(const std::vector<Vector>& positions, double scale,
+                       Vector& ax, Vector& ay) const;
+
+  bool fitMapping(const std::vector<Vector>& q,
+                  const std::vector<Label>& labels,
+                  const std::vector<size_t>& selection,
+                  int nParameters,
+                  Mapping_t& mapping) const;
+  std::vector<size_t> findConsensus(const std::vector<Vector>& q,
+                                    const std::vector<Label>& labels,
+                                    const std::vector<size_t>& selection);
+
+  std::mt19937 random_;
+};
+
+#endif // DEFOLATTICEPOINTINDEXER_H
@@ -11,17 +11,22 @@
 /////////////////////////////////////////////////////////////////////////////////
 
 #include <nqlogger.h>
+#include <nqimage.h>
 
 #include <QFile>
+#include <QImageReader>
 #include <QXmlStreamWriter>
 
 #include "DefoExifReader.h"
 #include "DefoImageAverager.h"
+#include "DefoImageCache.h"
 
 #include "DefoMeasurement.h"
 
 DefoMeasurement::DefoMeasurement(const QDateTime& timestamp)
   : timestamp_(timestamp),
+    width_(-1),
+    height_(-1),
     previewImage_(false)
 {
 
@@ -29,6 +34,8 @@ DefoMeasurement::DefoMeasurement(const QDateTime& timestamp)
 
 DefoMeasurement::DefoMeasurement(const QString& imageLocation, bool preview)
   : timestamp_(QDateTime::currentDateTime().toUTC()),
+    width_(-1),
+    height_(-1),
     previewImage_(preview)
 {
   imageLocations_.append(imageLocation);
@@ -38,37 +45,67 @@ DefoMeasurement::DefoMeasurement(const QString& imageLocation, bool preview)
 DefoMeasurement::DefoMeasurement(const QStringList& imageLocations)
   : timestamp_(QDateTime::currentDateTime().toUTC()),
     imageLocations_(imageLocations),
+    width_(-1),
+    height_(-1),
     previewImage_(false)
 {
   readImages();
 }
 
+/**
+  Constructs a measurement from an image that was already decoded in memory.
+  The image stays resident until an image location is set, after which it is
+  handed to the DefoImageCache and may be reloaded from that location.
+  */
+DefoMeasurement::DefoMeasurement(const QImage& image, bool preview)
+  : timestamp_(QDateTime::currentDateTime().toUTC()),
+    previewImage_(preview)
+{
+  image_ = NQImage::rotate90(image);
+  width_ = image_.width();
+  height_ = image_.height();
+}
+
+DefoMeasurement::~DefoMeasurement()
+{
+  DefoImageCache::instance()->remove(this);
+}
+
+/**
+  Reads the image dimensions from the file header. The pixel data is only
+  decoded on demand through getImage().
+  */
 void DefoMeasurement::readImages()
 {
   NQLogMessage("DefoMeasurement") << "readImages " << imageLocations_.size();
 
+  if (imageLocations_.size()==0 || !image_.isNull()) return;
+
+  QImageReader reader(imageLocations_.front());
+  QSize size = reader.size();
+
+  // images are rotated by 90 degrees
+  width_ = size.height();
+  height_ = size.width();
+}
+
+/// Decodes and rotates the image(s); used by DefoImageCache.
+QImage DefoMeasurement::loadImage() const
+{
+  NQLogMessage("DefoMeasurement") << "loadImage " << imageLocations_.size();
+
   if (imageLocations_.size()==0) {
 
-    return;
+    return QImage();
 
   } else if (imageLocations_.size()==1) {
 
-    if (image_.isNull()) {
-      QImage temp(imageLocations_.front());
-      QMatrix matrix;
-      matrix.rotate(90);
-      image_ = temp.transformed(matrix);
-    }
+    return NQImage::rotate90(QImage(imageLocations_.front()));
 
   } else {
 
-    if (image_.isNull()) {
-      DefoImageAverager averager(imageLocations_);
-      QImage temp(averager.getAveragedImage());
-      QMatrix matrix;
-      matrix.rotate(90);
-      image_ = temp.transformed(matrix);
-    }
+    DefoImageAverager averager(imageLocations_);
+    return averager.getRotatedAveragedImage();
 
   }
 }
@@ -85,28 +122,43 @@ const QDateTime & DefoMeasurement::getTimeStamp() const
 
 QImage DefoMeasurement::getImage() const
 {
-  return image_;
+  if (!image_.isNull()) return image_;
+  return DefoImageCache::instance()->getImage(this);
 }
 
 int DefoMeasurement::getWidth() const
 {
-  return image_.width();
+  if (width_<0) return getImage().width();
+  return width_;
 }
 
 int DefoMeasurement::getHeight() const
 {
-  return image_.height();
+  if (height_<0) return getImage().height();
+  return height_;
 }
 
-void DefoMeasurement::setImageLocation(const QString& imageLocation)
+void DefoMeasurement::setImageLocation(const QString& imageLocation,
+                                       const std::shared_future<bool>& pendingWrite)
 {
   imageLocations_.clear();
   imageLocations_.append(imageLocation);
+  releaseImage(pendingWrite);
 }
 
 void DefoMeasurement::setImageLocations(const QStringList& imageLocations)
 {
   imageLocations_ = imageLocations;
+  releaseImage();
+}
+
+/// Moves a resident image into the cache once it can be reloaded.
+void DefoMeasurement::releaseImage(const std::shared_future<bool>& pendingWrite)
+{
+  if (image_.isNull() || imageLocations_.isEmpty()) return;
+
+  DefoImageCache::instance()->insert(this, image_, pendingWrite);
+  image_ = QImage();
 }
 
 void DefoMeasurement::readExifData()
@@ -121,6 +173,18 @@ void DefoMeasurement::readExifData()
   exifISO_ = reader.getLongValue("Exif.Photo.ISOSpeedRatings");
 }
 
+void DefoMeasurement::readExifData(const QByteArray& imageData)
+{
+  DefoExifReader reader(imageData);
+  reader.read();
+
+  exifFocalLength_ = reader.getFloatValue("Exif.Photo.FocalLength");
+  exifExposureTime_ = reader.getFloatValue("Exif.Photo.ExposureTime");
+  exifExposureTimeString_ = reader.getStringValue("Exif.Photo.ExposureTime");
+  exifAperture_ = reader.getLongValue("Exif.Photo.FNumber");
+  exifISO_ = reader.getLongValue("Exif.Photo.ISOSpeedRatings");
+}
+
 void DefoMeasurement::acquireData(const DefoCameraModel* model)
 {
   comment_ = model->commentDocument()->toPlainText();
@@ -14,6 +14,7 @@
 #define _DEFOMEASUREMENT_H
 
 #include <utility>
+#include <future>
 
 #include <QDateTime>
 #include <QImage>
@@ -40,6 +41,8 @@ public:
   DefoMeasurement(const QDateTime& timestamp);
   DefoMeasurement(const QString& imageLocation, bool preview);
   DefoMeasurement(const QStringList& imageLocations);
+  DefoMeasurement(const QImage& image, bool preview);
+  virtual ~DefoMeasurement();
 
   bool isPreview() const { return previewImage_; }
 
@@ -71,9 +74,13 @@ public:
   const QString& getComment() const { return comment_; }
   int getCalibAmplitude() const { return calibAmplitude_; }
 
-  void setImageLocation(const QString& imageLocation);
+  /// pendingWrite: background write of the file; until it finished the
+  /// image is kept in memory
+  void setImageLocation(const QString& imageLocation,
+                        const std::shared_future<bool>& pendingWrite = std::shared_future<bool>());
   void setImageLocations(const QStringList& imageLocations);
   void readExifData();
+  void readExifData(const QByteArray& imageData);
   void acquireData(const DefoCameraModel* model);
   void acquireData(const DefoPointRecognitionModel* model);
   void acquireData(const DefoConradModel* model);
@@ -84,15 +91,21 @@ public:
   virtual void read(const QDir&path);
 
   void readImages();
+  QImage loadImage() const;
 
 protected:
 
+  void releaseImage(const std::shared_future<bool>& pendingWrite = std::shared_future<bool>());
+
   /// (Local) date and time of measurement.
   QDateTime timestamp_;
   /// Image of the actual 'raw' measurement.
   QStringList imageLocations_;
 
+  /// Image that cannot be reloaded from imageLocations_; otherwise see DefoImageCache.
   QImage image_;
+  int width_;
+  int height_;
 
   bool previewImage_;
 
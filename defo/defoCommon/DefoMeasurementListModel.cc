@@ -15,6 +15,7 @@
 #include <QXmlStreamReader>
 #include <QProcess>
 
+#include "DefoPointFile.h"
 #include "DefoMeasurementListModel.h"
 
 DefoMeasurementListModel::DefoMeasurementListModel(QObject *parent) :
@@ -90,6 +91,13 @@ void DefoMeasurementListModel::setMeasurementPoints(
   if ( points_.find(measurement) == points_.end() )
     addMeasurement(measurement);
 
+  // A merged collection that is replaced is no longer referenced by the model
+  MergerMap::iterator it = mergers_.find(measurement);
+  if ( it != mergers_.end() && it->second->getPoints() != points ) {
+    delete it->second;
+    mergers_.erase(it);
+  }
+
   points_[measurement] = points;
   emit pointsUpdated(measurement);
 
@@ -97,9 +105,10 @@ void DefoMeasurementListModel::setMeasurementPoints(
 
 /**
   Append the collection of points to the current collection of points.
-  This is equivalent to calling getMeasurementPoints, adding points to a copy
-  of that collection and then calling setMeasurementPoints with the extended
-  copy, but this function makes the whole proces thread safe.
+  Invalid points and points closer than one pixel to a point already in the
+  collection are dropped. The first call copies the current collection into a
+  DefoPointMerger owned by the model; subsequent calls append to the merged
+  collection in place, without copying the points merged before.
   */
 void DefoMeasurementListModel::appendMeasurementPoints(
     DefoMeasurement *measurement
@@ -110,51 +119,25 @@ void DefoMeasurementListModel::appendMeasurementPoints(
 
   if ( points != NULL ) {
 
-    const DefoPointCollection* currentList = getMeasurementPoints(measurement);
-    DefoPointCollection* newPoints;
-    
-    if ( currentList != NULL ) {
-      newPoints = new DefoPointCollection(*currentList);
-    } else {
-      newPoints = new DefoPointCollection();
-    }
-    
-    // Insert given points
-    newPoints->insert(newPoints->end(), points->begin(), points->end());
-
-    cleanupPoints(newPoints);
+    MergerMap::iterator it = mergers_.find(measurement);
 
-    // Set new points
-    setMeasurementPoints(measurement, newPoints);
-  }
-}
+    if ( it != mergers_.end() ) {
+      it->second->append(*points);
+      emit pointsUpdated(measurement);
+    } else {
+      const DefoPointCollection* currentList = getMeasurementPoints(measurement);
+      DefoPointMerger* merger;
 
-void DefoMeasurementListModel::cleanupPoints(DefoPointCollection* points)
-{
-  double d;
-  for (DefoPointCollection::iterator it1 = points->begin();
-       it1 != points->end();
-       ++it1) {
-    if ((*it1).isValid()==false) continue;
-
-    for (DefoPointCollection::iterator it2 = it1+1;
-         it2 != points->end();
-         ++it2) {
-      if ((*it2).isValid()==false) continue;
-
-      d = it1->getDistance(*it2);
-      if (d<1.0) {
-        (*it2).setValid(false);
+      if ( currentList != NULL ) {
+        merger = new DefoPointMerger(*currentList);
+      } else {
+        merger = new DefoPointMerger();
       }
-    }
-  }
 
-  for (DefoPointCollection::iterator it1 = points->begin();
-       it1 != points->end();) {
-    if ((*it1).isValid()==false) {
-      points->erase(it1);
-    } else {
-      ++it1;
+      merger->append(*points);
+
+      setMeasurementPoints(measurement, merger->getPoints());
+      mergers_[measurement] = merger;
     }
   }
 }
@@ -221,9 +204,13 @@ void DefoMeasurementListModel::exportMeasurement(const QDir& path, const QString
   QDir::temp().rmdir(dirName);
 }
 
+/**
+  Writes the points of all measurements as binary point files
+  (points_<timestamp>.dpts, see DefoPointFile).
+  */
 void DefoMeasurementListModel::writePoints(const QDir& path)
 {
-  QString filename = "points_%1.xml";
+  QString filename = "points_%1" + DefoPointFile::BinarySuffix;
   for (int i = 0; i < this->getMeasurementCount(); ++i) {
     DefoMeasurement* measurement = this->getMeasurement(i);
     if (measurement->isPreview()) continue;
@@ -233,50 +220,16 @@ void DefoMeasurementListModel::writePoints(const QDir& path)
 
     QString fileLocation = path.absoluteFilePath(filename.arg(measurement->getTimeStamp().toString("yyyyMMddhhmmss")));
 
-    QFile file(fileLocation);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
-      continue;
-
-    QXmlStreamWriter stream(&file);
-    stream.setAutoFormatting(true);
-    stream.writeStartDocument();
-
-    stream.writeStartElement("DefoPoints");
-    stream.writeAttribute("count", QString().setNum(points->size()));
-
-    for (DefoPointCollection::const_iterator it = points->begin();
-         it != points->end();
-         ++it) {
-      stream.writeStartElement("DefoPoint");
-      stream.writeAttribute("x", QString().setNum(it->getX(), 'e', 6));
-      stream.writeAttribute("y", QString().setNum(it->getY(), 'e', 6));
-      float h, s ,v;
-      QColor c = it->getColor();
-      h = c.hsvHueF();
-      s = c.hsvSaturationF();
-      v = c.valueF();
-      stream.writeAttribute("H", QString().setNum(h, 'e', 6));
-      stream.writeAttribute("S", QString().setNum(s, 'e', 6));
-      stream.writeAttribute("V", QString().setNum(v, 'e', 6));
-
-      stream.writeAttribute("indexed", QString().setNum(it->isIndexed()));
-      if (it->isIndexed()) {
-        stream.writeAttribute("ix", QString().setNum(it->getIndex().first));
-        stream.writeAttribute("iy", QString().setNum(it->getIndex().second));
-      }
-
-      stream.writeEndElement();
-    }
-
-    stream.writeEndElement();
-
-    stream.writeEndDocument();
+    DefoPointFile::write(fileLocation, *points);
   }
 }
 
 void DefoMeasurementListModel::clear() {
   measurementList_.clear();
   points_.clear();
+  for (MergerMap::iterator it = mergers_.begin(); it != mergers_.end(); ++it)
+    delete it->second;
+  mergers_.clear();
   emit measurementCountChanged(0);
 }
 
@@ -309,48 +262,20 @@ void DefoMeasurementListModel::read(const QString& filename) {
   }
 }
 
+/**
+  Reads the points of all measurements from binary point files, falling back
+  to points_<timestamp>.xml written by earlier versions.
+  */
 void DefoMeasurementListModel::readPoints(const QDir& path)
 {
-  QString filename = "points_%1.xml";
+  QString basename = "points_%1";
   for (int i = 0; i < this->getMeasurementCount(); ++i) {
     DefoMeasurement* measurement = this->getMeasurement(i);
     if (measurement->isPreview()) continue;
 
-    QString fileLocation = path.absoluteFilePath(filename.arg(measurement->getTimeStamp().toString("yyyyMMddhhmmss")));
-
-    QFile file(fileLocation);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-      continue;
-
     DefoPointCollection* points = new DefoPointCollection;
 
-    QXmlStreamReader stream(&file);
-    while (!stream.atEnd()) {
-      stream.readNextStartElement();
-      if (stream.isStartElement() && stream.name()=="DefoPoint") {
-        double x = stream.attributes().value("x").toString().toDouble();
-        double y = stream.attributes().value("y").toString().toDouble();
-        float H = stream.attributes().value("H").toString().toFloat();
-        float S = stream.attributes().value("S").toString().toFloat();
-        float V = stream.attributes().value("V").toString().toFloat();
-        DefoPoint p(x, y);
-        QColor c;
-        c.setHsvF(H, S, V);
-        p.setColor(c);
-
-        p.setValid(true);
-
-        bool indexed = (stream.attributes().value("indexed").toString().toInt()==1);
-        p.unindex();
-        if (indexed) {
-          int ix = stream.attributes().value("ix").toString().toInt();
-          int iy = stream.attributes().value("iy").toString().toInt();
-          p.setIndex(ix, iy);
-        }
-
-        points->push_back(p);
-      }
-    }
+    DefoPointFile::read(path, basename.arg(measurement->getTimeStamp().toString("yyyyMMddhhmmss")), *points);
 
     if (points->size()==0) {
       delete points;
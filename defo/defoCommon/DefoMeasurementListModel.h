@@ -21,6 +21,7 @@
 #include <QDir>
 
 #include "DefoMeasurement.h"
+#include "DefoPointMerger.h"
 
 class DefoMeasurementListModel : public QObject
 {
@@ -63,7 +64,9 @@ protected:
   typedef std::map<DefoMeasurement*, const DefoPointCollection*> PointMap;
   PointMap points_;
 
-  void cleanupPoints(DefoPointCollection* points);
+  // Merged collections built by appendMeasurementPoints, owned by the model
+  typedef std::map<DefoMeasurement*, DefoPointMerger*> MergerMap;
+  MergerMap mergers_;
 
   // For thread safety
   QMutex mutex_;
@@ -10,11 +10,14 @@
 //                                                                             //
 /////////////////////////////////////////////////////////////////////////////////
 
+#include "DefoImageCache.h"
+#include "DefoMeasurementListModel.h"
 #include "DefoMeasurementSelectionModel.h"
 
 DefoMeasurementSelectionModel::DefoMeasurementSelectionModel(QObject *parent)
 : QObject(parent),
-  selection_(NULL)
+  selection_(NULL),
+  listModel_(NULL)
 {
 
 }
@@ -29,15 +32,39 @@ DefoMeasurement * DefoMeasurementSelectionModel::getSelection()
   return selection_;
 }
 
+/**
+  If a list model is set, the image of the measurement following the current
+  selection in the list is decoded in the background whenever the selection
+  changes.
+  */
+void DefoMeasurementSelectionModel::setListModel(const DefoMeasurementListModel* listModel)
+{
+  listModel_ = listModel;
+}
+
 void DefoMeasurementSelectionModel::setSelection(DefoMeasurement *selection)
 {
   if (selection_ != selection) {
     selection_ = selection;
     emit selectionChanged(selection_);
+    prefetchNext();
   }
 
 }
 
+void DefoMeasurementSelectionModel::prefetchNext()
+{
+  if (listModel_ == NULL || selection_ == NULL) return;
+
+  int count = listModel_->getMeasurementCount();
+  for (int i = 0; i < count - 1; ++i) {
+    if (listModel_->getMeasurement(i) == selection_) {
+      DefoImageCache::instance()->prefetch(listModel_->getMeasurement(i+1));
+      return;
+    }
+  }
+}
+
 DefoMeasurementPairSelectionModel::DefoMeasurementPairSelectionModel(QObject *parent)
   : QObject(parent),
     selection_(NULL)
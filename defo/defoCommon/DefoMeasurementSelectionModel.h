@@ -16,6 +16,8 @@
 #include <QObject>
 #include "DefoMeasurement.h"
 
+class DefoMeasurementListModel;
+
 class DefoMeasurementSelectionModel : public QObject
 {
   Q_OBJECT
@@ -25,6 +27,8 @@ public:
   DefoMeasurement* getSelection();
   DefoMeasurement* getSelection() const;
 
+  void setListModel(const DefoMeasurementListModel* listModel);
+
 public slots:
 
   void setSelection(DefoMeasurement* selection);
@@ -32,6 +36,9 @@ public slots:
 protected:
 
   DefoMeasurement* selection_;
+  const DefoMeasurementListModel* listModel_;
+
+  void prefetchNext();
 
 signals:
 
@@ -0,0 +1,268 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+#include <QFile>
+#include <QDataStream>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+#include <nqlogger.h>
+
+#include "DefoPointFile.h"
+
+const QString DefoPointFile::BinarySuffix = ".dpts";
+const QString DefoPointFile::XMLSuffix = ".xml";
+
+namespace {
+
+  // bytes per point: x, y, H, S, V, ix, iy, indexed, valid
+  const int PointSize = 8 + 8 + 4 + 4 + 4 + 4 + 4 + 1 + 1;
+
+  /// converts a column between host and little endian byte order in place
+  template <class T> void swapToLittleEndian(std::vector<T>& column) {
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    for (T& value : column) {
+      char* bytes = reinterpret_cast<char*>(&value);
+      std::reverse(bytes, bytes + sizeof(T));
+    }
+#else
+    Q_UNUSED(column);
+#endif
+  }
+
+  template <class T> void appendColumn(char*& dst, std::vector<T>& column) {
+    if (column.empty()) return;
+    swapToLittleEndian(column);
+    std::memcpy(dst, column.data(), column.size()*sizeof(T));
+    dst += column.size()*sizeof(T);
+  }
+
+  template <class T> void extractColumn(const char*& src, std::vector<T>& column) {
+    if (column.empty()) return;
+    std::memcpy(column.data(), src, column.size()*sizeof(T));
+    src += column.size()*sizeof(T);
+    swapToLittleEndian(column);
+  }
+}
+
+bool DefoPointFile::write(const QString& location, const DefoPointCollection& points,
+                          bool compress)
+{
+  QFile file(location);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    NQLogWarning("DefoPointFile") << "could not open " << location << " for writing";
+    return false;
+  }
+
+  const quint32 count = points.size();
+
+  std::vector<double> x(count), y(count);
+  std::vector<float> h(count), s(count), v(count);
+  std::vector<qint32> ix(count), iy(count);
+  std::vector<quint8> indexed(count), valid(count);
+
+  for (quint32 i=0;i<count;++i) {
+    const DefoPoint& point = points[i];
+    x[i] = point.getX();
+    y[i] = point.getY();
+    QColor c = point.getColor();
+    h[i] = c.hsvHueF();
+    s[i] = c.hsvSaturationF();
+    v[i] = c.valueF();
+    ix[i] = point.getIndex().first;
+    iy[i] = point.getIndex().second;
+    indexed[i] = point.isIndexed();
+    valid[i] = point.isValid();
+  }
+
+  QByteArray payload(count*PointSize, 0);
+  char* dst = payload.data();
+  appendColumn(dst, x);
+  appendColumn(dst, y);
+  appendColumn(dst, h);
+  appendColumn(dst, s);
+  appendColumn(dst, v);
+  appendColumn(dst, ix);
+  appendColumn(dst, iy);
+  appendColumn(dst, indexed);
+  appendColumn(dst, valid);
+
+  QDataStream stream(&file);
+  stream.setByteOrder(QDataStream::LittleEndian);
+  stream << Magic << Version << (compress ? FlagCompressed : quint16(0))
+         << count << quint32(payload.size());
+
+  if (compress) payload = qCompress(payload);
+  stream.writeRawData(payload.constData(), payload.size());
+
+  return stream.status()==QDataStream::Ok;
+}
+
+bool DefoPointFile::read(const QString& location, DefoPointCollection& points)
+{
+  points.clear();
+
+  QFile file(location);
+  if (!file.open(QIODevice::ReadOnly)) return false;
+
+  if (file.peek(4)=="DPTS") return readBinary(&file, points);
+
+  return readXML(&file, points);
+}
+
+bool DefoPointFile::read(const QDir& dir, const QString& basename, DefoPointCollection& points)
+{
+  QString location = dir.absoluteFilePath(basename + BinarySuffix);
+  if (QFile::exists(location)) return read(location, points);
+
+  return read(dir.absoluteFilePath(basename + XMLSuffix), points);
+}
+
+bool DefoPointFile::exists(const QDir& dir, const QString& basename)
+{
+  return dir.exists(basename + BinarySuffix) || dir.exists(basename + XMLSuffix);
+}
+
+bool DefoPointFile::readBinary(QIODevice* device, DefoPointCollection& points)
+{
+  QDataStream stream(device);
+  stream.setByteOrder(QDataStream::LittleEndian);
+
+  quint32 magic, count, payloadSize;
+  quint16 version, flags;
+  stream >> magic >> version >> flags >> count >> payloadSize;
+
+  if (stream.status()!=QDataStream::Ok || magic!=Magic) return false;
+  if (version>Version) {
+    NQLogWarning("DefoPointFile") << "unsupported point file version " << version;
+    return false;
+  }
+
+  QByteArray payload = device->readAll();
+  if (flags & FlagCompressed) payload = qUncompress(payload);
+
+  if (payload.size()!=(int)payloadSize || payloadSize!=count*PointSize) {
+    NQLogWarning("DefoPointFile") << "corrupt point file";
+    return false;
+  }
+
+  std::vector<double> x(count), y(count);
+  std::vector<float> h(count), s(count), v(count);
+  std::vector<qint32> ix(count), iy(count);
+  std::vector<quint8> indexed(count), valid(count);
+
+  const char* src = payload.constData();
+  extractColumn(src, x);
+  extractColumn(src, y);
+  extractColumn(src, h);
+  extractColumn(src, s);
+  extractColumn(src, v);
+  extractColumn(src, ix);
+  extractColumn(src, iy);
+  extractColumn(src, indexed);
+  extractColumn(src, valid);
+
+  points.reserve(count);
+  for (quint32 i=0;i<count;++i) {
+    DefoPoint p(x[i], y[i]);
+    QColor c;
+    c.setHsvF(h[i], s[i], v[i]);
+    p.setColor(c);
+
+    p.setValid(valid[i]);
+
+    p.unindex();
+    if (indexed[i]) p.setIndex(ix[i], iy[i]);
+
+    points.push_back(p);
+  }
+
+  return true;
+}
+
+void DefoPointFile::writeXML(QIODevice* device, const DefoPointCollection& points)
+{
+  QXmlStreamWriter stream(device);
+  stream.setAutoFormatting(true);
+
+  stream.writeStartDocument();
+
+  stream.writeStartElement("DefoPoints");
+  stream.writeAttribute("count", QString().setNum(points.size()));
+
+  for (DefoPointCollection::const_iterator it = points.begin();
+       it != points.end();
+       ++it) {
+    stream.writeStartElement("DefoPoint");
+    stream.writeAttribute("x", QString().setNum(it->getX(), 'e', 6));
+    stream.writeAttribute("y", QString().setNum(it->getY(), 'e', 6));
+    float h, s ,v;
+    QColor c = it->getColor();
+    h = c.hsvHueF();
+    s = c.hsvSaturationF();
+    v = c.valueF();
+    stream.writeAttribute("H", QString().setNum(h, 'e', 6));
+    stream.writeAttribute("S", QString().setNum(s, 'e', 6));
+    stream.writeAttribute("V", QString().setNum(v, 'e', 6));
+
+    stream.writeAttribute("indexed", QString().setNum(it->isIndexed()));
+    if (it->isIndexed()) {
+      stream.writeAttribute("ix", QString().setNum(it->getIndex().first));
+      stream.writeAttribute("iy", QString().setNum(it->getIndex().second));
+    }
+
+    stream.writeEndElement();
+  }
+
+  stream.writeEndElement();
+
+  stream.writeEndDocument();
+}
+
+bool DefoPointFile::readXML(QIODevice* device, DefoPointCollection& points)
+{
+  QXmlStreamReader stream(device);
+  while (!stream.atEnd()) {
+    stream.readNextStartElement();
+    if (stream.isStartElement() && stream.name()=="DefoPoint") {
+      QXmlStreamAttributes attributes = stream.attributes();
+      double x = attributes.value("x").toString().toDouble();
+      double y = attributes.value("y").toString().toDouble();
+      float H = attributes.value("H").toString().toFloat();
+      float S = attributes.value("S").toString().toFloat();
+      float V = attributes.value("V").toString().toFloat();
+      DefoPoint p(x, y);
+      QColor c;
+      c.setHsvF(H, S, V);
+      p.setColor(c);
+
+      p.setValid(true);
+
+      bool indexed = (attributes.value("indexed").toString().toInt()==1);
+      p.unindex();
+      if (indexed) {
+        int ix = attributes.value("ix").toString().toInt();
+        int iy = attributes.value("iy").toString().toInt();
+        p.setIndex(ix, iy);
+      }
+
+      points.push_back(p);
+    }
+  }
+
+  return !stream.hasError();
+}
@@ -0,0 +1,69 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef DEFOPOINTFILE_H
+#define DEFOPOINTFILE_H
+
+#include <QString>
+#include <QDir>
+#include <QIODevice>
+
+#include "DefoPoint.h"
+
+/**
+  \brief Reader and writer for point set files.
+  \par Point sets are stored in a versioned binary format: a fixed header
+  (magic "DPTS", version, flags, point count, payload size) followed by the
+  payload, which holds one contiguous little endian column per quantity:
+  x, y (double), H, S, V (float), ix, iy (int32) and the indexed and valid
+  flags (uint8). The payload is zlib compressed if the compressed flag is set.
+  \par Files in the older XML format (DefoPoints/DefoPoint elements) are read
+  transparently, so existing points_*.xml and offlinePoints_*.xml files stay
+  usable.
+  */
+class DefoPointFile
+{
+public:
+
+  static const QString BinarySuffix;
+  static const QString XMLSuffix;
+
+  /// writes the binary format to location
+  static bool write(const QString& location, const DefoPointCollection& points,
+                    bool compress = true);
+
+  /// reads a binary or XML point file, detected from its content
+  static bool read(const QString& location, DefoPointCollection& points);
+
+  /**
+    Reads basename + BinarySuffix from dir and falls back to
+    basename + XMLSuffix if no binary file exists.
+    */
+  static bool read(const QDir& dir, const QString& basename, DefoPointCollection& points);
+
+  /// true if either the binary or the XML file for basename exists
+  static bool exists(const QDir& dir, const QString& basename);
+
+  static void writeXML(QIODevice* device, const DefoPointCollection& points);
+  static bool readXML(QIODevice* device, DefoPointCollection& points);
+
+protected:
+
+  static const quint32 Magic = 0x53545044; // "DPTS" in little endian
+  static const quint16 Version = 1;
+  static const quint16 FlagCompressed = 0x0001;
+
+  static bool readBinary(QIODevice* device, DefoPointCollection& points);
+};
+
+#endif // DEFOPOINTFILE_H
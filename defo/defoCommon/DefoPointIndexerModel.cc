@@ -19,6 +19,7 @@
 #include "DefoPointIndexerModel.h"
 #include "DefoPropagationPointIndexer.h"
 #include "DefoPointIndexer.h"
+#include "DefoLatticePointIndexer.h"
 
 DefoPointIndexerModel::DefoPointIndexerModel(QObject *parent) :
     QObject(parent)
@@ -32,6 +33,10 @@ DefoPointIndexerModel::DefoPointIndexerModel(QObject *parent) :
   indexer = new DefoPointIndexer(this);
   indexers_.push_back(indexer);
   indexerNames_[indexer] = "Sorting Indexer";
+
+  indexer = new DefoLatticePointIndexer(this);
+  indexers_.push_back(indexer);
+  indexerNames_[indexer] = "Lattice Indexer";
 }
 
 const std::string DefoPointIndexerModel::getIndexerName(const DefoVPointIndexer* indexer) const {
@@ -0,0 +1,84 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <cmath>
+
+#include "DefoPointMerger.h"
+
+DefoPointMerger::DefoPointMerger()
+{
+
+}
+
+DefoPointMerger::DefoPointMerger(const DefoPointCollection& points)
+{
+  append(points);
+}
+
+/**
+  Appends the points to the merged collection and removes, in a single
+  compaction pass over the appended range, all invalid points and points
+  closer than one pixel to an already kept point.
+  */
+void DefoPointMerger::append(const DefoPointCollection& points)
+{
+  size_t first = points_.size();
+
+  points_.reserve(first + points.size());
+  points_.insert(points_.end(), points.begin(), points.end());
+
+  points_.erase(std::remove_if(points_.begin() + first,
+                               points_.end(),
+                               [this](const DefoPoint& p) { return isDuplicate(p); }),
+                points_.end());
+}
+
+long long DefoPointMerger::cellKey(int ix, int iy)
+{
+  return (static_cast<long long>(ix) << 32) ^ static_cast<unsigned int>(iy);
+}
+
+/**
+  Returns true if the point has to be dropped. Otherwise the point is
+  registered in its cell and false is returned.
+  */
+bool DefoPointMerger::isDuplicate(const DefoPoint& point)
+{
+  if (point.isValid()==false) return true;
+
+  const double x = point.getX();
+  const double y = point.getY();
+  const int ix = static_cast<int>(std::floor(x));
+  const int iy = static_cast<int>(std::floor(y));
+
+  for (int cx=ix-1;cx<=ix+1;++cx) {
+    for (int cy=iy-1;cy<=iy+1;++cy) {
+
+      std::unordered_map<long long,Cell>::const_iterator it = cells_.find(cellKey(cx, cy));
+      if (it==cells_.end()) continue;
+
+      for (Cell::const_iterator itp = it->second.begin();
+           itp != it->second.end();
+           ++itp) {
+        double dx = x - itp->first;
+        double dy = y - itp->second;
+        if (dx*dx + dy*dy < 1.0) return true;
+      }
+    }
+  }
+
+  cells_[cellKey(ix, iy)].push_back(std::make_pair(x, y));
+
+  return false;
+}
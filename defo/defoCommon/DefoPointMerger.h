@@ -0,0 +1,51 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef DEFOPOINTMERGER_H
+#define DEFOPOINTMERGER_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "DefoPoint.h"
+
+/**
+  \brief Incremental duplicate removal for point collections.
+  \par Points found by the individual DefoPointFinder blocks are merged into a
+  single collection owned by the merger. A point is dropped if it is invalid
+  or closer than one pixel to a point that was kept before. Kept points are
+  registered in a hash of 1 px cells, so that only the 3x3 neighbouring cells
+  have to be checked and a merge is linear in the number of new points.
+  */
+class DefoPointMerger {
+
+public:
+  DefoPointMerger();
+  explicit DefoPointMerger(const DefoPointCollection& points);
+
+  void append(const DefoPointCollection& points);
+
+  DefoPointCollection* getPoints() { return &points_; }
+  const DefoPointCollection* getPoints() const { return &points_; }
+
+protected:
+  typedef std::vector<std::pair<double,double> > Cell;
+
+  static long long cellKey(int ix, int iy);
+  bool isDuplicate(const DefoPoint& point);
+
+  DefoPointCollection points_;
+  std::unordered_map<long long,Cell> cells_;
+};
+
+#endif // DEFOPOINTMERGER_H
@@ -0,0 +1,231 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include "DefoPointStore.h"
+
+DefoPointStore::DefoPointStore()
+  : indexMapValid_(false)
+{
+
+}
+
+DefoPointStore::DefoPointStore(const DefoPointCollection& points)
+  : indexMapValid_(false)
+{
+  assign(points);
+}
+
+void DefoPointStore::assign(const DefoPointCollection& points)
+{
+  clear();
+  reserve(points.size());
+
+  for (DefoPointCollection::const_iterator it = points.begin();
+       it!=points.end();
+       ++it) {
+    append(*it);
+  }
+}
+
+void DefoPointStore::append(const DefoPoint& point)
+{
+  columns_[X].push_back(point.getX());
+  columns_[Y].push_back(point.getY());
+  columns_[CalibratedX].push_back(point.getCalibratedX());
+  columns_[CalibratedY].push_back(point.getCalibratedY());
+  columns_[Slope].push_back(point.getSlope());
+  columns_[Height].push_back(point.getHeight());
+  columns_[ImageDistanceX].push_back(point.getImageDistanceX());
+  columns_[GridDistanceX].push_back(point.getGridDistanceX());
+  columns_[ImageDistanceY].push_back(point.getImageDistanceY());
+  columns_[GridDistanceY].push_back(point.getGridDistanceY());
+
+  indexX_.push_back(point.getIndex().first);
+  indexY_.push_back(point.getIndex().second);
+
+  unsigned char flags = 0;
+  if (point.isIndexed()) flags |= Indexed;
+  if (point.isValid()) flags |= Valid;
+  if (point.isCalibrated()) flags |= Calibrated;
+  flags_.push_back(flags);
+
+  colors_.push_back(point.getColor());
+
+  indexMapValid_ = false;
+}
+
+void DefoPointStore::clear()
+{
+  for (int c = 0;c<NColumns;++c) columns_[c].clear();
+  indexX_.clear();
+  indexY_.clear();
+  flags_.clear();
+  colors_.clear();
+
+  indexMap_.clear();
+  indexMapValid_ = false;
+}
+
+void DefoPointStore::reserve(std::size_t n)
+{
+  for (int c = 0;c<NColumns;++c) columns_[c].reserve(n);
+  indexX_.reserve(n);
+  indexY_.reserve(n);
+  flags_.reserve(n);
+  colors_.reserve(n);
+}
+
+void DefoPointStore::setIndex(std::size_t row, int ix, int iy)
+{
+  indexX_[row] = ix;
+  indexY_[row] = iy;
+  flags_[row] |= Indexed;
+
+  indexMapValid_ = false;
+}
+
+long long DefoPointStore::indexKey(int ix, int iy)
+{
+  return (static_cast<long long>(ix) << 32) ^ static_cast<unsigned int>(iy);
+}
+
+void DefoPointStore::buildIndexMap() const
+{
+  indexMap_.clear();
+  indexMap_.reserve(size());
+
+  // first point with a given index wins, like a linear search would
+  for (std::size_t i = 0;i<size();++i) {
+    indexMap_.insert(std::make_pair(indexKey(indexX_[i], indexY_[i]), static_cast<int>(i)));
+  }
+
+  indexMapValid_ = true;
+}
+
+int DefoPointStore::find(int ix, int iy) const
+{
+  if (!indexMapValid_) buildIndexMap();
+
+  std::unordered_map<long long,int>::const_iterator it = indexMap_.find(indexKey(ix, iy));
+  if (it==indexMap_.end()) return -1;
+
+  return it->second;
+}
+
+DefoPoint DefoPointStore::point(std::size_t row) const
+{
+  DefoPoint p(columns_[X][row], columns_[Y][row]);
+
+  if (flags_[row] & Calibrated)
+    p.setCalibratedPosition(columns_[CalibratedX][row], columns_[CalibratedY][row]);
+  p.setSlope(columns_[Slope][row]);
+  p.setHeight(columns_[Height][row]);
+  p.setImageDistanceX(columns_[ImageDistanceX][row]);
+  p.setGridDistanceX(columns_[GridDistanceX][row]);
+  p.setImageDistanceY(columns_[ImageDistanceY][row]);
+  p.setGridDistanceY(columns_[GridDistanceY][row]);
+
+  p.setIndex(indexX_[row], indexY_[row]);
+  if (!(flags_[row] & Indexed)) p.unindex();
+  p.setValid(flags_[row] & Valid);
+  p.setColor(colors_[row]);
+
+  return p;
+}
+
+void DefoPointStore::toCollection(DefoPointCollection& points) const
+{
+  points.clear();
+  points.reserve(size());
+
+  for (std::size_t i = 0;i<size();++i) {
+    points.push_back(point(i));
+  }
+}
+
+void DefoPointStore::copyCalibrationTo(DefoPointCollection& points) const
+{
+  const double * cx = columns_[CalibratedX].data();
+  const double * cy = columns_[CalibratedY].data();
+  const double * idx = columns_[ImageDistanceX].data();
+  const double * gdx = columns_[GridDistanceX].data();
+  const double * idy = columns_[ImageDistanceY].data();
+  const double * gdy = columns_[GridDistanceY].data();
+
+  std::size_t n = std::min(points.size(), size());
+  for (std::size_t i = 0;i<n;++i) {
+    DefoPoint& p = points[i];
+    if (flags_[i] & Calibrated) p.setCalibratedPosition(cx[i], cy[i]);
+    p.setImageDistanceX(idx[i]);
+    p.setGridDistanceX(gdx[i]);
+    p.setImageDistanceY(idy[i]);
+    p.setGridDistanceY(gdy[i]);
+  }
+}
+
+DefoPointStoreView DefoPointStore::view()
+{
+  return DefoPointStoreView(this, 0, size());
+}
+
+DefoPointStoreView DefoPointStore::view(std::size_t offset, std::size_t count)
+{
+  if (offset>size()) offset = size();
+  if (count>size()-offset) count = size()-offset;
+  return DefoPointStoreView(this, offset, count);
+}
+
+void DefoPointStore::rotate(double angle)
+{
+  rotate(column(X), column(Y), angle);
+}
+
+/**
+  Rotates the points given by the x and y columns by angle [rad]. The loop
+  only touches two contiguous arrays and is vectorized by the compiler.
+  */
+void DefoPointStore::rotate(DefoPointSpan<double> x, DefoPointSpan<double> y,
+                            double angle)
+{
+  if (angle==0.0) return;
+
+  const double c = std::cos(angle);
+  const double s = std::sin(angle);
+
+  double * px = x.data();
+  double * py = y.data();
+  const std::size_t n = std::min(x.size(), y.size());
+
+  for (std::size_t i = 0;i<n;++i) {
+    const double xi = px[i];
+    const double yi = py[i];
+    px[i] = xi*c - yi*s;
+    py[i] = xi*s + yi*c;
+  }
+}
+
+DefoPointStoreView DefoPointStoreView::slice(std::size_t offset, std::size_t count) const
+{
+  if (offset>count_) offset = count_;
+  if (count>count_-offset) count = count_-offset;
+  return DefoPointStoreView(store_, offset_ + offset, count);
+}
+
+void DefoPointStoreView::rotate(double angle) const
+{
+  DefoPointStore::rotate(column(DefoPointStore::X),
+                         column(DefoPointStore::Y),
+                         angle);
+}
@@ -0,0 +1,189 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DEFOPOINTSTORE_H
+#define DEFOPOINTSTORE_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include <QColor>
+
+#include "DefoPoint.h"
+
+/**
+  \brief Non-owning view of a contiguous column of a DefoPointStore.
+  */
+template <typename T> class DefoPointSpan
+{
+public:
+  DefoPointSpan() : data_(0), size_(0) { }
+  DefoPointSpan(T* data, std::size_t size) : data_(data), size_(size) { }
+
+  T* data() const { return data_; }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_==0; }
+  T* begin() const { return data_; }
+  T* end() const { return data_ + size_; }
+  T& operator[](std::size_t i) const { return data_[i]; }
+
+  /// sub span of count elements starting at offset, clipped to this span
+  DefoPointSpan<T> slice(std::size_t offset, std::size_t count) const {
+    if (offset>size_) offset = size_;
+    if (count>size_-offset) count = size_-offset;
+    return DefoPointSpan<T>(data_ + offset, count);
+  }
+
+protected:
+  T* data_;
+  std::size_t size_;
+};
+
+class DefoPointStoreView;
+
+/**
+  \brief Columnar (structure of arrays) container for DefoPoint data.
+  \par Every quantity of a DefoPoint is kept in its own contiguous column, so
+  that the reconstruction stages can loop over plain double arrays instead of
+  copying DefoPoint objects around. Rows are addressed by their position in
+  the store. Index columns are read-only spans; use setIndex() to change them
+  so that the index lookup used by find() stays consistent.
+  */
+class DefoPointStore
+{
+public:
+
+  enum Column {
+    X = 0,
+    Y,
+    CalibratedX,
+    CalibratedY,
+    Slope,
+    Height,
+    ImageDistanceX,
+    GridDistanceX,
+    ImageDistanceY,
+    GridDistanceY,
+    NColumns
+  };
+
+  enum Flag {
+    Indexed    = 0x01,
+    Valid      = 0x02,
+    Calibrated = 0x04
+  };
+
+  DefoPointStore();
+  explicit DefoPointStore(const DefoPointCollection& points);
+
+  void assign(const DefoPointCollection& points);
+  void append(const DefoPoint& point);
+  void clear();
+  void reserve(std::size_t n);
+  std::size_t size() const { return flags_.size(); }
+  bool empty() const { return flags_.empty(); }
+
+  DefoPointSpan<double> column(Column c) {
+    return DefoPointSpan<double>(columns_[c].data(), size());
+  }
+  DefoPointSpan<const double> column(Column c) const {
+    return DefoPointSpan<const double>(columns_[c].data(), size());
+  }
+  DefoPointSpan<const int> indexX() const {
+    return DefoPointSpan<const int>(indexX_.data(), size());
+  }
+  DefoPointSpan<const int> indexY() const {
+    return DefoPointSpan<const int>(indexY_.data(), size());
+  }
+  DefoPointSpan<unsigned char> flags() {
+    return DefoPointSpan<unsigned char>(flags_.data(), size());
+  }
+  DefoPointSpan<const unsigned char> flags() const {
+    return DefoPointSpan<const unsigned char>(flags_.data(), size());
+  }
+  const QColor& color(std::size_t row) const { return colors_[row]; }
+
+  bool isIndexed(std::size_t row) const { return flags_[row] & Indexed; }
+  void setIndex(std::size_t row, int ix, int iy);
+
+  /// first row with index (ix, iy) or -1 if there is none
+  int find(int ix, int iy) const;
+
+  /// builds a DefoPoint from a single row
+  DefoPoint point(std::size_t row) const;
+  void toCollection(DefoPointCollection& points) const;
+
+  /// writes the calibrated position and distance columns back to points,
+  /// which must be the collection the store was assigned from
+  void copyCalibrationTo(DefoPointCollection& points) const;
+
+  DefoPointStoreView view();
+  DefoPointStoreView view(std::size_t offset, std::size_t count);
+
+  /// rotates x and y of all rows by angle [rad] around the origin
+  void rotate(double angle);
+
+  static void rotate(DefoPointSpan<double> x, DefoPointSpan<double> y,
+                     double angle);
+
+protected:
+
+  static long long indexKey(int ix, int iy);
+  void buildIndexMap() const;
+
+  std::vector<double> columns_[NColumns];
+  std::vector<int> indexX_;
+  std::vector<int> indexY_;
+  std::vector<unsigned char> flags_;
+  std::vector<QColor> colors_;
+
+  mutable std::unordered_map<long long,int> indexMap_;
+  mutable bool indexMapValid_;
+};
+
+/**
+  \brief Cheap slice of consecutive rows of a DefoPointStore.
+  \par A view does not own any data and stays valid as long as the store is
+  not resized.
+  */
+class DefoPointStoreView
+{
+public:
+  DefoPointStoreView(DefoPointStore* store, std::size_t offset, std::size_t count)
+    : store_(store), offset_(offset), count_(count) { }
+
+  std::size_t size() const { return count_; }
+  std::size_t offset() const { return offset_; }
+
+  DefoPointSpan<double> column(DefoPointStore::Column c) const {
+    return store_->column(c).slice(offset_, count_);
+  }
+  DefoPointSpan<const int> indexX() const {
+    return store_->indexX().slice(offset_, count_);
+  }
+  DefoPointSpan<const int> indexY() const {
+    return store_->indexY().slice(offset_, count_);
+  }
+  DefoPoint point(std::size_t row) const { return store_->point(offset_ + row); }
+
+  DefoPointStoreView slice(std::size_t offset, std::size_t count) const;
+
+  void rotate(double angle) const;
+
+protected:
+  DefoPointStore* store_;
+  std::size_t offset_;
+  std::size_t count_;
+};
+
+#endif // DEFOPOINTSTORE_H
@@ -33,6 +33,12 @@ QRectF DefoROIModel::boundingRect() const
   return roi_->boundingRect();
 }
 
+QPolygonF DefoROIModel::getPolygon() const
+{
+  if (!roi_) return QPolygonF();
+  return *roi_;
+}
+
 int DefoROIModel::size() const
 {
   if (!roi_) return 0;
@@ -27,6 +27,7 @@ public:
   explicit DefoROIModel(QObject *parent = 0);
 
   QRectF boundingRect() const;
+  QPolygonF getPolygon() const;
   int size() const;
   const QPointF at(int i) const;
   const QPointF first() const;
@@ -91,16 +91,20 @@ const DefoSurface DefoRecoSurface::reconstruct(DefoPointCollection& currentPoint
 {
   DefoSurface theSurface;
 
+  // work on columnar copies; the calibration is written back at the end
+  DefoPointStore currentStore(currentPoints);
+  DefoPointStore referenceStore(referencePoints);
+
   // calibrate XY coordinates of currentPoints
-  calibrateXYPoints(currentPoints);
+  calibrateXYPoints(currentStore);
   emit incrementRecoProgress();
 
   // calibrate XY coordinates of referencePoints
-  calibrateXYPoints(referencePoints);
+  calibrateXYPoints(referenceStore);
   emit incrementRecoProgress();
 
   // create raw z splines for surface reconstruction
-  DefoSplineField currentZSplineField = createZSplines( currentPoints, referencePoints );
+  DefoSplineField currentZSplineField = createZSplines( currentStore, referenceStore );
   emit incrementRecoProgress();
 
   // connect x and y splines
@@ -115,7 +119,7 @@ const DefoSurface DefoRecoSurface::reconstruct(DefoPointCollection& currentPoint
   theSurface.setSplineField( currentZSplineField );
   emit incrementRecoProgress();
 
-  theSurface.setPoints( referencePoints ); // ref points for the moment because createZSplines uses them
+  theSurface.setPoints( referenceStore ); // ref points for the moment because createZSplines uses them
   emit incrementRecoProgress();
 
   theSurface.createPointFields(); // create matrix of points (internal)
@@ -125,10 +129,13 @@ const DefoSurface DefoRecoSurface::reconstruct(DefoPointCollection& currentPoint
 
   theSurface.calibrateZ(calibZx_, calibZy_);
 
+  currentStore.copyCalibrationTo(currentPoints);
+  referenceStore.copyCalibrationTo(referencePoints);
+
   return theSurface;
 }
 
-void DefoRecoSurface::calibrateXYPoints(DefoPointCollection & points)
+void DefoRecoSurface::calibrateXYPoints(DefoPointStore & points)
 {
   double f = focalLength_;
   double gamma = imageScale(f);
@@ -166,81 +173,86 @@ void DefoRecoSurface::calibrateXYPoints(DefoPointCollection & points)
   NPoint3D imagePoint(objectPoint);
   imagePoint.move(imageDistanceVector);
 
-  NPoint3D gridPoint(0., 0., 0.);
-  gridPoint.move(height1);
-
-  NDirection3D gridNormal(0., 0., -1.);
-  gridNormal.rotateX(-a1);
-
-  NPlane3D gridPlane(gridPoint, gridNormal);
-
-  NPoint3D objectIntersection;
-  NPoint3D gridIntersection;
-
-  /*
-  std::cout << imageSize_.first << std::endl;
-  std::cout << imageSize_.second << std::endl;
-  */
-
-  for( DefoPointCollection::iterator it = points.begin();
-      it != points.end();
-      ++it ) {
-
-    DefoPoint& aPoint = *it;
-
-    NDirection3D imageRayDirection((aPoint.getX() - 0.5 * imageSize_.first) * pitchX_,
-                                   (aPoint.getY() - 0.5 * imageSize_.second) * pitchY_,
-                                   imageDistance);
-    imageRayDirection.rotateX(a2 + a3);
-    NLine3D imageRay(imagePoint, imageRayDirection);
-    imageRay.intersection(objectPlane, objectIntersection);
-
-    NVector3D imageDistance(objectIntersection, imagePoint);
-
-    NDirection3D gridRayDirection(imageRayDirection);
-    gridRayDirection.rotateZ(M_PI);
-    NLine3D gridRay(objectIntersection, gridRayDirection);
-    gridRay.intersection(gridPlane, gridIntersection);
-
-    NVector3D gridDistance(objectIntersection, gridIntersection);
-
-    double x = -1.0 * objectIntersection.x() * calibX_;
-    double y =  1.0 * objectIntersection.y() * calibY_;
-
-    aPoint.setCalibratedPosition(x, y);
-
-    NVector2D imageDistanceX(imageDistance.x(), imageDistance.z());
-    NVector2D gridDistanceX(gridDistance.x(), gridDistance.z());
-
-    aPoint.setImageDistanceX(imageDistanceX.length());
-    aPoint.setGridDistanceX(gridDistanceX.length());
-
-    NVector2D imageDistanceY(imageDistance.y(), imageDistance.z());
-    NVector2D gridDistanceY(gridDistance.y(), gridDistance.z());
-
-    aPoint.setImageDistanceY(imageDistanceY.length());
-    aPoint.setGridDistanceY(gridDistanceY.length());
-
-    /*
-    std::cout << "("
-	      << aPoint.getIndex().first << ", "
-	      << aPoint.getIndex().second << ") -> ("
-	      << aPoint.getCalibratedX() << ", "
-	      << aPoint.getCalibratedY() << ") -> ("
-	      << aPoint.getImageDistance() << ", "
-	      << aPoint.getGridDistance() << ") -> "
-              << (aPoint.getGridDistance()+aPoint.getImageDistance())/(2.0*aPoint.getGridDistance())
-	      << std::endl;
-	*/
+  const double ca = std::cos(a2 + a3);
+  const double sa = std::sin(a2 + a3);
+
+  // grid plane normal: (0, 0, -1) rotated around x by -a1
+  const double gny = -std::sin(a1);
+  const double gnz = -std::cos(a1);
+
+  const double ipx = imagePoint.x();
+  const double ipy = imagePoint.y();
+  const double ipz = imagePoint.z();
+  const double cx0 = 0.5 * imageSize_.first;
+  const double cy0 = 0.5 * imageSize_.second;
+  const double pitchX = pitchX_;
+  const double pitchY = pitchY_;
+  const double calibX = calibX_;
+  const double calibY = calibY_;
+  const double h1 = height1_;
+  const double h2 = height2_;
+
+  const std::size_t n = points.size();
+  const double * px = points.column(DefoPointStore::X).data();
+  const double * py = points.column(DefoPointStore::Y).data();
+  double * pcx = points.column(DefoPointStore::CalibratedX).data();
+  double * pcy = points.column(DefoPointStore::CalibratedY).data();
+  double * pidx = points.column(DefoPointStore::ImageDistanceX).data();
+  double * pgdx = points.column(DefoPointStore::GridDistanceX).data();
+  double * pidy = points.column(DefoPointStore::ImageDistanceY).data();
+  double * pgdy = points.column(DefoPointStore::GridDistanceY).data();
+
+  // Same geometry as tracing each point with NLine3D/NPlane3D, written out
+  // in closed form so that the loop runs over plain arrays and vectorizes.
+  // Intersections do not depend on the length of the ray directions, hence
+  // no normalization is needed.
+  for (std::size_t i = 0;i<n;++i) {
+
+    // image ray direction, rotated around x by a2 + a3
+    const double u = (px[i] - cx0) * pitchX;
+    const double v = (py[i] - cy0) * pitchY;
+    const double dx = u;
+    const double dy = v * ca - imageDistance * sa;
+    const double dz = v * sa + imageDistance * ca;
+
+    // intersection with the object plane z = height2
+    const double t = (h2 - ipz) / dz;
+    const double ox = ipx + t * dx;
+    const double oy = ipy + t * dy;
+    const double oz = ipz + t * dz;
+
+    // grid ray: image ray rotated around z by pi, starting at the object
+    const double gt = (gny * (-oy) + gnz * (h1 - oz)) / (gny * (-dy) + gnz * dz);
+    const double gx = ox - gt * dx;
+    const double gy = oy - gt * dy;
+    const double gz = oz + gt * dz;
+
+    pcx[i] = -1.0 * ox * calibX;
+    pcy[i] =  1.0 * oy * calibY;
+
+    const double idx = ipx - ox;
+    const double idy = ipy - oy;
+    const double idz = ipz - oz;
+    const double gdx = gx - ox;
+    const double gdy = gy - oy;
+    const double gdz = gz - oz;
+
+    pidx[i] = std::sqrt(idx*idx + idz*idz);
+    pgdx[i] = std::sqrt(gdx*gdx + gdz*gdz);
+    pidy[i] = std::sqrt(idy*idy + idz*idz);
+    pgdy[i] = std::sqrt(gdy*gdy + gdz*gdz);
   }
+
+  DefoPointSpan<unsigned char> flags = points.flags();
+  for (std::size_t i = 0;i<n;++i) flags[i] |= DefoPointStore::Calibrated;
 }
 
 ///
 /// create z splines from difference in point positions
 /// NEW VERSION based on indexed points
 ///
-const DefoSplineField DefoRecoSurface::createZSplines(DefoPointCollection const& currentPoints,
-                                                      DefoPointCollection const& referencePoints)
+const DefoSplineField DefoRecoSurface::createZSplines(DefoPointStore const& currentPoints,
+                                                      DefoPointStore const& referencePoints)
 {
   NQLog("DefoRecoSurface", NQLog::Message) << "createZSplines starting";
 
@@ -267,17 +279,13 @@ const DefoSplineField DefoRecoSurface::createZSplines(DefoPointCollection const&
 
   // here we assume that there is at least one point right/left/above/below the blue one, resp., in the image;
   // otherwise the reconstruction will probably crash later
-  for( DefoPointCollection::const_iterator it = currentPoints.begin(); it < currentPoints.end(); ++it ) {
-    if( it->getIndex().first  < indexRangeX.first )  indexRangeX.first = it->getIndex().first;
-    if( it->getIndex().first  > indexRangeX.second ) indexRangeX.second = it->getIndex().first;
-    if( it->getIndex().second < indexRangeY.first )  indexRangeY.first  = it->getIndex().second;
-    if( it->getIndex().second > indexRangeY.second ) indexRangeY.second = it->getIndex().second;
-    /*
-    indexRangeX.first = std::min(it->getIndex().first, indexRangeX.first);
-    indexRangeX.second = std::max(it->getIndex().first, indexRangeX.second);
-    indexRangeY.first = std::min(it->getIndex().first, indexRangeY.first);
-    indexRangeY.second = std::max(it->getIndex().first, indexRangeY.second);
-     */
+  DefoPointSpan<const int> currentIndexX = currentPoints.indexX();
+  DefoPointSpan<const int> currentIndexY = currentPoints.indexY();
+  for (std::size_t i = 0; i < currentPoints.size(); ++i) {
+    if( currentIndexX[i] < indexRangeX.first )  indexRangeX.first  = currentIndexX[i];
+    if( currentIndexX[i] > indexRangeX.second ) indexRangeX.second = currentIndexX[i];
+    if( currentIndexY[i] < indexRangeY.first )  indexRangeY.first  = currentIndexY[i];
+    if( currentIndexY[i] > indexRangeY.second ) indexRangeY.second = currentIndexY[i];
   }
   
   /*
@@ -295,10 +303,6 @@ const DefoSplineField DefoRecoSurface::createZSplines(DefoPointCollection const&
   indexRangeY.second = std::min(indexRangeYref.second, indexRangeY.second);
    */
 
-  // we need the blue point (from *ref*) as geom. reference, it always has index 0,0
-  std::pair<bool,DefoPointCollection::const_iterator> bluePointByIndex =
-      findPointByIndex(referencePoints, std::pair<int,int>( 0, 0 ));
-
   // now attach the points to the spline sets according to their indices
   std::pair<int,int> index = std::pair<int,int>( indexRangeX.first, indexRangeY.first );
 
@@ -311,23 +315,20 @@ const DefoSplineField DefoRecoSurface::createZSplines(DefoPointCollection const&
 
     for( ; index.second <= indexRangeY.second; ++index.second ) {
       
-      std::pair<bool,DefoPointCollection::const_iterator> currentPointByIndex =
-          findPointByIndex(currentPoints, index);
-
-      std::pair<bool,DefoPointCollection::const_iterator> referencePointByIndex =
-          findPointByIndex(referencePoints, index);
+      int currentRow = currentPoints.find(index.first, index.second);
+      int referenceRow = referencePoints.find(index.first, index.second);
       
       // check if a point with that index exists in both images
       // (it should then have been a reflection from the same source)
-      if (currentPointByIndex.first && referencePointByIndex.first) {
+      if (currentRow>=0 && referenceRow>=0) {
 
         // this point is abstract and lives where the *ref* point is on the module
         // (make a copy)
-        DefoPoint aPoint = DefoPoint(*(referencePointByIndex.second));
+        DefoPoint aPoint = referencePoints.point(referenceRow);
 
         // the attached slope (= tan(alpha)) is derived from the difference in y position
-        double currentY = (*(currentPointByIndex.second)).getCalibratedY();
-        double referenceY = (*(referencePointByIndex.second)).getCalibratedY();
+        double currentY = currentPoints.column(DefoPointStore::CalibratedY)[currentRow];
+        double referenceY = referencePoints.column(DefoPointStore::CalibratedY)[referenceRow];
         double dY = 1.0*(currentY - referenceY);
 
         aPoint.setSlope( aPoint.getCorrectionFactor(DefoPoint::Y) * dY);
@@ -364,24 +365,21 @@ const DefoSplineField DefoRecoSurface::createZSplines(DefoPointCollection const&
 
     for( ; index.first <= indexRangeX.second; ++index.first ) {
       
-      std::pair<bool,DefoPointCollection::const_iterator> currentPointByIndex =
-          findPointByIndex( currentPoints, index );
-
-      std::pair<bool,DefoPointCollection::const_iterator> referencePointByIndex =
-          findPointByIndex( referencePoints, index );
+      int currentRow = currentPoints.find(index.first, index.second);
+      int referenceRow = referencePoints.find(index.first, index.second);
       
       // check if a point with that index exists in both images
       // (it should then have been a reflection from the same source)
-      if (currentPointByIndex.first && referencePointByIndex.first) {
+      if (currentRow>=0 && referenceRow>=0) {
 
         // this point is abstract and lives where the ref point is on the module
         // (make a copy)
-        DefoPoint aPoint = DefoPoint( *(referencePointByIndex.second) );
+        DefoPoint aPoint = referencePoints.point(referenceRow);
         // convert from pixel units to real units on module
 
         // the attached slope (= tan(alpha)) is derived from the difference in x position
-        double currentX = (*(currentPointByIndex.second)).getCalibratedX();
-        double referenceX = (*(referencePointByIndex.second)).getCalibratedX();
+        double currentX = currentPoints.column(DefoPointStore::CalibratedX)[currentRow];
+        double referenceX = referencePoints.column(DefoPointStore::CalibratedX)[referenceRow];
         double dX = 1.0*(currentX - referenceX);
 
         aPoint.setSlope( aPoint.getCorrectionFactor(DefoPoint::Y) * dX);
@@ -560,23 +558,6 @@ void DefoRecoSurface::mountZSplines( DefoSplineField& splineField ) const {
   }
 }
 
-const std::pair<bool,DefoPointCollection::const_iterator> 
-DefoRecoSurface::findPointByIndex(DefoPointCollection const& points,
-                                  std::pair<int,int> const& index ) const
-{
-  DefoPointCollection::const_iterator it = points.begin();
-  bool isFound = false;
-
-  for( ; it < points.end(); ++it) {
-    if (index == it->getIndex()) {
-      isFound = true;
-      break;
-    }
-  }
-
-  return std::pair<bool,DefoPointCollection::const_iterator>(isFound, it);
-}
-
 ///
 /// determine and apply a common offset to all spline sets in the field
 /// such that the lowermost point has height zero in the end
@@ -589,10 +570,12 @@ void DefoRecoSurface::removeGlobalOffset( DefoSplineField& splineField ) const
   for (DefoSplineSetXCollection::const_iterator itX = splineField.first.begin();
        itX < splineField.first.end();
        ++itX ) {
+    int segment = -1; // points are ordered, keep the segment of the previous one
     for (DefoPointCollection::const_iterator itPX = itX->getPoints().begin();
          itPX < itX->getPoints().end();
          ++itPX ) {
-      if (itX->eval(itPX->getCalibratedX()) < minimalHeight) minimalHeight = itX->eval(itPX->getCalibratedX());
+      const double height = itX->eval(itPX->getCalibratedX(), segment);
+      if (height < minimalHeight) minimalHeight = height;
     }
   }
 
@@ -609,10 +592,12 @@ void DefoRecoSurface::removeGlobalOffset( DefoSplineField& splineField ) const
   for (DefoSplineSetYCollection::const_iterator itY = splineField.second.begin();
        itY < splineField.second.end();
        ++itY) {
+    int segment = -1; // points are ordered, keep the segment of the previous one
     for (DefoPointCollection::const_iterator itPY = itY->getPoints().begin();
          itPY < itY->getPoints().end();
          ++itPY) {
-      if (itY->eval(itPY->getCalibratedY()) < minimalHeight) minimalHeight = itY->eval(itPY->getCalibratedY());
+      const double height = itY->eval(itPY->getCalibratedY(), segment);
+      if (height < minimalHeight) minimalHeight = height;
     }
   }
 
@@ -23,6 +23,7 @@
 #include <QObject>
 
 #include "DefoPoint.h"
+#include "DefoPointStore.h"
 #include "DefoSurface.h"
 #include "DefoSpline.h"
 
@@ -69,11 +70,10 @@ class DefoRecoSurface : public QObject
 
  private:
 
-  void calibrateXYPoints(DefoPointCollection & points);
+  void calibrateXYPoints(DefoPointStore & points);
 
-  const DefoSplineField createZSplines( DefoPointCollection const&, DefoPointCollection const& );
+  const DefoSplineField createZSplines( DefoPointStore const&, DefoPointStore const& );
   void mountZSplines( DefoSplineField& ) const;
-  const std::pair<bool,DefoPointCollection::const_iterator> findPointByIndex( DefoPointCollection const&, std::pair<int,int> const& ) const;
   void removeGlobalOffset( DefoSplineField& ) const;
   void removeTilt( DefoSplineField& ) const;
   double imageScale(double focalLength) const;
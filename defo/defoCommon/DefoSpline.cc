@@ -10,6 +10,8 @@
 //                                                                             //
 /////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include <nqlogger.h>
 
 #include "DefoSpline.h"
@@ -37,14 +39,89 @@ void DefoSplineSetBase::offset( double anOffset ) {
 
 
 
+///
+/// collect the spline validity ranges in a contiguous array for
+/// findSegment(); only done if the splines are contiguous and ascending,
+/// otherwise eval() falls back to testing each spline
+///
+void DefoSplineSetBase::updateBreakpoints( void ) {
+
+  breakpoints_.clear();
+  if( splines_.empty() ) return;
+
+  std::vector<double> breakpoints;
+  breakpoints.reserve( splines_.size() + 1 );
+  breakpoints.push_back( splines_.front().getValidityRange().first );
+
+  for( std::vector<DefoSpline>::const_iterator it = splines_.begin(); it < splines_.end(); ++it ) {
+    const std::pair<double,double>& range = it->getValidityRange();
+    if( range.first != breakpoints.back() || !( range.first <= range.second ) ) return;
+    breakpoints.push_back( range.second );
+  }
+
+  breakpoints_.swap( breakpoints );
+}
+
+///
+/// true if the spline segment is the first one whose range contains pos
+///
+bool DefoSplineSetBase::isInSegment( int segment, double pos ) const {
+
+  if( pos > breakpoints_[segment+1] ) return false;
+  if( segment==0 ) return pos >= breakpoints_[0];
+  return pos > breakpoints_[segment];
+}
+
+///
+/// index of the first spline whose validity range contains pos, or -1;
+/// a hint (e.g. the previous segment of a monotone sweep) is checked first
+///
+int DefoSplineSetBase::findSegment( double pos, int hint ) const {
+
+  const int nSegments = splines_.size();
+
+  if( breakpoints_.empty() ) {
+    for( int i = 0; i < nSegments; ++i ) {
+      if( splines_[i].isInRange( pos ) ) return i;
+    }
+    return -1;
+  }
+
+  if( hint >= 0 && hint < nSegments ) {
+    if( isInSegment( hint, pos ) ) return hint;
+    if( hint+1 < nSegments && isInSegment( hint+1, pos ) ) return hint+1;
+  }
+
+  // first breakpoint at or above pos ends the segment
+  std::vector<double>::const_iterator it = std::lower_bound( breakpoints_.begin() + 1, breakpoints_.end(), pos );
+  if( it == breakpoints_.end() ) return -1;
+
+  const int segment = it - breakpoints_.begin() - 1;
+  if( pos < breakpoints_[segment] ) return -1;
+
+  return segment;
+}
+
 ///
 /// evaluate a spline set at a given position;
 /// assume that the spline set is continuous
 ///
 double DefoSplineSetBase::eval( double pos ) const {
 
-  for( std::vector<DefoSpline>::const_iterator it = splines_.begin(); it < splines_.end(); ++it ) {
-    if( it->isInRange( pos ) ) return it->eval( pos );
+  int hint = -1;
+  return eval( pos, hint );
+}
+
+///
+/// evaluate a spline set at a given position, starting the segment search
+/// at hint; hint is set to the segment used
+///
+double DefoSplineSetBase::eval( double pos, int& hint ) const {
+
+  const int segment = findSegment( pos, hint );
+  if( segment >= 0 ) {
+    hint = segment;
+    return splines_[segment].eval( pos );
   }
 
   // no spline with matching range?
@@ -56,6 +133,19 @@ double DefoSplineSetBase::eval( double pos ) const {
   return 0.;
 }
 
+///
+/// evaluate a spline set at many positions; for sorted positions every
+/// segment is found from the previous one, so this is linear in total
+///
+void DefoSplineSetBase::eval( DefoPointSpan<const double> positions, DefoPointSpan<double> values ) const {
+
+  int hint = -1;
+  const size_t n = std::min( positions.size(), values.size() );
+  for( size_t i = 0; i < n; ++i ) {
+    values[i] = eval( positions[i], hint );
+  }
+}
+
 
 
 ///
@@ -131,6 +221,8 @@ bool DefoSplineSetBase::doFitXY( void ) {
 
   // MISSING CHECK
 
+  updateBreakpoints();
+
   return true;
 }
 
@@ -194,6 +286,8 @@ bool DefoSplineSetBase::doFitZ( void ) {
   }
 
   // MISSING CHECK
+  updateBreakpoints();
+
   return true;
 
 }
@@ -19,6 +19,7 @@
 #include <cmath>
 
 #include "DefoPoint.h"
+#include "DefoPointStore.h"
 
 ///
 /// class for holding a single spline
@@ -65,16 +66,26 @@ class DefoSplineSetBase {
   std::pair<double,double> const validityRange( void ) const;
   size_t getNPoints( void ) const { return points_.size(); }
   void addPoint( DefoPoint const& point ) { points_.push_back( point ); }
-  void clear( void ) { splines_.resize( 0 ); points_.resize( 0 ); }
+  void clear( void ) { splines_.resize( 0 ); points_.resize( 0 ); breakpoints_.resize( 0 ); }
   void offset( double );
   double eval( double ) const;
+  double eval( double pos, int& hint ) const;
+  void eval( DefoPointSpan<const double> positions, DefoPointSpan<double> values ) const;
+  int findSegment( double pos, int hint = -1 ) const;
+  std::vector<double> const& getBreakpoints( void ) const { return breakpoints_; }
 
  protected:
+  void updateBreakpoints( void );
+  bool isInSegment( int segment, double pos ) const;
+
   DefoPoint::Axis axis_;
   std::vector<DefoSpline> splines_;
   DefoPointCollection points_;
   int debugLevel_;
 
+  // start of each spline plus end of the last one, if they are ascending
+  std::vector<double> breakpoints_;
+
 };
 
 
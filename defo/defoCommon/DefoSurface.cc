@@ -15,6 +15,8 @@
 #include <fstream>
 #include <iomanip>
 #include <string>
+#include <cstdio>
+#include <future>
 
 #include <QHash>
 
@@ -353,42 +355,25 @@ void DefoSurface::dumpSpline2DField(std::string filename,
     if (it.key().getIY()==iymax) ymax = std::min(ymax, it.key().getY());
   }
 
-  int stepsX = std::ceil((xmax-xmin)/dx);
-  int stepsY = std::ceil((ymax-ymin)/dy);
+  int stepsX = std::max(1, (int)std::ceil((xmax-xmin)/dx));
+  int stepsY = std::max(1, (int)std::ceil((ymax-ymin)/dy));
 
   double theDX = (xmax-xmin)/stepsX;
   double theDY = (ymax-ymin)/stepsY;
 
-  std::vector<double> x, y, zx, zy, zxy;
-  std::vector<int> vix, viy;
-
-  int ix = 0, iy = 0;
-  for (int rx=xmin;rx<=xmax;rx+=theDX) {
-    iy = 0;
-    for (int ry=ymin;ry<=ymax;ry+=theDY) {
-      vix.push_back(ix);
-      viy.push_back(iy);
-      x.push_back(rx);
-      y.push_back(ry);
-      zx.push_back(0.0);
-      zy.push_back(0.0);
-      zxy.push_back(0.0);
-      iy++;
-    }
-    ix++;
-  }
-
-  spline2Dx_.evaluate(x, y, zx);
-  spline2Dy_.evaluate(x, y, zy);
-  spline2Dxy_.evaluate(x, y, zxy);
+  std::vector<double> x(stepsX+1), y(stepsY+1);
+  for (int ix=0;ix<=stepsX;++ix) x[ix] = xmin + ix*theDX;
+  for (int iy=0;iy<=stepsY;++iy) y[iy] = ymin + iy*theDY;
 
-  std::vector<int>::iterator itix = vix.begin();
-  std::vector<int>::iterator itiy = viy.begin();
-  std::vector<double>::iterator itx = x.begin();
-  std::vector<double>::iterator ity = y.begin();
-  std::vector<double>::iterator itzx = zx.begin();
-  std::vector<double>::iterator itzy = zy.begin();
-  std::vector<double>::iterator itzxy = zxy.begin();
+  // the three surfaces are independent, evaluate them on the grid concurrently
+  std::vector<double> zx, zy, zxy;
+  std::future<bool> fx = std::async(std::launch::async,
+                                    [&]() { return spline2Dx_.evaluateGrid(x, y, zx); });
+  std::future<bool> fy = std::async(std::launch::async,
+                                    [&]() { return spline2Dy_.evaluateGrid(x, y, zy); });
+  spline2Dxy_.evaluateGrid(x, y, zxy);
+  fx.get();
+  fy.get();
 
   std::ofstream ofile(filename.c_str());
   ofile << "# "
@@ -396,20 +381,29 @@ void DefoSurface::dumpSpline2DField(std::string filename,
         << "(double)zy (int)has_zy (double)zxy (double)corrx (double)corry"
         << std::endl;
 
-  for (;itx!=x.end();++itix,++itiy,++itx,++ity,++itzx,++itzy) {
-    ofile << std::setw(8)  << *itix << " "
-          << std::setw(8)  << *itiy  << " "
-	  << std::setw(14) << std::scientific << *itx << " "
-          << std::setw(14) << std::scientific << *ity << " "
-	  << std::setw(14) << std::scientific << 0.0 << " "
-          << std::setw(14) << std::scientific << 0.0 << " "
-          << std::setw(14) << std::scientific << *itzx << "   1 "
-          << std::setw(14) << std::scientific << *itzy << "   1"
-          << std::setw(14) << std::scientific << *itzxy
-          << std::setw(14) << std::scientific << 1.0 << " "
-          << std::setw(14) << std::scientific << 1.0
-          << std::endl;
+  // format into a large buffer and write it in blocks; same layout as
+  // std::setw(8) for integers and std::setw(14) << std::scientific for doubles
+  std::vector<char> buffer(1 << 20);
+  size_t used = 0;
+  const size_t maxLine = 256;
+
+  for (int ix=0;ix<=stepsX;++ix) {
+    for (int iy=0;iy<=stepsY;++iy) {
+      size_t i = (size_t)iy*(stepsX+1) + ix;
+
+      if (buffer.size()-used < maxLine) {
+        ofile.write(buffer.data(), used);
+        used = 0;
+      }
+
+      used += std::snprintf(buffer.data()+used, maxLine,
+                            "%8d %8d %14.6e %14.6e %14.6e %14.6e %14.6e   1 %14.6e   1%14.6e%14.6e %14.6e\n",
+                            ix, iy, x[ix], y[iy], 0.0, 0.0,
+                            zx[i], zy[i], zxy[i], 1.0, 1.0);
+    }
   }
+
+  ofile.write(buffer.data(), used);
 }
 
 ///
@@ -450,50 +444,58 @@ void DefoSurface::createPointFields( void ) {
 
   // determine index range
   std::pair<unsigned int, unsigned int> indexRange( 0, 0 );
-  for( DefoPointCollection::const_iterator it = points_.begin(); it != points_.end(); ++it ) {
-    if( abs( it->getIndex().first  ) > (int)indexRange.first  ) indexRange.first  = abs( it->getIndex().first   );
-    if( abs( it->getIndex().second ) > (int)indexRange.second ) indexRange.second = abs( it->getIndex().second  );
+  DefoPointSpan<const int> indexX = points_.indexX();
+  DefoPointSpan<const int> indexY = points_.indexY();
+  for( std::size_t i = 0; i < points_.size(); ++i ) {
+    if( abs( indexX[i] ) > (int)indexRange.first  ) indexRange.first  = abs( indexX[i] );
+    if( abs( indexY[i] ) > (int)indexRange.second ) indexRange.second = abs( indexY[i] );
 
-    if( !it->isIndexed() ) {
+    if( !points_.isIndexed(i) ) {
       NQLogWarning("DefoSurface::createPointFields()")
           << "Point not indexed at position: x: "
-		  << it->getCalibratedX() << " y: " << it->getCalibratedY();
+          << points_.column(DefoPointStore::CalibratedX)[i]
+          << " y: " << points_.column(DefoPointStore::CalibratedY)[i];
     }
   }
 
 
   // create matrix accordingly
-  pointFields_.first.resize( indexRange.first * 2 + 1 );
-  for( DefoPointField::iterator it = pointFields_.first.begin(); it != pointFields_.first.end(); ++it ) {
-    it->resize( indexRange.second * 2 + 1 );
-  }
+  pointFields_.first.clear();
+  pointFields_.first.resize( indexRange.first * 2 + 1,
+                             std::vector<DefoPoint>( indexRange.second * 2 + 1 ) );
 
   // first "along-x" splines
   DefoSplineSetXCollection const& splinesX = splineField_.first;
+  std::vector<double> positions, heights;
   
   // loop set of spline "rows", itC is a DefoSplineSetX
   for( DefoSplineSetXCollection::const_iterator itC = splinesX.begin(); itC < splinesX.end(); ++itC ) {
   
+    // evaluate the heights of the whole row in one sweep
+    DefoPointCollection const& rowPoints = itC->getPoints();
+    positions.resize( rowPoints.size() );
+    heights.resize( rowPoints.size() );
+    for( size_t i = 0; i < rowPoints.size(); ++i ) positions[i] = rowPoints[i].getCalibratedX();
+    itC->eval( DefoPointSpan<const double>( positions.data(), positions.size() ),
+               DefoPointSpan<double>( heights.data(), heights.size() ) );
+
     // loop the points, determine matrix index
-    std::vector<DefoPoint> aColumn;
-    for( DefoPointCollection::const_iterator itP = itC->getPoints().begin(); itP < itC->getPoints().end(); ++itP ) {
-      DefoPoint aPoint( *itP ); // make copy to preserve constness
-      aPoint.setHeight( itC->eval( itP->getCalibratedX() ) );
-      aPoint.setValid( true ); // sign for the DefoSurfacePlot to take it
-      std::pair<int,int> absIndex = aPoint.getIndex();
+    for( size_t i = 0; i < rowPoints.size(); ++i ) {
+      std::pair<int,int> absIndex = rowPoints[i].getIndex();
       absIndex.first += indexRange.first;
       absIndex.second += indexRange.second;
 
-      pointFields_.first.at( absIndex.first ).at( absIndex.second ) = aPoint; // uuaargh..
+      // fill the cell in place
+      DefoPoint& aPoint = pointFields_.first.at( absIndex.first ).at( absIndex.second );
+      aPoint = rowPoints[i];
+      aPoint.setHeight( heights[i] );
+      aPoint.setValid( true ); // sign for the DefoSurfacePlot to take it
     }
   }
 
-  /////////////////////////////////
-  /////////////////////////////////
-  /////////////////////////////////
-  // CLONE FOR THE MOMENT
-
-  pointFields_.second = pointFields_.first; ////////////////////////////////////////////
+  // the along-y field is not filled separately yet; it is left empty
+  // instead of cloning the along-x field, see getPointFieldY()
+  pointFields_.second.clear();
 }
 
 void DefoSurface::calibrateZ(double calibZx, double calibZy)
@@ -525,7 +527,21 @@ void DefoSurface::fitSpline2D(int kx, int ky, double s, double nxy)
     }
   }
 
-  spline2Dx_.surfit(x, y, zx, kx, ky, s, nxy);
-  spline2Dy_.surfit(x, y, zy, kx, ky, s, nxy);
-  spline2Dxy_.surfit(x, y, zxy, kx, ky, s, nxy);
+  // the three fits share x, y and the knot setup and run concurrently
+  std::vector<NSpline2D*> splines;
+  splines.push_back(&spline2Dx_);
+  splines.push_back(&spline2Dy_);
+  splines.push_back(&spline2Dxy_);
+
+  std::vector<const std::vector<double>*> z;
+  z.push_back(&zx);
+  z.push_back(&zy);
+  z.push_back(&zxy);
+
+  NSpline2D::surfit(splines, x, y, z, kx, ky, s, nxy);
+
+  NQLogMessage("DefoSurface::fitSpline2D()")
+      << "fp = " << spline2Dx_.getFp() << ", " << spline2Dy_.getFp() << ", " << spline2Dxy_.getFp()
+      << " time [s] = " << spline2Dx_.getFitTime() << ", " << spline2Dy_.getFitTime()
+      << ", " << spline2Dxy_.getFitTime();
 }
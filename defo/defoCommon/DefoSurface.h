@@ -19,6 +19,7 @@
 
 #include "DefoSpline.h"
 #include "DefoPoint.h"
+#include "DefoPointStore.h"
 
 class DefoSplineXYPair
 {
@@ -84,11 +85,16 @@ class DefoSurface {
   void makeSummary();
   const DefoSurfaceSummary& getSummary() const;
 
-  void setPoints( DefoPointCollection const& points ) { points_ = points; }
-  DefoPointCollection const& getPoints( void ) { return points_; }
+  void setPoints( DefoPointStore const& points ) { points_ = points; }
+  DefoPointStore const& getPoints( void ) const { return points_; }
   DefoSplineField const& getSplineField( void ) const { return splineField_; }
   void setSplineField( DefoSplineField const& field ) { splineField_ = field; isSplineField_ = true; }
   DefoPointFields const& getPointFields( void ) const { return pointFields_; }
+  DefoPointField const& getPointFieldX( void ) const { return pointFields_.first; }
+  /// falls back to the along-x field as long as no separate along-y field is set
+  DefoPointField const& getPointFieldY( void ) const {
+    return pointFields_.second.empty() ? pointFields_.first : pointFields_.second;
+  }
   void setPointFields( DefoPointFields const& fields ) { pointFields_ = fields; isPoints_ = true; }
 
   void dumpSplineField(std::string filename) const;
@@ -104,7 +110,7 @@ class DefoSurface {
   void fitSpline2D(int kx, int ky, double s, double nxy);
 
  private:
-  DefoPointCollection points_;
+  DefoPointStore points_;
   DefoSplineField splineField_;
   DefoPointFields pointFields_;
   
@@ -0,0 +1,162 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include "DefoThresholdOverlay.h"
+
+DefoROISpanMask::DefoROISpanMask()
+  : width_(0),
+    height_(0)
+{
+
+}
+
+DefoROISpanMask::DefoROISpanMask(const QPolygonF& polygon, int width, int height)
+  : width_(width),
+    height_(height),
+    rows_(height)
+{
+  const int n = polygon.size();
+  if (n<3) return;
+
+  std::vector<double> crossings;
+
+  for (int y=0;y<height;++y) {
+
+    const double py = (double)y / height;
+
+    // x of all edges crossing the row, in pixel units; the polygon is closed
+    crossings.clear();
+    for (int i=0;i<n;++i) {
+      const QPointF& p1 = polygon.at(i);
+      const QPointF& p2 = polygon.at((i+1)%n);
+      if ((p1.y()<=py && p2.y()>py) || (p2.y()<=py && p1.y()>py)) {
+        double x = p1.x() + (py - p1.y()) * (p2.x() - p1.x()) / (p2.y() - p1.y());
+        crossings.push_back(x * width);
+      }
+    }
+
+    std::sort(crossings.begin(), crossings.end());
+
+    // pixels right of an odd number of crossings are inside
+    std::vector<Span>& row = rows_[y];
+    for (size_t i=0;i+1<crossings.size();i+=2) {
+      int begin = std::max(0, (int)std::floor(crossings[i]) + 1);
+      int end = std::min(width, (int)std::floor(crossings[i+1]) + 1);
+      if (begin<end) row.push_back(Span(begin, end));
+    }
+  }
+}
+
+DefoThresholdOverlay::DefoThresholdOverlay()
+  : imageKey_(0)
+{
+
+}
+
+std::shared_ptr<const DefoThresholdOverlay::Luminance>
+DefoThresholdOverlay::createLuminance(const QImage& image)
+{
+  std::shared_ptr<Luminance> luminance(new Luminance);
+  luminance->width = image.width();
+  luminance->height = image.height();
+  luminance->data.resize((size_t)image.width() * image.height());
+
+  QImage source = image;
+  if (source.format()!=QImage::Format_RGB32 &&
+      source.format()!=QImage::Format_ARGB32) {
+    source = source.convertToFormat(QImage::Format_RGB32);
+  }
+
+  // same weights as qGray(), in integer arithmetic the compiler vectorizes
+  for (int y=0;y<source.height();++y) {
+    const QRgb* line = reinterpret_cast<const QRgb*>(source.constScanLine(y));
+    uchar* dst = &luminance->data[(size_t)y * source.width()];
+    for (int x=0;x<source.width();++x) {
+      const unsigned int rgb = line[x];
+      dst[x] = (((rgb >> 16) & 0xff) * 11 + ((rgb >> 8) & 0xff) * 16 + (rgb & 0xff) * 5) / 32;
+    }
+  }
+
+  return luminance;
+}
+
+QImage DefoThresholdOverlay::render(const QImage& image, const QPolygonF* roi,
+                                    int threshold1, int threshold2, int threshold3,
+                                    const std::atomic<bool>* cancel)
+{
+  if (image.isNull()) return QImage();
+
+  std::shared_ptr<const Luminance> luminance;
+  std::shared_ptr<const DefoROISpanMask> mask;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (image.cacheKey()==imageKey_) luminance = luminance_;
+    if (roi && mask_ && *roi==roi_ &&
+        mask_->width()==image.width() && mask_->height()==image.height()) {
+      mask = mask_;
+    }
+  }
+
+  if (!luminance) {
+    luminance = createLuminance(image);
+    std::lock_guard<std::mutex> lock(mutex_);
+    imageKey_ = image.cacheKey();
+    luminance_ = luminance;
+  }
+
+  if (roi && !mask) {
+    mask.reset(new DefoROISpanMask(*roi, image.width(), image.height()));
+    std::lock_guard<std::mutex> lock(mutex_);
+    roi_ = *roi;
+    mask_ = mask;
+  }
+
+  // colour according to brightness
+  QRgb lut[256];
+  for (int gray=0;gray<256;++gray) {
+    if (gray > threshold3)
+      lut[gray] = 0xFF0000FF;
+    else if (gray > threshold2)
+      lut[gray] = 0xFF00FF00;
+    else if (gray > threshold1)
+      lut[gray] = 0xFFFF0000;
+    else
+      lut[gray] = 0xFF000000;
+  }
+
+  QImage result = image.convertToFormat(QImage::Format_RGB32);
+  const int width = result.width();
+
+  for (int y=0;y<result.height();++y) {
+
+    if (cancel && cancel->load()) return QImage();
+
+    const uchar* gray = &luminance->data[(size_t)y * width];
+    QRgb* line = reinterpret_cast<QRgb*>(result.scanLine(y));
+
+    if (mask) {
+      const std::vector<DefoROISpanMask::Span>& spans = mask->spans(y);
+      for (std::vector<DefoROISpanMask::Span>::const_iterator it = spans.begin();
+           it!=spans.end();
+           ++it) {
+        for (int x=it->first;x<it->second;++x) line[x] = lut[gray[x]];
+      }
+    } else {
+      for (int x=0;x<width;++x) line[x] = lut[gray[x]];
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,86 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DEFOTHRESHOLDOVERLAY_H
+#define DEFOTHRESHOLDOVERLAY_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QImage>
+#include <QPolygonF>
+
+/**
+  \brief Horizontal pixel spans [begin, end) of a rasterized polygon, per row.
+  \par The polygon is given in coordinates relative to the image size. A pixel
+  (x, y) is inside if the point (x/width, y/height) is inside the polygon
+  with the odd-even rule, i.e. the same test as DefoROI::containsPoint().
+  */
+class DefoROISpanMask
+{
+public:
+
+  typedef std::pair<int,int> Span;
+
+  DefoROISpanMask();
+  DefoROISpanMask(const QPolygonF& polygon, int width, int height);
+
+  int width() const { return width_; }
+  int height() const { return height_; }
+  const std::vector<Span>& spans(int y) const { return rows_[y]; }
+
+protected:
+
+  int width_;
+  int height_;
+  std::vector<std::vector<Span> > rows_;
+};
+
+/**
+  \brief Renders the threshold classes of an image as false colours.
+  \par The luminance plane of the image and the span mask of the ROI are
+  computed once and cached, so that a change of the thresholds only runs a
+  row-major lookup table pass over the luminance of the pixels inside the
+  ROI. render() may be called from a worker thread and stops early, returning
+  a null image, once cancel is set.
+  */
+class DefoThresholdOverlay
+{
+public:
+
+  DefoThresholdOverlay();
+
+  /// roi==0 classifies the whole image
+  QImage render(const QImage& image, const QPolygonF* roi,
+                int threshold1, int threshold2, int threshold3,
+                const std::atomic<bool>* cancel = 0);
+
+protected:
+
+  struct Luminance {
+    int width;
+    int height;
+    std::vector<uchar> data;
+  };
+
+  static std::shared_ptr<const Luminance> createLuminance(const QImage& image);
+
+  std::mutex mutex_;
+  qint64 imageKey_;
+  std::shared_ptr<const Luminance> luminance_;
+  QPolygonF roi_;
+  std::shared_ptr<const DefoROISpanMask> mask_;
+};
+
+#endif // DEFOTHRESHOLDOVERLAY_H
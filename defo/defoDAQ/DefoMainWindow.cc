@@ -250,20 +250,21 @@ void DefoMainWindow::prepareNewMeasurement()
   listModel_->clear();
 }
 
-void DefoMainWindow::newCameraImage(QString location, bool keep)
+void DefoMainWindow::newCameraImage(QString /* location */, bool keep)
 {
   QMutexLocker locker(&mutex_);
   
+  // the picture was downloaded into memory and is already decoded
   if (!keep) {
 
-    DefoMeasurement * measurement = new DefoMeasurement(location, true);
+    DefoMeasurement * measurement = new DefoMeasurement(cameraModel_->getLastPicture(), true);
 
     listModel_->addMeasurement(measurement);
     selectionModel_->setSelection(measurement);
 
   } else {
 
-    DefoMeasurement * measurement = new DefoMeasurement(location, false);
+    DefoMeasurement * measurement = new DefoMeasurement(cameraModel_->getLastPicture(), false);
 
     // TODO save when needed, i.e. always from now on
     QDateTime dt = measurement->getTimeStamp();
@@ -275,14 +276,12 @@ void DefoMainWindow::newCameraImage(QString location, bool keep)
     QString imageLocation = currentDir_.absoluteFilePath("%1_1.jpg");
     imageLocation = imageLocation.arg(dt.toString("yyyyMMddhhmmss"));
 
-    measurement->setImageLocation(imageLocation);
-
-    QFile file(cameraModel_->getLastPictureLocation());
-    file.copy(imageLocation);
-    file.close();
+    // archival copy is written in the background, the image stays in memory
+    // until the file can be read back
+    measurement->setImageLocation(imageLocation, cameraModel_->writeLastPicture(imageLocation));
 
     // acquire status information and store in measurement
-    measurement->readExifData();
+    measurement->readExifData(cameraModel_->getLastPictureData());
     measurement->acquireData(cameraModel_);
     measurement->acquireData(pointModel_);
     measurement->acquireData(conradModel_);
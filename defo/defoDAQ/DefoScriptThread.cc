@@ -1,5 +1,4 @@
-#include <chrono>
-#include <thread>
+#include <iostream>
 
 #include <QDebug>
 
@@ -19,6 +18,8 @@ DefoScriptThread::DefoScriptThread(
   , QObject *parent
 ) :
     QThread(parent)
+  , engine_(0)
+  , runtime_(0)
   , scriptModel_(scriptModel)
   , conradModel_(conradModel)
   , cameraModel_(cameraModel)
@@ -34,6 +35,7 @@ void DefoScriptThread::executeScript(const QString & script)
 
   engine_ = new QScriptEngine();
   engine_->setProcessEventsInterval(1000);
+  runtime_ = new ScriptRuntime(engine_);
 
   DefoScriptableGlobals *globalsObj = new DefoScriptableGlobals(scriptModel_, this);
   QScriptValue globalsValue = engine_->newQObject(globalsObj);
@@ -60,9 +62,10 @@ void DefoScriptThread::executeScript(const QString & script)
 
 void DefoScriptThread::abortScript() {
   std::cout << "abort" << std::endl;
-  if (engine_) {
+  QMutexLocker locker(&mutex_);
+  if (runtime_) {
     std::cout << "abort " << (int)engine_->isEvaluating() << std::endl;
-    engine_->abortEvaluation();
+    runtime_->abort();
     //delete engine_;
     //engine_ = 0;
     //terminate();
@@ -71,18 +74,17 @@ void DefoScriptThread::abortScript() {
 
 void DefoScriptThread::run() {
 
-  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  runtime_->evaluate(script_, "defoDAQ script");
 
-  if (engine_->canEvaluate(script_)) {
-    QScriptValue fun = engine_->evaluate(script_);
-    //QScriptContext * context = engine_->pushContext();
-    //QScriptValue v = context->activationObject();
-    //v.setProperty("fun", fun);
-    //engine_->evaluate("fun()");
-    //engine_->popContext();
-    delete engine_;
+  // cleared before the delete, so that a concurrent abortScript() does not use them
+  QScriptEngine* engine;
+  {
+    QMutexLocker locker(&mutex_);
+    engine = engine_;
     engine_ = 0;
-  } else {
-    qDebug() << script_;
+    runtime_ = 0;
   }
+
+  // the engine owns and deletes the runtime
+  delete engine;
 }
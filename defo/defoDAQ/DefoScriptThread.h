@@ -3,8 +3,11 @@
 
 #include <QObject>
 #include <QThread>
+#include <QMutex>
 #include <QScriptEngine>
 
+#include "ScriptRuntime.h"
+
 class DefoScriptModel;
 
 #include "DefoConradModel.h"
@@ -32,6 +35,9 @@ protected:
 
   QString script_;
   QScriptEngine* engine_;
+  ScriptRuntime* runtime_;
+  // guards engine_ and runtime_ between abortScript() and the end of run()
+  QMutex mutex_;
 
   DefoScriptModel* scriptModel_;
   DefoConradModel* conradModel_;
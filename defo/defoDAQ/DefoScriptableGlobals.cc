@@ -7,6 +7,7 @@
 
 #include <nqlogger.h>
 #include <SlackBot.h>
+#include <ScriptRuntime.h>
 
 #include "DefoScriptableGlobals.h"
 
@@ -20,23 +21,22 @@ DefoScriptableGlobals::DefoScriptableGlobals(
 
 void DefoScriptableGlobals::wait(int seconds) {
 
-  static QString TIME_FORMAT = "yyyy-MM-dd hh:mm:ss";
+  ScriptRuntime::waitLogged(seconds, "defoDAQ", [this](const QString& text) { this->message(text); });
+}
+
+void DefoScriptableGlobals::waitPeriod(int seconds) {
 
-  QString message;
-  QDateTime dt = QDateTime::currentDateTime().addSecs(seconds);
+  ScriptRuntime::waitPeriodLogged(seconds, "defoDAQ", [this](const QString& text) { this->message(text); });
+}
 
-  message = QString("wait for %1 second(s)").arg(seconds);
-  this->message(message);
-  NQLog("defoDAQ") << message;
+void DefoScriptableGlobals::waitUntil(uint utime) {
 
-  message = QString("estimated time of completion: %1 ...").arg(dt.toString(TIME_FORMAT));
-  this->message(message);
-  NQLog("defoDAQ") << message;
+  ScriptRuntime::waitUntilLogged(utime, "defoDAQ", [this](const QString& text) { this->message(text); });
+}
 
-  sleep(seconds);
+QScriptValue DefoScriptableGlobals::waitFor(QScriptValue condition, int timeout, int interval) {
 
-  this->message("done");
-  NQLog("defoDAQ") << "done";
+  return QScriptValue(ScriptRuntime::waitForLogged(condition, timeout, interval, "defoDAQ"));
 }
 
 void DefoScriptableGlobals::message(int value) {
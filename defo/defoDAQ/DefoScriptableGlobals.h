@@ -19,6 +19,9 @@ public:
 public slots:
 
   void wait(int seconds);
+  void waitPeriod(int seconds);
+  void waitUntil(uint utime);
+  QScriptValue waitFor(QScriptValue condition, int timeout, int interval = 1);
   void message(int value);
   void message(uint value);
   void message(double value);
@@ -0,0 +1,151 @@
+#include <algorithm>
+
+#include <nqlogger.h>
+
+#include "DefoImagePyramid.h"
+
+DefoImagePyramid::DefoImagePyramid()
+  : cacheKey_(0)
+{
+  // tile costs are in kB, keep at most 64 MB of tiles
+  tiles_.setMaxCost(64*1024);
+}
+
+void DefoImagePyramid::clear()
+{
+  cacheKey_ = 0;
+  sizes_.clear();
+  levels_.clear();
+  tiles_.clear();
+  tileDrawingSize_ = QSize();
+}
+
+void DefoImagePyramid::setImage(const QImage& image)
+{
+  if (image.isNull()) {
+    clear();
+    return;
+  }
+
+  if (!sizes_.empty() && image.cacheKey()==cacheKey_) return;
+
+  clear();
+  cacheKey_ = image.cacheKey();
+
+  // halve the size until the level fits in a single tile
+  sizes_.push_back(image.size());
+  while (sizes_.back().width()>TileSize || sizes_.back().height()>TileSize) {
+    sizes_.push_back(QSize(std::max(1, sizes_.back().width()/2),
+                           std::max(1, sizes_.back().height()/2)));
+  }
+  levels_.resize(sizes_.size());
+
+  if (image.format()==QImage::Format_RGB32) {
+    levels_[0] = image;
+  } else {
+    levels_[0] = image.convertToFormat(QImage::Format_RGB32);
+  }
+
+  NQLogDebug("DefoImagePyramid") << "setImage(): "
+                                 << sizes_.size() << " levels for "
+                                 << image.width() << "x" << image.height();
+}
+
+/// Returns the image of the given level, computing it from the level above if necessary.
+const QImage& DefoImagePyramid::getLevel(int level)
+{
+  if (levels_[level].isNull()) {
+    levels_[level] = getLevel(level-1).scaled(sizes_[level],
+                                              Qt::IgnoreAspectRatio,
+                                              Qt::SmoothTransformation);
+  }
+  return levels_[level];
+}
+
+/// Returns the smallest level that is at least as large as drawingSize.
+int DefoImagePyramid::selectLevel(const QSize& drawingSize) const
+{
+  int level = 0;
+  while (level+1<(int)sizes_.size() &&
+         sizes_[level+1].width()>=drawingSize.width() &&
+         sizes_[level+1].height()>=drawingSize.height()) {
+    ++level;
+  }
+  return level;
+}
+
+/**
+  Samples the pixels of tile (given in drawing coordinates) from source
+  with nearest neighbour interpolation, like QImage::scaled() does by
+  default. Each drawing pixel maps to the same source pixel as it would in a
+  scaled copy of the whole level, hence tiles join without seams.
+  */
+QImage DefoImagePyramid::createTile(const QImage& source, const QSize& drawingSize,
+                                    const QRect& tile) const
+{
+  const double scaleX = (double)source.width() / drawingSize.width();
+  const double scaleY = (double)source.height() / drawingSize.height();
+
+  QImage result(tile.size(), QImage::Format_RGB32);
+
+  std::vector<int> columns(tile.width());
+  for (int x=0;x<tile.width();++x) {
+    int sx = (int)((tile.x() + x + 0.5) * scaleX);
+    columns[x] = std::min(sx, source.width()-1);
+  }
+
+  for (int y=0;y<tile.height();++y) {
+    int sy = std::min((int)((tile.y() + y + 0.5) * scaleY), source.height()-1);
+    const QRgb* src = reinterpret_cast<const QRgb*>(source.constScanLine(sy));
+    QRgb* dst = reinterpret_cast<QRgb*>(result.scanLine(y));
+    for (int x=0;x<tile.width();++x) {
+      dst[x] = src[columns[x]];
+    }
+  }
+
+  return result;
+}
+
+void DefoImagePyramid::draw(QPainter& painter, const QRect& exposed,
+                            const QSize& drawingSize)
+{
+  if (sizes_.empty() || drawingSize.isEmpty()) return;
+
+  // tiles of a different zoom level are of no further use
+  if (drawingSize!=tileDrawingSize_) {
+    tiles_.clear();
+    tileDrawingSize_ = drawingSize;
+  }
+
+  QRect area = exposed.intersected(QRect(QPoint(0, 0), drawingSize));
+  if (area.isEmpty()) return;
+
+  const QImage& source = getLevel(selectLevel(drawingSize));
+
+  int txMin = area.left() / TileSize;
+  int txMax = area.right() / TileSize;
+  int tyMin = area.top() / TileSize;
+  int tyMax = area.bottom() / TileSize;
+
+  for (int ty=tyMin;ty<=tyMax;++ty) {
+    for (int tx=txMin;tx<=txMax;++tx) {
+
+      QRect tile(tx*TileSize, ty*TileSize, TileSize, TileSize);
+      tile = tile.intersected(QRect(QPoint(0, 0), drawingSize));
+
+      quint64 key = ((quint64)tx << 32) | (quint32)ty;
+      QImage* image = tiles_.object(key);
+      if (image==0) {
+        image = new QImage(createTile(source, drawingSize, tile));
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+        const qint64 bytes = image->sizeInBytes();
+#else
+        const qint64 bytes = image->byteCount();
+#endif
+        tiles_.insert(key, image, static_cast<int>(std::max<qint64>(1, bytes / 1024)));
+      }
+
+      painter.drawImage(tile.topLeft(), *image);
+    }
+  }
+}
@@ -0,0 +1,52 @@
+#ifndef DEFOIMAGEPYRAMID_H
+#define DEFOIMAGEPYRAMID_H
+
+#include <vector>
+
+#include <QImage>
+#include <QCache>
+#include <QPainter>
+#include <QRect>
+#include <QSize>
+
+/**
+  \brief Tiled, mip-mapped rendering of large images.
+  \par The source image is reduced to a pyramid of levels with half the size
+  of the previous level each. Levels are only computed once they are needed. For a given drawing size the smallest level
+  that is still at least as large is sampled into tiles of TileSize pixels.
+  Tiles are cached for the current image and drawing size, so that panning
+  and repainting only draw the tiles intersecting the exposed rectangle and
+  rescale nothing that was shown before.
+  */
+class DefoImagePyramid
+{
+public:
+
+  static const int TileSize = 256;
+
+  DefoImagePyramid();
+
+  /// (re)builds the pyramid if image differs from the current source image
+  void setImage(const QImage& image);
+  void clear();
+
+  bool isNull() const { return sizes_.empty(); }
+
+  /// draws the image scaled to drawingSize at (0,0), limited to exposed
+  void draw(QPainter& painter, const QRect& exposed, const QSize& drawingSize);
+
+protected:
+
+  int selectLevel(const QSize& drawingSize) const;
+  const QImage& getLevel(int level);
+  QImage createTile(const QImage& source, const QSize& drawingSize, const QRect& tile) const;
+
+  qint64 cacheKey_;
+  std::vector<QSize> sizes_;
+  std::vector<QImage> levels_;
+
+  QSize tileDrawingSize_;
+  QCache<quint64,QImage> tiles_;
+};
+
+#endif // DEFOIMAGEPYRAMID_H
@@ -4,6 +4,8 @@
 
 #include "DefoOfflinePreparationModel.h"
 #include "DefoPointSaver.h"
+#include "DefoPointFile.h"
+#include "DefoPointStore.h"
 
 DefoOfflinePreparationModel::DefoOfflinePreparationModel(DefoMeasurementListModel * listModel,
                                                          DefoMeasurementSelectionModel* refSelectionModel,
@@ -131,16 +133,14 @@ void DefoOfflinePreparationModel::prepare()
 
   pointIndexer_->indexPoints(&defoCollection_, defoColor_);
 
-  QString filename = "offlinePoints_%1.xml";
+  QString filename = "offlinePoints_%1" + DefoPointFile::BinarySuffix;
   QString fileLocation;
 
   fileLocation = currentDir_.absoluteFilePath(filename.arg(refMeasurement_->getTimeStamp().toString("yyyyMMddhhmmss")));
-  DefoPointSaver refSaver(fileLocation);
-  refSaver.writeXMLPoints(refCollection_);
+  DefoPointFile::write(fileLocation, refCollection_);
 
   fileLocation = currentDir_.absoluteFilePath(filename.arg(defoMeasurement_->getTimeStamp().toString("yyyyMMddhhmmss")));
-  DefoPointSaver defoSaver(fileLocation);
-  defoSaver.writeXMLPoints(defoCollection_);
+  DefoPointFile::write(fileLocation, defoCollection_);
 
   filename = "offlinePoints_%1.txt";
 
@@ -156,31 +156,15 @@ void DefoOfflinePreparationModel::prepare()
 bool DefoOfflinePreparationModel::alignPoints(const DefoPointCollection* original,
                                               DefoPointCollection& aligned)
 {
-  aligned.clear();
-
   if (angle_==0.0) {
-    for (DefoPointCollection::const_iterator it = original->begin();
-         it!=original->end();
-         ++it) {
-      aligned.push_back(*it);
-    }
+    aligned = *original;
     return true;
-  } else {
-
-    double c = std::cos(angle_);
-    double s = std::sin(angle_);
-
-    for (DefoPointCollection::const_iterator it = original->begin();
-         it!=original->end();
-         ++it) {
-      const DefoPoint& p = *it;
-      DefoPoint np(p);
-      np.setX(p.getX()*c - p.getY()*s);
-      np.setY(p.getX()*s + p.getY()*c);
-
-      aligned.push_back(np);
-    }
   }
 
+  // rotate the contiguous x/y columns in one pass
+  DefoPointStore store(*original);
+  store.rotate(angle_);
+  store.toCollection(aligned);
+
   return true;
 }
@@ -27,9 +27,20 @@ QSize DefoRecoImageContentWidget::getImageDrawingSize(const QImage& image) const
   return zoomModel_->getZoomedSize(size(), image);
 }
 
-QImage DefoRecoImageContentWidget::prepareImage(const QImage& image) const
+/// Returns the image to be drawn, by default the image of the selected measurement.
+QImage DefoRecoImageContentWidget::getSourceImage() const
 {
-  return image.scaled(getImageDrawingSize(image) /*, Qt::KeepAspectRatio */);
+  return selectionModel_->getSelection()->getImage();
+}
+
+/// Draws the part of the zoomed source image that intersects exposed.
+void DefoRecoImageContentWidget::drawImage(QPainter& painter, const QRect& exposed)
+{
+  QImage image = getSourceImage();
+  pyramid_.setImage(image);
+  if (pyramid_.isNull()) return;
+
+  pyramid_.draw(painter, exposed, getImageDrawingSize(image));
 }
 
 void DefoRecoImageContentWidget::paintEvent(QPaintEvent *event)
@@ -38,7 +49,6 @@ void DefoRecoImageContentWidget::paintEvent(QPaintEvent *event)
 
   // std::cout << event->rect().x() << ", "  << event->rect().y() << ", "  << event->rect().width() << ", "  << event->rect().height() << std::endl;
 
-  // TODO repaint only certain rectangle
   QWidget::paintEvent(event);
 
   if (selectionModel_->getSelection() != NULL) {
@@ -51,14 +61,8 @@ void DefoRecoImageContentWidget::paintEvent(QPaintEvent *event)
       */
     painter.save();
 
-    const DefoMeasurement* measurement = selectionModel_->getSelection();
-    QImage prepared = prepareImage(measurement->getImage());
-
-    //painter.translate(prepared.height(), 0);
-    //painter.rotate(90);
-
-    // Draw image
-    painter.drawImage( QPoint(event->rect().x(), event->rect().y()), prepared , event->rect());
+    // Draw the tiles of the exposed area only
+    drawImage(painter, event->rect());
 
     // Restore own state.
     painter.restore();
@@ -94,7 +98,6 @@ void DefoRecoROIImageContentWidget::paintEvent(QPaintEvent *event)
 
   // std::cout << event->rect().x() << ", "  << event->rect().y() << ", "  << event->rect().width() << ", "  << event->rect().height() << std::endl;
 
-  // TODO repaint only certain rectangle
   QWidget::paintEvent(event);
 
   if (selectionModel_->getSelection() != NULL) {
@@ -107,14 +110,8 @@ void DefoRecoROIImageContentWidget::paintEvent(QPaintEvent *event)
       */
     painter.save();
 
-    const DefoMeasurement* measurement = selectionModel_->getSelection();
-    QImage prepared = prepareImage(measurement->getImage());
-
-    //painter.translate(prepared.height(), 0);
-    //painter.rotate(90);
-    
-    // Draw image
-    painter.drawImage( QPoint(event->rect().x(), event->rect().y()), prepared , event->rect());
+    // Draw the tiles of the exposed area only
+    drawImage(painter, event->rect());
 
     float width = this->width();
     float height = this->height();
@@ -169,6 +166,12 @@ DefoRecoImageThresholdsContentWidget::DefoRecoImageThresholdsContentWidget(DefoM
           this, SLOT(roiChanged(bool)));
 
   needsUpdate_ = false;
+  overlayGeneration_ = 0;
+}
+
+DefoRecoImageThresholdsContentWidget::~DefoRecoImageThresholdsContentWidget()
+{
+  cancelUpdate();
 }
 
 bool DefoRecoImageThresholdsContentWidget::event(QEvent* event)
@@ -177,13 +180,9 @@ bool DefoRecoImageThresholdsContentWidget::event(QEvent* event)
   return QWidget::event(event);
 }
 
-QImage DefoRecoImageThresholdsContentWidget::prepareImage(const QImage& /*image*/) const
+QImage DefoRecoImageThresholdsContentWidget::getSourceImage() const
 {
-  if ( !imageCache_.isNull() )
-    return imageCache_.scaled(getImageDrawingSize(imageCache_),
-                              Qt::KeepAspectRatio);
-  else
-    return QImage();
+  return imageCache_;
 }
 
 void DefoRecoImageThresholdsContentWidget::thresholdChanged(DefoPointRecognitionModel::Threshold /* threshold */,
@@ -197,6 +196,8 @@ void DefoRecoImageThresholdsContentWidget::thresholdChanged(DefoPointRecognition
 
 void DefoRecoImageThresholdsContentWidget::selectionChanged(DefoMeasurement* measurement)
 {
+  // do not show the overlay of the previous measurement in the meantime
+  imageCache_ = QImage();
   needsUpdate_ = true;
   updateCache();
   DefoRecoImageContentWidget::selectionChanged(measurement);
@@ -209,47 +210,60 @@ void DefoRecoImageThresholdsContentWidget::roiChanged(bool nu)
   updateCache();
 }
 
-/// Updates the current image cache.
+/// Cancels a running overlay update and waits for the worker to return.
+void DefoRecoImageThresholdsContentWidget::cancelUpdate()
+{
+  if (overlayCancel_) overlayCancel_->store(true);
+  if (overlayJob_.valid()) overlayJob_.wait();
+}
+
+/**
+  Updates the current image cache. The overlay is rendered on a worker
+  thread; a running update is cancelled and the result is handed back to
+  the GUI thread via overlayReady().
+  */
 void DefoRecoImageThresholdsContentWidget::updateCache()
 {
   if (!isVisible() || !needsUpdate_) return;
 
   needsUpdate_ = false;
 
+  cancelUpdate();
+  ++overlayGeneration_;
+
   const DefoMeasurement* measurement = selectionModel_->getSelection();
 
-  if (measurement != NULL) {
-    imageCache_ = QImage(selectionModel_->getSelection()->getImage());
-    int thres1 = recognitionModel_->getThresholdValue(DefoPointRecognitionModel::THRESHOLD_1);
-    int thres2 = recognitionModel_->getThresholdValue(DefoPointRecognitionModel::THRESHOLD_2);
-    int thres3 = recognitionModel_->getThresholdValue(DefoPointRecognitionModel::THRESHOLD_3);
-
-    QRectF bounds = roiModel_->boundingRect();
-    int xmin = bounds.x()*imageCache_.width();
-    int xmax = (bounds.x()+bounds.width())*imageCache_.width();
-    int ymin = bounds.y()*imageCache_.height();
-    int ymax = (bounds.y()+bounds.height())*imageCache_.height();
-    for (int x=xmin; x<xmax; ++x) {
-      for (int y=ymin; y<ymax; ++y) {
-
-        if (roiModel_->containsPoint(imageCache_.width(), imageCache_.height(),
-                                     x, y)) {
-          int gray = qGray(imageCache_.pixel(x, y));
-
-          // Colour according to brightness
-          if (gray > thres3)
-            imageCache_.setPixel(x, y, 0x0000FF);
-          else if (gray > thres2)
-            imageCache_.setPixel(x, y, 0x00FF00);
-          else if (gray > thres1)
-            imageCache_.setPixel(x, y, 0xFF0000);
-          else
-            imageCache_.setPixel(x, y, 0);
-        }
-      }
-    }
-  } else
+  if (measurement == NULL) {
     imageCache_ = QImage();
+    return;
+  }
+
+  QImage image = measurement->getImage();
+  QPolygonF roi = roiModel_->getPolygon();
+  int thres1 = recognitionModel_->getThresholdValue(DefoPointRecognitionModel::THRESHOLD_1);
+  int thres2 = recognitionModel_->getThresholdValue(DefoPointRecognitionModel::THRESHOLD_2);
+  int thres3 = recognitionModel_->getThresholdValue(DefoPointRecognitionModel::THRESHOLD_3);
+  int generation = overlayGeneration_;
+
+  std::shared_ptr<std::atomic<bool> > cancel(new std::atomic<bool>(false));
+  overlayCancel_ = cancel;
+
+  overlayJob_ = std::async(std::launch::async,
+                           [this, image, roi, thres1, thres2, thres3, generation, cancel]() {
+    QImage result = overlay_.render(image, &roi, thres1, thres2, thres3, cancel.get());
+    if (cancel->load() || result.isNull()) return;
+    QMetaObject::invokeMethod(this, "overlayReady", Qt::QueuedConnection,
+                              Q_ARG(QImage, result), Q_ARG(int, generation));
+  });
+}
+
+void DefoRecoImageThresholdsContentWidget::overlayReady(QImage image, int generation)
+{
+  // drop results of updates that have been superseded in the meantime
+  if (generation!=overlayGeneration_) return;
+
+  imageCache_ = image;
+  update();
 }
 
 DefoRecoImagePointsContentWidget::DefoRecoImagePointsContentWidget(DefoMeasurementListModel* listModel,
@@ -334,7 +348,6 @@ DefoRecoAlignmentImageContentWidget::DefoRecoAlignmentImageContentWidget(DefoMea
 
 void DefoRecoAlignmentImageContentWidget::paintEvent(QPaintEvent *event)
 {
-  // TODO repaint only certain rectangle
   QWidget::paintEvent(event);
 
   if (selectionModel_->getSelection() != NULL) {
@@ -347,14 +360,8 @@ void DefoRecoAlignmentImageContentWidget::paintEvent(QPaintEvent *event)
       */
     painter.save();
 
-    const DefoMeasurement* measurement = selectionModel_->getSelection();
-    QImage prepared = prepareImage(measurement->getImage());
-
-    //painter.translate(prepared.height(), 0);
-    //painter.rotate(90);
-
-    // Draw image
-    painter.drawImage( QPoint(event->rect().x(), event->rect().y()), prepared , event->rect());
+    // Draw the tiles of the exposed area only
+    drawImage(painter, event->rect());
 
     float width = this->width();
     float height = this->height();
@@ -1,6 +1,10 @@
 #ifndef DEFORECOIMAGEWIDGET_H
 #define DEFORECOIMAGEWIDGET_H
 
+#include <atomic>
+#include <future>
+#include <memory>
+
 #include <QScrollArea>
 #include <QWidget>
 #include <QPainter>
@@ -11,6 +15,9 @@
 #include "DefoImageZoomModel.h"
 #include "DefoROIModel.h"
 #include "DefoAlignmentModel.h"
+#include "DefoThresholdOverlay.h"
+
+#include "DefoImagePyramid.h"
 
 class DefoRecoImageContentWidget : public QWidget
 {
@@ -23,7 +30,7 @@ public:
                                       QWidget *parent = 0);
   
   virtual QSize getImageDrawingSize(const QImage& image) const;
-  virtual QImage prepareImage(const QImage& image) const;
+  virtual QImage getSourceImage() const;
 
   virtual void paintEvent(QPaintEvent *event);
 
@@ -33,8 +40,11 @@ public slots:
 
 protected:
 
+  void drawImage(QPainter& painter, const QRect& exposed);
+
   DefoMeasurementSelectionModel* selectionModel_;
   DefoImageZoomModel* zoomModel_;
+  DefoImagePyramid pyramid_;
 };
 
 class DefoRecoRawImageContentWidget : public DefoRecoImageContentWidget
@@ -77,8 +87,9 @@ public:
                                                 DefoPointRecognitionModel* recognitionModel,
                                                 DefoROIModel* roiModel,
                                                 QWidget *parent = 0);
+  ~DefoRecoImageThresholdsContentWidget();
 
-  QImage prepareImage(const QImage& image) const;
+  QImage getSourceImage() const;
 
 public slots:
 
@@ -87,6 +98,10 @@ public slots:
   void selectionChanged(DefoMeasurement* measurement);
   void roiChanged(bool);
 
+protected slots:
+
+  void overlayReady(QImage image, int generation);
+
 protected:
 
   virtual bool event(QEvent* event);
@@ -95,7 +110,13 @@ protected:
   DefoPointRecognitionModel* recognitionModel_;
   QImage imageCache_;
   void updateCache();
+  void cancelUpdate();
   bool needsUpdate_;
+
+  DefoThresholdOverlay overlay_;
+  std::future<void> overlayJob_;
+  std::shared_ptr<std::atomic<bool> > overlayCancel_;
+  int overlayGeneration_;
 };
 
 class DefoRecoImagePointsContentWidget : public DefoRecoImageContentWidget
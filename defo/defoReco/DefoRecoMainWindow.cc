@@ -56,6 +56,10 @@ DefoRecoMainWindow::DefoRecoMainWindow(QWidget *parent)
   defoROIModel_ = new DefoRecoROIModel(defoSelectionModel_, roiModel_, this);
   defoPointModel_ = new DefoPointRecognitionModel(this);
 
+  selectionModel_->setListModel(listModel_);
+  refSelectionModel_->setListModel(listModel_);
+  defoSelectionModel_->setListModel(listModel_);
+
   pointIndexerModel_ = new DefoPointIndexerModel(this);
 
   refColorModel_ = new DefoColorSelectionModel(this);
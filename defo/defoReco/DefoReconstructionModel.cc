@@ -5,7 +5,8 @@
 #include "nqlogger.h"
 
 #include "DefoReconstructionModel.h"
-#include "DefoPointSaver.h"
+#include "DefoPointFile.h"
+#include "DefoPointStore.h"
 
 DefoReconstructionModel::DefoReconstructionModel(DefoMeasurementListModel * listModel,
                                                  DefoMeasurementSelectionModel* refSelectionModel,
@@ -291,23 +292,21 @@ void DefoReconstructionModel::reconstruct()
   }
   emit incrementProgress();
 
-  QString basename = "offlinePoints_%1.xml";
+  QString basename = "offlinePoints_%1" + DefoPointFile::BinarySuffix;
   QString fileLocation;
 
   pointIndexer_->indexPoints(&refCollection_, refColor_);
   emit incrementProgress();
 
   fileLocation = currentDir_.absoluteFilePath(basename.arg(refMeasurement_->getTimeStamp().toString("yyyyMMddhhmmss")));
-  DefoPointSaver refSaver(fileLocation);
-  refSaver.writeXMLPoints(refCollection_);
+  DefoPointFile::write(fileLocation, refCollection_);
   emit incrementProgress();
 
   pointIndexer_->indexPoints(&defoCollection_, defoColor_);
   emit incrementProgress();
 
   fileLocation = currentDir_.absoluteFilePath(basename.arg(defoMeasurement_->getTimeStamp().toString("yyyyMMddhhmmss")));
-  DefoPointSaver defoSaver(fileLocation);
-  defoSaver.writeXMLPoints(defoCollection_);
+  DefoPointFile::write(fileLocation, defoCollection_);
 
   reco_->setFocalLength(refMeasurement_->getFocalLength());
   NQLog("DefoReconstructionModel::reconstruct()", NQLog::Message) << "focalLength [mm]   = " << refMeasurement_->getFocalLength();
@@ -364,31 +363,15 @@ void DefoReconstructionModel::reconstruct()
 bool DefoReconstructionModel::alignPoints(const DefoPointCollection* original,
                                           DefoPointCollection& aligned)
 {
-  aligned.clear();
-
   if (angle_==0.0) {
-    for (DefoPointCollection::const_iterator it = original->begin();
-         it!=original->end();
-         ++it) {
-      aligned.push_back(*it);
-    }
+    aligned = *original;
     return true;
-  } else {
-
-    double c = std::cos(angle_);
-    double s = std::sin(angle_);
-
-    for (DefoPointCollection::const_iterator it = original->begin();
-         it!=original->end();
-         ++it) {
-      const DefoPoint& p = *it;
-      DefoPoint np(p);
-      np.setX(p.getX()*c - p.getY()*s);
-      np.setY(p.getX()*s + p.getY()*c);
-
-      aligned.push_back(np);
-    }
   }
 
+  // rotate the contiguous x/y columns in one pass
+  DefoPointStore store(*original);
+  store.rotate(angle_);
+  store.toCollection(aligned);
+
   return true;
 }
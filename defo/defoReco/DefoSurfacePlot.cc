@@ -126,7 +126,7 @@ void DefoSurfacePlot::setData(DefoSurface const& surface)
     amplitudeRange_ = std::pair<double,double>( 0., 0. );
 
     // set x or y field, according to what has been chosen
-    DefoPointField const& field = POINTS_X==pointSet_ ? surface.getPointFields().first : surface.getPointFields().second;
+    DefoPointField const& field = POINTS_X==pointSet_ ? surface.getPointFieldX() : surface.getPointFieldY();
 
     // determine its dimensions
     std::pair<unsigned int, unsigned int> indexRange;
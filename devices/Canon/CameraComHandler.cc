@@ -241,6 +241,41 @@ bool CameraComHandler::acquireAndDownloadPicture(int filedescriptor) const {
   return (error == GP_OK);
 }
 
+/**
+  \brief Instructs the camera to take a picture and downloads it into memory.
+  The picture is removed from the camera afterwards.
+  \arg data buffer receiving the content of the picture file.
+  \return true if picture was acquired and downloaded, false otherwise.
+ */
+bool CameraComHandler::acquireAndDownloadPicture(std::vector<char>& data) const {
+
+  data.clear();
+
+  CameraFile *file;
+  gp_file_new(&file);
+
+  // Take and download the picture
+  CameraFilePath path;
+  int error = gp_camera_capture(camera_, GP_CAPTURE_IMAGE, &path, context_);
+  if (error == GP_OK) {
+    error = gp_camera_file_get(camera_,
+                               path.folder,
+                               path.name,
+                               GP_FILE_TYPE_NORMAL,
+                               file,
+                               context_);
+
+    // Remove from camera
+    gp_camera_file_delete(camera_, path.folder, path.name, context_);
+  }
+
+  bool success = (error == GP_OK) && copyFileData(file, data);
+
+  gp_file_unref(file);
+
+  return success;
+}
+
 /**
   \brief Instructs the camera to take a preview picture, downloads it and writes
   it in the file given by filename. In order to do this, the file needs to have
@@ -263,6 +298,28 @@ bool CameraComHandler::acquirePreview(const char* filename) const {
   return (error == GP_OK);
 }
 
+/**
+  \brief Instructs the camera to take a preview picture and downloads it into
+  memory.
+  \arg data buffer receiving the content of the preview picture file.
+  \return true if picture was acquired and downloaded, false otherwise.
+ */
+bool CameraComHandler::acquirePreview(std::vector<char>& data) const {
+
+  data.clear();
+
+  CameraFile *file;
+  gp_file_new(&file);
+
+  int error = gp_camera_capture_preview(camera_, file, context_);
+
+  bool success = (error == GP_OK) && copyFileData(file, data);
+
+  gp_file_unref(file);
+
+  return success;
+}
+
 /**
   \brief Switches camera into preview mode.
   \return true if operation was successful, false otherwise.
@@ -292,3 +349,17 @@ bool CameraComHandler::stopPreviewMode() const {
 
   return (error == GP_OK);
 }
+
+/// Copies the content of a downloaded camera file into data.
+bool CameraComHandler::copyFileData(CameraFile* file, std::vector<char>& data) {
+
+  const char* fileData = NULL;
+  unsigned long int fileSize = 0;
+
+  if (gp_file_get_data_and_size(file, &fileData, &fileSize) != GP_OK) return false;
+  if (fileData == NULL || fileSize == 0) return false;
+
+  data.assign(fileData, fileData + fileSize);
+
+  return true;
+}
@@ -33,7 +33,9 @@ public:
   bool writeConfigValue(const char* name, const char* value);
 
   bool acquireAndDownloadPicture(int filedescriptor) const;
+  bool acquireAndDownloadPicture(std::vector<char>& data) const;
   bool acquirePreview(const char* filename) const;
+  bool acquirePreview(std::vector<char>& data) const;
   bool startPreviewMode() const;
   bool stopPreviewMode() const;
 
@@ -45,6 +47,8 @@ protected:
   CameraAbilities abilities_;
   GPPortInfoList* infoList_;
   GPPortInfo info_;
+
+  static bool copyFileData(CameraFile* file, std::vector<char>& data);
 };
 
 #endif // CAMERACOMHANDLER_H
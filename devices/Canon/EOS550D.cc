@@ -119,6 +119,25 @@ std::string EOS550D::acquirePreview() {
   return previewFileName_;
 }
 
+/**
+  \brief Captures an image with the camera and downloads it into memory.
+  The picture is removed from the camera afterwards. No temporary file is
+  created, so the data can be decoded directly and archived asynchronously.
+ */
+bool EOS550D::acquirePhoto(std::vector<char>& data) {
+
+  return handler_->acquireAndDownloadPicture(data);
+}
+
+/**
+  \brief Captures a preview image with the camera and downloads it into
+  memory.
+ */
+bool EOS550D::acquirePreview(std::vector<char>& data) {
+
+  return handler_->acquirePreview(data);
+}
+
 bool EOS550D::isInPreviewMode() {
 
   return isInPreviewMode_;
@@ -42,6 +42,11 @@ public:
   /// Returns the absolute (local) location of the retrieved preview picture.
   virtual std::string acquirePreview();
 
+  /// Downloads the picture directly into memory, no temporary file is used.
+  virtual bool acquirePhoto(std::vector<char>& data);
+  /// Downloads the preview picture directly into memory.
+  virtual bool acquirePreview(std::vector<char>& data);
+
   virtual bool isInPreviewMode();
   virtual bool startPreviewMode();
   virtual bool stopPreviewMode();
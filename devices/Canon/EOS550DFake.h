@@ -42,8 +42,12 @@ public:
   bool writeOption(const Option &option, int value);
 
   std::string acquirePhoto();
-
   std::string acquirePreview();
+
+  // in-memory transfer goes through the rendered temporary file
+  using VEOS550D::acquirePhoto;
+  using VEOS550D::acquirePreview;
+
   virtual bool isInPreviewMode();
   virtual bool startPreviewMode();
   virtual bool stopPreviewMode();
@@ -10,6 +10,9 @@
 //                                                                             //
 /////////////////////////////////////////////////////////////////////////////////
 
+#include <fstream>
+#include <iterator>
+
 #include "VEOS550D.h"
 
 VEOS550D::VEOS550D(const char* port) {
@@ -30,3 +33,35 @@ int VEOS550D::indexOf(const VEOS550D::OptionList &list, const std::string &value
 
   return i;
 }
+
+/**
+  \brief Default implementation for devices without direct memory transfer:
+  the picture is acquired into a file, which is then read into data.
+ */
+bool VEOS550D::acquirePhoto(std::vector<char>& data) {
+
+  return readFile(acquirePhoto(), data);
+}
+
+/**
+  \brief Default implementation for devices without direct memory transfer:
+  the preview picture is acquired into a file, which is then read into data.
+ */
+bool VEOS550D::acquirePreview(std::vector<char>& data) {
+
+  return readFile(acquirePreview(), data);
+}
+
+/// Reads the complete content of a file into data.
+bool VEOS550D::readFile(const std::string& filename, std::vector<char>& data) {
+
+  data.clear();
+
+  std::ifstream ifile(filename.c_str(), std::ios::binary);
+  if (!ifile.is_open()) return false;
+
+  data.assign(std::istreambuf_iterator<char>(ifile),
+              std::istreambuf_iterator<char>());
+
+  return !data.empty();
+}
@@ -48,6 +48,11 @@ class VEOS550D {
 
   /// Returns the absolute (local) location of the retrieved preview picture.
   virtual std::string acquirePreview() = 0;
+
+  /// Captures a picture and downloads the (JPEG) file content into data.
+  virtual bool acquirePhoto(std::vector<char>& data);
+  /// Captures a preview picture and downloads the file content into data.
+  virtual bool acquirePreview(std::vector<char>& data);
   
   /// Returns true if camera is in preview mode (a.k.a. live view)
   virtual bool isInPreviewMode() = 0;
@@ -60,6 +65,8 @@ protected:
 
   typedef std::vector<std::string> OptionList;
   static int indexOf(const OptionList& list, const std::string& value);
+
+  static bool readFile(const std::string& filename, std::vector<char>& data);
 };
 
 #endif
@@ -389,71 +389,110 @@ void Keyence::ClearStat(int out)
 }
 */
 
-/*
 void Keyence::StartDataStorage()
 {
-  std::string response = SetValue("AS");
-  if(response != "AS"){
-  std::cout << "[Keyence::StartDataStorage] ** ERROR: could not be executed, response : "
-  << response
-  << std::endl;
-  return;
-  }
-  }
-*/
+    std::string response = SetValue("AS");
+    if(response != "AS"){
+        std::cout << "[Keyence::StartDataStorage] ** ERROR: could not be executed, response : "
+	      << response
+	      << std::endl;
+        return;
+    }
+}
 
-/*
 void Keyence::StopDataStorage()
 {
-  std::string response = SetValue("AP");
-  if(response != "AP"){
-  std::cout << "[Keyence::StopDataStorage] ** ERROR: could not be executed, response : "
-  << response
-  << std::endl;
-  return;
-  }
-  }
-*/
+    std::string response = SetValue("AP");
+    if(response != "AP"){
+        std::cout << "[Keyence::StopDataStorage] ** ERROR: could not be executed, response : "
+	      << response
+	      << std::endl;
+        return;
+    }
+}
 
-/*
+//clears the internal buffer; has to be called before a new storage run
 void Keyence::InitDataStorage()
 {
-  std::string response = SetValue("AQ");
-  if(response != "AQ"){
-  std::cout << "[Keyence::InitDataStorage] ** ERROR: could not be executed, response : "
-  << response
-  << std::endl;
-  return;
-  }
-  }
-*/
+    std::string response = SetValue("AQ");
+    if(response != "AQ"){
+        std::cout << "[Keyence::InitDataStorage] ** ERROR: could not be executed, response : "
+	      << response
+	      << std::endl;
+        return;
+    }
+}
 
-/*
-//FIX ME
-void Keyence::OutputDataStorage(int out, std::vector<double> values)
+//bulk download of all values stored for head out since the last InitDataStorage
+//response is AO,value,value,... with out of range values reported as +/-9999
+void Keyence::OutputDataStorage(int out, std::vector<double> & values)
 {
-  std::string response = SetValue("AO,",out,values);
-    if(response != "PW"){
-    std::cout << "[Keyence::OutputDataStorage] ** ERROR: could not be executed, response : "
-    << response
-    << std::endl;
+    values.clear();
+
+    bool storing;
+    int count = 0;
+    DataStorageStatus(storing, count);
+    if(count <= 0){return;}
+
+    std::ostringstream os;
+    os << "AO," << out;
+    SendCommand(os.str());
+
+    //roughly 10 characters per value, allow enough polling cycles for all of them
+    std::string response;
+    char temp[1024];
+    usleep(1000);
+    comHandler_->ReceiveString(response, temp, 1000 + 200*count);
+    StripBuffer(response);
+
+    if(response.find("ER") != std::string::npos || response.compare(0, 2, "AO") != 0){
+        std::cout << "[Keyence::OutputDataStorage] ** ERROR: could not be executed, response : "
+	      << response.substr(0, 32)
+	      << std::endl;
         return;
     }
+
+    values.reserve(count);
+    std::istringstream is(response.substr(2));
+    std::string token;
+    while(std::getline(is, token, ',')){
+        if(token.empty()){continue;}
+        double value;
+        ParseValue(token, value);
+        values.push_back(value);
+    }
 }
-*/
 
-/*
-//FIX ME
-void Keyence::DataStorageStatus(std::string value)
+//storing is true while data storage is running, count is the number of stored values
+void Keyence::DataStorageStatus(bool & storing, int & count)
 {
-  std::string response = SetValue("AN",value);
-    if(response != "PW"){
-    std::cout << "[Keyence::DataStorageStatus] ** ERROR: could not be executed, response : "
-    << response
-    << std::endl;
+    storing = false;
+    count = 0;
+
+    std::string response = SetValue("AN");
+    if(response.find("ER") != std::string::npos || response.compare(0, 3, "AN,") != 0){
+        std::cout << "[Keyence::DataStorageStatus] ** ERROR: could not be executed, response : "
+	      << response
+	      << std::endl;
         return;
     }
+    std::istringstream is(response.substr(3));
+    int status = 0;
+    char separator;
+    is >> status >> separator >> count;
+    storing = (status == 1);
+}
+
+void Keyence::ParseValue(const std::string & token, double & value) const
+{
+    if(token.find("F") != std::string::npos){
+        if(token.find("-") != std::string::npos){value = -9999;}else{value = 9999;}
+        return;
+    }
+    std::istringstream is(token);
+    double temp = 0;
+    is >> temp;
+    value = temp;
 }
-*/
 
 
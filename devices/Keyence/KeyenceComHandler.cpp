@@ -72,6 +72,11 @@ void KeyenceComHandler::SendCommand( const char *commandString )
   See example program in class description.
 */
 void KeyenceComHandler::ReceiveString(std::string & receiveString, char *temp_output, int samplingRate, int averagingRate )
+{
+  ReceiveString(receiveString, temp_output, 1000 + 2*samplingRate*averagingRate);
+}
+
+void KeyenceComHandler::ReceiveString(std::string & receiveString, char *temp_output, int limit )
 {
   if (!fDeviceAvailable) {
     return;
@@ -83,7 +88,6 @@ void KeyenceComHandler::ReceiveString(std::string & receiveString, char *temp_ou
 
   int timeout = 0;
   size_t readResult = 0;
-  int limit = 1000 + 2*samplingRate*averagingRate;
   while ( timeout < limit)  {
 
     readResult = read( fIoPortFileDescriptor, temp_output, 1024 );
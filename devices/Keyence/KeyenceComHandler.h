@@ -43,6 +43,8 @@ class KeyenceComHandler {
   void SendCommand( const char* );
   //  std::string ReceiveString(int samplingRate, int averagingRate );
   void ReceiveString(std::string & receiveString, char *temp_output, int samplingRate, int averagingRate );
+  //! Read with an explicit polling limit, e.g. for long data storage dumps.
+  void ReceiveString(std::string & receiveString, char *temp_output, int limit );
 
   bool DeviceAvailable();
 
@@ -20,6 +20,7 @@
 #include <utility>
 #include <fstream>
 #include <cmath>
+#include <vector>
 
 #include "VKeyence.h"
 #include "KeyenceComHandler.h"
@@ -58,12 +59,12 @@ class KeyenceFake : public VKeyence
   /*
   void StatResultOutput(int out, std::string value);
   void ClearStat(int out);
+  */
   void StartDataStorage();
   void StopDataStorage();
   void InitDataStorage();
-  void OutputDataStorage(int out, std::vector<double> values);
-  void DataStorageStatus(std::string value);
-  */
+  void OutputDataStorage(int out, std::vector<double> & values);
+  void DataStorageStatus(bool & storing, int & count);
 
   //for initialization
   //communicationspeed;
@@ -78,6 +79,7 @@ class KeyenceFake : public VKeyence
  private:
 
   void StripBuffer( std::string &) const;
+  void ParseValue(const std::string &, double &) const;
   void DeviceInit();
 
   KeyenceComHandler* comHandler_;
@@ -46,12 +46,12 @@ class VKeyence {
   /*
   virtual void StatResultOutput(int out, std::string value) = 0;
   virtual void ClearStat(int out) = 0;
+  */
   virtual void StartDataStorage() = 0;
   virtual void StopDataStorage() = 0;
   virtual void InitDataStorage() = 0;
-  virtual void OutputDataStorage(int out, std::vector<double> values) = 0;
-  virtual void DataStorageStatus(std::string value) = 0;
-  */
+  virtual void OutputDataStorage(int out, std::vector<double> & values) = 0;
+  virtual void DataStorageStatus(bool & storing, int & count) = 0;
 
   // low level methods
   virtual void SendCommand(const std::string &) = 0;
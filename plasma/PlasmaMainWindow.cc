@@ -40,7 +40,8 @@ PlasmaMainWindow::PlasmaMainWindow(QWidget *parent)
       NQLog("PlasmaMainWindow") << "SMCI36 PORT: " << *it;
 
       NanotecSMCI36Model * model = new NanotecSMCI36Model(it->c_str(),
-                                                          0.1, 5.0, this);
+                                                          config->getValue<double>("SMCI36_StatusUpdateInterval", 0.1),
+                                                          5.0, this);
 
       if (model->getDriveAddress()==driveAddress_X) {
         smci36ModelX_ = model;
@@ -136,7 +137,7 @@ PlasmaMainWindow::PlasmaMainWindow(QWidget *parent)
       );
 
 
-      smci36ModelX_->updateInformation2();
+      smci36ModelX_->refreshConfiguration();
       stageX_->updateInformation();
     }
 
@@ -10,52 +10,24 @@
 //                                                                             //
 /////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <deque>
+#include <future>
 #include <iostream>
+#include <thread>
 
 #include <QtCore>
-#include <QXmlStreamWriter>
+#include <QXmlStreamReader>
 #include <QFile>
-#include <QDirIterator>
 
 #include <TDatime.h>
 
 #include "Analyser.h"
 
-DataFileDate::DataFileDate()
-: date_(QDate()),
-  n_(0)
-{
-
-}
-
-DataFileDate::DataFileDate(const DataFileDate& other)
-: date_(other.getDate().year(), other.getDate().month(), other.getDate().day()),
-  n_(other.getNumber())
-{
-
-}
-
-DataFileDate::DataFileDate(const QDate& date, int n)
-: date_(date),
-  n_(n)
-{
-
-}
-
-DataFileDate::DataFileDate(int y, int m, int d, int n)
-: date_(y, m, d),
-  n_(n)
-{
-
-}
-
 Analyser::Analyser(QStringList& arguments)
-: arguments_(arguments),
-  measurementValid_(false)
+: arguments_(arguments)
 {
-  dataValid_ = false;
-  for (int i=0;i<5;++i) switchStateValid_[i] = false;
-  for (int i=0;i<3;++i) gaugeValid_[i] = false;
+
 }
 
 void Analyser::analyse()
@@ -112,37 +84,23 @@ void Analyser::analyse()
     hasEndDate = true;
   }
 
-  QDirIterator it(arguments_[1], QDirIterator::NoIteratorFlags);
-  while (it.hasNext()) {
-    QString filename = it.next();
-
-    if (!filename.endsWith(".xml")) continue;
-    if (!filename.contains("pumpstation_")) continue;
-
-    QString dateStamp = filename;
-
-    dateStamp.remove(".xml");
-    dateStamp.remove(0, dateStamp.indexOf("pumpstation_"));
-    dateStamp.remove("pumpstation_");
-
-    dateStamp.insert(6, "_");
-    dateStamp.insert(4, "_");
-
-    QStringList list = dateStamp.split('_', QString::SkipEmptyParts);
-    if (list.size()!=4) continue;
-
-    int y = list[0].toInt();
-    int m = list[1].toInt();
-    int d = list[2].toInt();
-    int n = list[3].toInt();
-
-    QDate date(y, m, d);
+  QDir dataDirectory(arguments_[1]);
+  DataFileIndex index(dataDirectory);
+  index.load();
+  int scanned = index.update();
+  if (scanned>0) {
+    std::cerr << "indexed " << scanned << " new or modified files" << std::endl;
+    if (!index.save()) {
+      std::cerr << "cannot write index to " << arguments_[1].toStdString() << std::endl;
+    }
+  }
 
-    if (hasStartDate && date<startDate) continue;
-    if (hasEndDate && date>endDate) continue;
+  QDateTime startTime;
+  if (hasStartDate) startTime = QDateTime(startDate, QTime(0, 0, 0));
+  QDateTime endTime;
+  if (hasEndDate) endTime = QDateTime(endDate, QTime(23, 59, 59));
 
-    fileMap_[DataFileDate(date, n)] = filename;
-  }
+  std::vector<DataFileSummary> files = index.select(startTime, endTime);
 
   QString filename = arguments_[0];
   if (!filename.endsWith(".root")) filename += ".root";
@@ -177,10 +135,39 @@ void Analyser::analyse()
     otree_->Branch(dummy1, &measurement_.pressure[i], dummy2);
   }
 
-  for (std::map<DataFileDate, QString>::iterator it = fileMap_.begin();
-      it!=fileMap_.end();
-      ++it) {
-    processFile(it->second);
+  // read files in a bounded window of parallel tasks, filling the tree in file order
+  const size_t window = std::max(1u, std::thread::hardware_concurrency());
+  std::deque<std::future<std::vector<Measurement_t> > > pending;
+
+  size_t next = 0;
+  while (next<files.size() || !pending.empty()) {
+
+    while (next<files.size() && pending.size()<window) {
+      const DataFileSummary& summary = files[next];
+      QString path = dataDirectory.absoluteFilePath(summary.getFilename());
+      qint64 offset = summary.getOffset(startTime);
+
+      std::cerr << "processing file: " << path.toLocal8Bit().constData();
+      if (offset>0) std::cerr << " from offset " << offset;
+      std::cerr << std::endl;
+
+      pending.push_back(std::async(std::launch::async, [path, offset, startTime, endTime]() {
+        DataFileReader reader(path, offset, startTime, endTime);
+        return reader.read();
+      }));
+      ++next;
+    }
+
+    std::vector<Measurement_t> measurements = pending.front().get();
+    pending.pop_front();
+
+    for (std::vector<Measurement_t>::iterator it = measurements.begin();
+         it!=measurements.end();
+         ++it) {
+      measurement_ = *it;
+      measurement_.datime = TDatime(measurement_.uTime);
+      otree_->Fill();
+    }
   }
 
   ofile_->Write();
@@ -189,109 +176,127 @@ void Analyser::analyse()
   QCoreApplication::quit();
 }
 
-void Analyser::processFile(const QString& filename)
+DataFileReader::DataFileReader(const QString& filename, qint64 offset,
+                               const QDateTime& start, const QDateTime& end)
+: filename_(filename),
+  offset_(offset),
+  start_(start),
+  end_(end),
+  dataValid_(false)
 {
-  std::cerr << "processing file: " << filename.toLocal8Bit().constData() << std::endl;
+  switchState_.fill(false);
+  switchStateValid_.fill(false);
+  gaugeState_.fill(false);
+  gaugePressure_.fill(0.0);
+  gaugeValid_.fill(false);
+}
 
-  QFile file(filename);
-  if (file.open(QFile::ReadOnly)) {
-    QXmlStreamReader reader(&file);
+std::vector<Measurement_t> DataFileReader::read()
+{
+  std::vector<Measurement_t> measurements;
+
+  QFile file(filename_);
+  if (!file.open(QFile::ReadOnly)) return measurements;
+
+  QXmlStreamReader reader;
+  if (offset_>0 && file.seek(offset_)) {
+    // checkpoints point between top level elements, so reopening the
+    // root element turns the remainder of the file into a document again
+    reader.addData(QByteArray("<PumpStationLog>"));
+    reader.addData(file.readAll());
+  } else {
+    reader.setDevice(&file);
+  }
 
-    while (!reader.atEnd()) {
+  while (!reader.atEnd()) {
 
-      QXmlStreamReader::TokenType tokentype = reader.readNext();
+    QXmlStreamReader::TokenType tokentype = reader.readNext();
 
-      if (tokentype==QXmlStreamReader::EndElement) {
+    if (tokentype==QXmlStreamReader::EndElement) {
 
-        if (reader.name()=="Status") {
-          if (dataValid_) {
-            dumpData();
-          }
+      if (reader.name()=="Status") {
+        if (dataValid_) {
+          dumpData(measurements);
         }
-
       }
 
-      if (tokentype==QXmlStreamReader::StartElement) {
+    }
 
-        QXmlStreamAttributes attributes = reader.attributes();
+    if (tokentype==QXmlStreamReader::StartElement) {
 
-        if (attributes.hasAttribute("time")) {
-          utime_ = QDateTime::fromString(attributes.value("time").toString(), Qt::ISODate);
-        }
+      QXmlStreamAttributes attributes = reader.attributes();
+
+      if (attributes.hasAttribute("time")) {
+        utime_ = QDateTime::fromString(attributes.value("time").toString(), Qt::ISODate);
+        if (end_.isValid() && utime_>end_) break;
+      }
 
-        if (reader.name()=="ConradSwitch") {
+      if (reader.name()=="ConradSwitch") {
 
-          if (attributes.hasAttribute("id") &&
-              attributes.hasAttribute("state")) {
-            int id = attributes.value("id").toString().toInt();
-            bool state = attributes.value("state").toString().toInt();
+        if (attributes.hasAttribute("id") &&
+            attributes.hasAttribute("state")) {
+          int id = attributes.value("id").toString().toInt();
+          bool state = attributes.value("state").toString().toInt();
 
-            switchState_[id] = state;
-            switchStateValid_[id] = true;
+          switchState_[id] = state;
+          switchStateValid_[id] = true;
 
-            if (attributes.hasAttribute("time")) {
-              dumpData();
-            }
+          if (attributes.hasAttribute("time") && dataValid_) {
+            dumpData(measurements);
           }
         }
+      }
 
-        if (reader.name()=="LeyboldGraphixThree") {
-          if (attributes.hasAttribute("id") &&
-              attributes.hasAttribute("status") &&
-              attributes.hasAttribute("p")) {
-            int id = attributes.value("id").toString().toInt() - 1;
-            bool state = attributes.value("status").toString().toInt();
-            float p = attributes.value("p").toString().toFloat();
-
-            gaugeState_[id] = state;
-            gaugeValid_[id] = true;
-            gaugePressure_[id] = p;
-
-            if (attributes.hasAttribute("time")) {
-              dumpData();
-            }
-          }
-        }
+      if (reader.name()=="LeyboldGraphixThree") {
+        if (attributes.hasAttribute("id") &&
+            attributes.hasAttribute("status") &&
+            attributes.hasAttribute("p")) {
+          int id = attributes.value("id").toString().toInt() - 1;
+          bool state = attributes.value("status").toString().toInt();
+          float p = attributes.value("p").toString().toFloat();
 
-        if (dataValid_==false) {
-          bool valid = true;
-          for (int i=0;i<5;++i) {
-            valid &= switchStateValid_[i];
-            //std::cout << switchStateValid_[i] << " ";
-          }
-          for (int i=0;i<3;++i) {
-            valid &= gaugeValid_[i];
-            //std::cout << gaugeValid_[i] << " ";
+          gaugeState_[id] = state;
+          gaugeValid_[id] = true;
+          gaugePressure_[id] = p;
+
+          if (attributes.hasAttribute("time") && dataValid_) {
+            dumpData(measurements);
           }
-          //std::cout << std::endl;
+        }
+      }
 
-          dataValid_ = valid;
+      if (dataValid_==false) {
+        bool valid = true;
+        for (int i=0;i<5;++i) {
+          valid &= switchStateValid_[i];
         }
+        for (int i=0;i<3;++i) {
+          valid &= gaugeValid_[i];
+        }
+
+        dataValid_ = valid;
       }
     }
   }
+
+  return measurements;
 }
 
-void Analyser::dumpData()
+void DataFileReader::dumpData(std::vector<Measurement_t>& measurements)
 {
-  // std::cout << utime_.toTime_t();
+  if (start_.isValid() && utime_<start_) return;
 
-  measurement_.uTime = utime_.toTime_t();
-  measurement_.datime = TDatime(measurement_.uTime);
+  Measurement_t measurement;
 
-  for (int i=0;i<5;++i) {
-    // std::cout << " " << switchState_[i];
+  measurement.uTime = utime_.toTime_t();
 
-    measurement_.switchState[i] = switchState_[i];
+  for (int i=0;i<5;++i) {
+    measurement.switchState[i] = switchState_[i];
   }
   for (int i=0;i<3;++i) {
-    // std::cout << " " << gaugeState_[i] << " " << std::scientific << gaugePressure_[i];
-
-    measurement_.gaugeState[i] = gaugeState_[i];
-    measurement_.pressure[i] = gaugePressure_[i];
+    measurement.gaugeState[i] = gaugeState_[i];
+    measurement.pressure[i] = gaugePressure_[i];
   }
 
-  // std::cout << std::endl;
-
-  otree_->Fill();
+  measurements.push_back(measurement);
 }
@@ -14,8 +14,8 @@
 #define ANALYSER_H
 
 #include <array>
-#include <map>
 #include <string>
+#include <vector>
 
 #include <QDateTime>
 #include <QStringList>
@@ -27,6 +27,8 @@
 #include <TTree.h>
 #include <TDatime.h>
 
+#include <DataFileIndex.h>
+
 typedef struct {
 	unsigned int   uTime;
 	TDatime        datime;
@@ -35,50 +37,49 @@ typedef struct {
 	double         pressure[3];
 } Measurement_t;
 
-class DataFileDate
+class Analyser : public QObject
 {
+  Q_OBJECT
+
 public:
 
-	DataFileDate();
-	DataFileDate(const DataFileDate& other);
-	DataFileDate(const QDate& date, int n);
-	DataFileDate(int y, int m, int d, int n);
+  Analyser(QStringList& arguments);
 
-	const QDate& getDate() const { return date_; }
-	int getNumber() const { return n_; }
+public slots:
 
-	bool operator<(const DataFileDate& other) const {
-		if (date_==other.date_) return (n_<other.n_);
-		return date_<other.date_;
-	}
+  void analyse();
 
-protected:
+private:
+
+  QStringList arguments_;
 
-	QDate date_;
-	int n_;
+  Measurement_t measurement_;
+  TFile *ofile_;
+  TTree *otree_;
 };
 
-class Analyser : public QObject
+/**
+  Reads the measurements of a single log file, starting at a checkpoint
+  offset taken from the DataFileIndex and restricted to [start, end].
+  Instances are independent of each other, so files can be read in parallel.
+  */
+class DataFileReader
 {
-  Q_OBJECT
-
 public:
 
-  Analyser(QStringList& arguments);
+  DataFileReader(const QString& filename, qint64 offset,
+                 const QDateTime& start, const QDateTime& end);
 
-public slots:
-
-  void analyse();
+  std::vector<Measurement_t> read();
 
 private:
 
-  void processFile(const QString& filename);
-  void dumpData();
+  void dumpData(std::vector<Measurement_t>& measurements);
 
-  QStringList arguments_;
-
-  QDir dataDirectory_;
-  std::map<DataFileDate, QString> fileMap_;
+  QString filename_;
+  qint64 offset_;
+  QDateTime start_;
+  QDateTime end_;
 
   QDateTime utime_;
   bool dataValid_;
@@ -87,11 +88,6 @@ private:
   std::array<bool,3> gaugeState_;
   std::array<float,3> gaugePressure_;
   std::array<bool,3> gaugeValid_;
-
-  bool measurementValid_;
-  Measurement_t measurement_;
-  TFile *ofile_;
-  TTree *otree_;
 };
 
 #endif // ANALYSER_H
@@ -132,6 +132,8 @@ void Controller::printHelp()
       " getSensorStatus <sensor (1-3)>                   get the status of a vacuum gauge\n"
       " getPressure <sensor (1-3)>                       get the pressure reading of a vacuum gauge\n"
       " getVacuumStatus                                  get the vacuum status (sensor status and pressure)\n"
+      "\n"
+      " getStatus                                        get switch, blocked, vacuum and pump hour status at once\n"
         << std::endl;
 
   QCoreApplication::quit();
@@ -0,0 +1,117 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <QDateTime>
+
+#include <nqlogger.h>
+
+#include "CommunicationHTTPServer.h"
+
+CommunicationHTTPServer::CommunicationHTTPServer(CommunicationServer* server,
+                                                 QObject *parent)
+ : QTcpServer(parent),
+   server_(server)
+{
+  // order of the fields returned by the getStatus command
+  statusKeys_ << "SwitchBlocked0" << "SwitchBlocked1" << "SwitchBlocked2"
+              << "SwitchBlocked3" << "SwitchBlocked4"
+              << "SwitchState0" << "SwitchState1" << "SwitchState2"
+              << "SwitchState3" << "SwitchState4"
+              << "SensorState0" << "Pressure0"
+              << "SensorState1" << "Pressure1"
+              << "SensorState2" << "Pressure2"
+              << "Pump0Hours" << "Pump1Hours";
+}
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
+void CommunicationHTTPServer::incomingConnection(int socketDescriptor)
+{
+#else
+void CommunicationHTTPServer::incomingConnection(qintptr socketDescriptor)
+{
+#endif
+  NQLogDebug("CommunicationHTTPServer") << "incomingConnection";
+
+  QTcpSocket* socket = new QTcpSocket(this);
+
+  connect(socket, SIGNAL(readyRead()),
+          this, SLOT(handleRequest()));
+  connect(socket, SIGNAL(disconnected()),
+          socket, SLOT(deleteLater()));
+
+  if (!socket->setSocketDescriptor(socketDescriptor)) {
+    socket->deleteLater();
+    return;
+  }
+}
+
+void CommunicationHTTPServer::handleRequest()
+{
+  QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+  if (!socket) return;
+
+  // wait for the complete request header
+  QByteArray header = socket->peek(socket->bytesAvailable());
+  if (!header.contains("\r\n\r\n")) {
+    if (header.size()>8192) {
+      sendResponse(socket, 400, "Bad Request", "text/plain", "ERR\n");
+    }
+    return;
+  }
+  socket->readAll();
+
+  QList<QByteArray> requestLine = header.left(header.indexOf("\r\n")).split(' ');
+  if (requestLine.size()<2 || requestLine.at(0)!="GET") {
+    sendResponse(socket, 405, "Method Not Allowed", "text/plain", "ERR\n");
+    return;
+  }
+
+  QByteArray path = requestLine.at(1);
+  if (path.contains('?')) path = path.left(path.indexOf('?'));
+
+  NQLogDebug("CommunicationHTTPServer") << "GET " << QString(path);
+
+  if (path=="/" || path=="/status" || path=="/PumpStationStatus.php") {
+    sendResponse(socket, 200, "OK", "application/json", statusJSON());
+  } else {
+    sendResponse(socket, 404, "Not Found", "text/plain", "ERR\n");
+  }
+}
+
+QByteArray CommunicationHTTPServer::statusJSON()
+{
+  QStringList values = server_->processCommand("getStatus").split(";");
+
+  QByteArray json = "{";
+  for (int i=0;i<statusKeys_.size() && i<values.size();++i) {
+    json += "\"" + statusKeys_.at(i).toLatin1() + "\":\"" + values.at(i).toLatin1() + "\",";
+  }
+  json += "\"Timestamp\":\"" + QDateTime::currentDateTime().toString(Qt::ISODate).toLatin1() + "\"}";
+
+  return json;
+}
+
+void CommunicationHTTPServer::sendResponse(QTcpSocket* socket, int code, const QByteArray& status,
+                                           const QByteArray& contentType, const QByteArray& body)
+{
+  QByteArray response;
+  response += "HTTP/1.0 " + QByteArray::number(code) + " " + status + "\r\n";
+  response += "Content-Type: " + contentType + "\r\n";
+  response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+  response += "Access-Control-Allow-Origin: *\r\n";
+  response += "Cache-Control: no-cache\r\n";
+  response += "Connection: close\r\n\r\n";
+  response += body;
+
+  socket->write(response);
+  socket->disconnectFromHost();
+}
@@ -0,0 +1,58 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef COMMUNICATIONHTTPSERVER_H
+#define COMMUNICATIONHTTPSERVER_H
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QStringList>
+
+#include "CommunicationServer.h"
+
+/**
+  Minimal HTTP server that answers "GET /status" with a JSON document
+  containing the complete pump station status (same keys as
+  PumpStationStatus.php). Every connection is handled independently, so
+  many dashboards can poll concurrently without starting processes.
+ */
+class CommunicationHTTPServer : public QTcpServer
+{
+  Q_OBJECT
+
+public:
+
+  CommunicationHTTPServer(CommunicationServer* server,
+                          QObject *parent = 0);
+
+protected slots:
+
+  void handleRequest();
+
+protected:
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
+  void incomingConnection(int socketDescriptor);
+#else
+  void incomingConnection(qintptr socketDescriptor);
+#endif
+
+  QByteArray statusJSON();
+  void sendResponse(QTcpSocket* socket, int code, const QByteArray& status,
+                    const QByteArray& contentType, const QByteArray& body);
+
+  CommunicationServer* server_;
+
+  QStringList statusKeys_;
+};
+
+#endif // COMMUNICATIONHTTPSERVER_H
@@ -49,15 +49,17 @@ void CommunicationServer::incomingConnection(int socketDescriptor)
     NQLogDebug("CommunicationServer") << "void CommunicationServer::incomingConnection(qintptr socketDescriptor)";
 #endif
 
-  socket_ = new QTcpSocket();
+  // every connection gets its own socket, so concurrent clients do not interfere
+  QTcpSocket* socket = new QTcpSocket(this);
 
-  connect(socket_, SIGNAL(readyRead()),
+  connect(socket, SIGNAL(readyRead()),
           this, SLOT(handleCommand()));
-  connect(socket_, SIGNAL(disconnected()),
-          socket_, SLOT(deleteLater()));
+  connect(socket, SIGNAL(disconnected()),
+          socket, SLOT(deleteLater()));
 
-  if (!socket_->setSocketDescriptor(socketDescriptor)) {
+  if (!socket->setSocketDescriptor(socketDescriptor)) {
     // emit error(tcpSocket->error());
+    socket->deleteLater();
     return;
   }
 }
@@ -66,7 +68,22 @@ void CommunicationServer::handleCommand()
 {
   NQLogDebug("CommunicationServer") << "void CommunicationServer::handleCommand()";
 
-  QDataStream in(socket_);
+  QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+  if (!socket) return;
+
+  // wait until the complete block (quint16 length, serialized QString) arrived
+  if (socket->bytesAvailable() < (qint64)(sizeof(quint16) + sizeof(quint32))) return;
+
+  QByteArray header = socket->peek(sizeof(quint16) + sizeof(quint32));
+  QDataStream headerStream(header);
+  headerStream.setVersion(QDataStream::Qt_4_0);
+  quint16 length;
+  quint32 stringSize;
+  headerStream >> length >> stringSize;
+  if (stringSize!=0xffffffff &&
+      socket->bytesAvailable() < (qint64)(sizeof(quint16) + sizeof(quint32) + stringSize)) return;
+
+  QDataStream in(socket);
   in.setVersion(QDataStream::Qt_4_0);
 
   quint16 blockSize = 0;
@@ -77,6 +94,20 @@ void CommunicationServer::handleCommand()
 
   NQLogDebug("CommunicationServer") << "command: (" << blockSize << ") |" << command.toStdString() << "|";
 
+  QString response = processCommand(command);
+
+  QByteArray block;
+  QDataStream out(&block, QIODevice::WriteOnly);
+  out.setVersion(QDataStream::Qt_4_0);
+  out << (quint16)response.length();
+  out << response;
+
+  socket->write(block);
+  socket->disconnectFromHost();
+}
+
+QString CommunicationServer::processCommand(const QString& command)
+{
   QStringList args = command.split(" ");
   QString cmd = args.at(0);
   args.removeAt(0);
@@ -314,17 +345,35 @@ void CommunicationServer::handleCommand()
               .arg(s2).arg(p2, 0, 'E', 3)
               .arg(s3).arg(p3, 0, 'E', 3);
     }
+  } else if (cmd=="getStatus") {
+    if (args.count()!=0) {
+      response = "ERR";
+    } else {
+
+      // everything the status page needs in a single round trip:
+      // 5 blocked flags; 5 switch states; 3 x (sensor status; pressure); 2 pump hours
+      QMutexLocker locker(&mutex_);
+
+      QStringList fields;
+      for (int channel=0;channel<5;++channel) {
+        fields << QString::number((int)model_->getSwitchBlocked(channel));
+      }
+      for (int channel=0;channel<5;++channel) {
+        fields << QString::number((int)model_->getSwitchState(channel));
+      }
+      for (int sensor=1;sensor<=3;++sensor) {
+        fields << QString::number(model_->getSensorStatus(sensor));
+        fields << QString("%1").arg(model_->getPressure(sensor), 0, 'E', 3);
+      }
+      for (int pump=1;pump<=2;++pump) {
+        fields << QString("%1").arg(model_->getPumpOperatingHours(pump), 0, 'f', 6);
+      }
+
+      response = fields.join(";");
+    }
   } else {
     response = "ERR";
   }
 
-  QByteArray block;
-  QDataStream out(&block, QIODevice::WriteOnly);
-  out.setVersion(QDataStream::Qt_4_0);
-  out << (quint16)response.length();
-  out << response;
-
-  socket_->write(block);
-  socket_->disconnectFromHost();
-  socket_->waitForDisconnected();
+  return response;
 }
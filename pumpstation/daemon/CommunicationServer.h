@@ -30,6 +30,9 @@ public:
   CommunicationServer(PumpStationModel* model,
                       QObject *parent = 0);
 
+  /// Executes a single space-separated command and returns the response.
+  QString processCommand(const QString& command);
+
 protected slots:
 
   void handleCommand();
@@ -53,7 +56,6 @@ protected:
   std::vector<int> pumpChannels_;
   std::vector<int> valveChannels_;
 
-  QTcpSocket* socket_;
   QMutex mutex_;
 };
 
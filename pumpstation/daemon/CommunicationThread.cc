@@ -23,7 +23,9 @@
 CommunicationThread::CommunicationThread(PumpStationModel* model,
                                          QObject *parent)
  : QThread(parent),
-   model_(model)
+   model_(model),
+   server_(0),
+   httpServer_(0)
 {
 
 }
@@ -59,5 +61,18 @@ void CommunicationThread::run()
                        << ":"
                        << server_->serverPort();
 
+  // optional HTTP/JSON status endpoint (disabled if HTTPServerPort is 0)
+  quint16 httpPort = ApplicationConfig::instance()->getValue("HTTPServerPort", 0);
+  if (httpPort!=0) {
+    httpServer_ = new CommunicationHTTPServer(server_);
+
+    if (!httpServer_->listen(QHostAddress::Any, httpPort)) {
+      NQLog("pumpstation") << "Unable to start the HTTP server: " << httpServer_->errorString().toStdString();
+    } else {
+      NQLog("pumpstation") << "HTTP status server listening on port "
+                           << httpServer_->serverPort();
+    }
+  }
+
   exec();
 }
@@ -19,6 +19,7 @@
 #include <PumpStationModel.h>
 
 #include "CommunicationServer.h"
+#include "CommunicationHTTPServer.h"
 
 class CommunicationThread : public QThread
 {
@@ -36,6 +37,7 @@ protected:
   PumpStationModel* model_;
 
   CommunicationServer* server_;
+  CommunicationHTTPServer* httpServer_;
 };
 
 #endif // COMMUNICATIONTHREAD_H
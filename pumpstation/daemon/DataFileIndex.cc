@@ -0,0 +1,453 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <future>
+#include <thread>
+#include <utility>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QRegExp>
+#include <QStringList>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+#include "DataFileIndex.h"
+
+const char* DataFileIndex::IndexFilename = "PumpStationIndex.xml";
+
+DataFileDate::DataFileDate()
+: date_(QDate()),
+  n_(0)
+{
+
+}
+
+DataFileDate::DataFileDate(const DataFileDate& other)
+: date_(other.getDate().year(), other.getDate().month(), other.getDate().day()),
+  n_(other.getNumber())
+{
+
+}
+
+DataFileDate::DataFileDate(const QDate& date, int n)
+: date_(date),
+  n_(n)
+{
+
+}
+
+DataFileDate::DataFileDate(int y, int m, int d, int n)
+: date_(y, m, d),
+  n_(n)
+{
+
+}
+
+bool DataFileDate::fromFilename(const QString& filename, DataFileDate& date)
+{
+  QRegExp rx("pumpstation_(\\d{4})(\\d{2})(\\d{2})_(\\d+)\\.xml$");
+  if (rx.indexIn(filename)==-1) return false;
+
+  QDate d(rx.cap(1).toInt(), rx.cap(2).toInt(), rx.cap(3).toInt());
+  if (!d.isValid()) return false;
+
+  date = DataFileDate(d, rx.cap(4).toInt());
+
+  return true;
+}
+
+DataFileSummary::DataFileSummary()
+: size_(0),
+  modified_(0),
+  complete_(false)
+{
+  switchState_.fill(-1);
+  switchHours_.fill(0.0);
+  pressureValid_.fill(false);
+  pressureMin_.fill(0.0);
+  pressureMax_.fill(0.0);
+}
+
+DataFileSummary::DataFileSummary(const QString& filename)
+: DataFileSummary()
+{
+  filename_ = filename;
+}
+
+void DataFileSummary::setFileInfo(qint64 size, uint modified)
+{
+  size_ = size;
+  modified_ = modified;
+}
+
+void DataFileSummary::addTime(const QDateTime& time)
+{
+  if (!time.isValid()) return;
+
+  if (!firstTime_.isValid()) {
+    firstTime_ = time;
+    lastTime_ = time;
+    return;
+  }
+
+  if (time<=lastTime_) return;
+
+  double dt = lastTime_.secsTo(time) / 3600.;
+  for (int i=0;i<5;++i) {
+    if (switchState_[i]==1) switchHours_[i] += dt;
+  }
+
+  lastTime_ = time;
+}
+
+void DataFileSummary::addCheckpoint(qint64 offset, const QDateTime& time)
+{
+  if (!checkpoints_.empty() &&
+      checkpoints_.back().time.secsTo(time)<CheckpointInterval) return;
+
+  Checkpoint_t checkpoint;
+  checkpoint.offset = offset;
+  checkpoint.time = time;
+  checkpoints_.push_back(checkpoint);
+}
+
+void DataFileSummary::setSwitchState(int id, int state)
+{
+  if (id<0 || id>=5) return;
+  switchState_[id] = state;
+}
+
+void DataFileSummary::addPressure(int sensor, double p)
+{
+  if (sensor<1 || sensor>3) return;
+  int idx = sensor - 1;
+
+  if (!pressureValid_[idx]) {
+    pressureValid_[idx] = true;
+    pressureMin_[idx] = p;
+    pressureMax_[idx] = p;
+    return;
+  }
+
+  pressureMin_[idx] = std::min(pressureMin_[idx], p);
+  pressureMax_[idx] = std::max(pressureMax_[idx], p);
+}
+
+void DataFileSummary::setSwitchHours(int id, double hours)
+{
+  if (id<0 || id>=5) return;
+  switchHours_[id] = hours;
+}
+
+void DataFileSummary::setPressureRange(int sensor, double pmin, double pmax)
+{
+  if (sensor<1 || sensor>3) return;
+  pressureValid_[sensor-1] = true;
+  pressureMin_[sensor-1] = pmin;
+  pressureMax_[sensor-1] = pmax;
+}
+
+bool DataFileSummary::overlaps(const QDateTime& start, const QDateTime& end) const
+{
+  if (!firstTime_.isValid()) return false;
+  if (start.isValid() && lastTime_<start) return false;
+  if (end.isValid() && firstTime_>end) return false;
+  return true;
+}
+
+qint64 DataFileSummary::getOffset(const QDateTime& time) const
+{
+  if (!time.isValid()) return 0;
+
+  std::vector<Checkpoint_t>::const_iterator it =
+    std::upper_bound(checkpoints_.begin(), checkpoints_.end(), time,
+                     [](const QDateTime& t, const Checkpoint_t& c) { return t<c.time; });
+  if (it==checkpoints_.begin()) return 0;
+  --it;
+
+  return it->offset;
+}
+
+DataFileIndex::DataFileIndex(const QDir& directory)
+: directory_(directory)
+{
+
+}
+
+bool DataFileIndex::load()
+{
+  summaries_.clear();
+
+  QFile file(directory_.absoluteFilePath(IndexFilename));
+  if (!file.open(QFile::ReadOnly)) return false;
+
+  QXmlStreamReader reader(&file);
+
+  DataFileDate key;
+  DataFileSummary summary;
+  bool inFile = false;
+
+  while (!reader.atEnd()) {
+
+    QXmlStreamReader::TokenType tokentype = reader.readNext();
+
+    if (tokentype==QXmlStreamReader::StartElement) {
+
+      QXmlStreamAttributes attributes = reader.attributes();
+
+      if (reader.name()=="File") {
+        QString name = attributes.value("name").toString();
+        inFile = DataFileDate::fromFilename(name, key);
+        if (!inFile) continue;
+
+        summary = DataFileSummary(name);
+        summary.setFileInfo(attributes.value("size").toString().toLongLong(),
+                            attributes.value("modified").toString().toUInt());
+        summary.setComplete(attributes.value("complete").toString().toInt());
+        summary.addTime(QDateTime::fromString(attributes.value("first").toString(), Qt::ISODate));
+        summary.addTime(QDateTime::fromString(attributes.value("last").toString(), Qt::ISODate));
+      }
+
+      if (!inFile) continue;
+
+      if (reader.name()=="Switch") {
+        summary.setSwitchHours(attributes.value("id").toString().toInt(),
+                               attributes.value("hours").toString().toDouble());
+      }
+
+      if (reader.name()=="Gauge") {
+        summary.setPressureRange(attributes.value("id").toString().toInt(),
+                                 attributes.value("min").toString().toDouble(),
+                                 attributes.value("max").toString().toDouble());
+      }
+
+      if (reader.name()=="Checkpoint") {
+        summary.addCheckpoint(attributes.value("offset").toString().toLongLong(),
+                              QDateTime::fromString(attributes.value("time").toString(), Qt::ISODate));
+      }
+    }
+
+    if (tokentype==QXmlStreamReader::EndElement && reader.name()=="File") {
+      if (inFile) summaries_[key] = summary;
+      inFile = false;
+    }
+  }
+
+  return !reader.hasError();
+}
+
+bool DataFileIndex::save() const
+{
+  QString filename = directory_.absoluteFilePath(IndexFilename);
+  QString tmpname = filename + ".tmp";
+
+  QFile file(tmpname);
+  if (!file.open(QFile::WriteOnly | QFile::Truncate)) return false;
+
+  QXmlStreamWriter xml(&file);
+  xml.setAutoFormatting(true);
+
+  xml.writeStartDocument();
+  xml.writeStartElement("PumpStationIndex");
+  xml.writeAttribute("version", "1");
+
+  for (std::map<DataFileDate,DataFileSummary>::const_iterator it = summaries_.begin();
+       it!=summaries_.end();
+       ++it) {
+    const DataFileSummary& s = it->second;
+
+    xml.writeStartElement("File");
+    xml.writeAttribute("name", s.getFilename());
+    xml.writeAttribute("size", QString::number(s.getSize()));
+    xml.writeAttribute("modified", QString::number(s.getModified()));
+    xml.writeAttribute("complete", QString::number((int)s.isComplete()));
+    xml.writeAttribute("first", s.getFirstTime().toString(Qt::ISODate));
+    xml.writeAttribute("last", s.getLastTime().toString(Qt::ISODate));
+
+    for (int i=0;i<5;++i) {
+      xml.writeStartElement("Switch");
+      xml.writeAttribute("id", QString::number(i));
+      xml.writeAttribute("hours", QString::number(s.getSwitchHours(i), 'f', 6));
+      xml.writeEndElement();
+    }
+
+    for (int i=1;i<4;++i) {
+      if (!s.isPressureValid(i)) continue;
+      xml.writeStartElement("Gauge");
+      xml.writeAttribute("id", QString::number(i));
+      xml.writeAttribute("min", QString::number(s.getPressureMin(i), 'e', 6));
+      xml.writeAttribute("max", QString::number(s.getPressureMax(i), 'e', 6));
+      xml.writeEndElement();
+    }
+
+    for (std::vector<DataFileSummary::Checkpoint_t>::const_iterator itc = s.getCheckpoints().begin();
+         itc!=s.getCheckpoints().end();
+         ++itc) {
+      xml.writeStartElement("Checkpoint");
+      xml.writeAttribute("offset", QString::number(itc->offset));
+      xml.writeAttribute("time", itc->time.toString(Qt::ISODate));
+      xml.writeEndElement();
+    }
+
+    xml.writeEndElement();
+  }
+
+  xml.writeEndElement();
+  xml.writeEndDocument();
+
+  file.close();
+  if (file.error()!=QFile::NoError) return false;
+
+  // rename is atomic, so concurrent readers never see a partially written index
+  return std::rename(QFile::encodeName(tmpname).constData(),
+                     QFile::encodeName(filename).constData())==0;
+}
+
+int DataFileIndex::update()
+{
+  std::vector<std::pair<DataFileDate,QString> > toScan;
+  std::map<DataFileDate,DataFileSummary> current;
+
+  QStringList entries = directory_.entryList(QStringList() << "pumpstation_*.xml",
+                                             QDir::Files);
+  for (QStringList::const_iterator it = entries.begin();
+       it!=entries.end();
+       ++it) {
+    DataFileDate key;
+    if (!DataFileDate::fromFilename(*it, key)) continue;
+
+    QFileInfo fi(directory_.absoluteFilePath(*it));
+
+    std::map<DataFileDate,DataFileSummary>::const_iterator itS = summaries_.find(key);
+    if (itS!=summaries_.end() &&
+        itS->second.getSize()==fi.size() &&
+        itS->second.getModified()==fi.lastModified().toTime_t()) {
+      current[key] = itS->second;
+    } else {
+      toScan.push_back(std::make_pair(key, *it));
+    }
+  }
+
+  // scan in a bounded window of concurrent tasks
+  const size_t window = std::max(1u, std::thread::hardware_concurrency());
+  std::deque<std::pair<DataFileDate,std::future<DataFileSummary> > > pending;
+
+  QDir dir = directory_;
+  size_t next = 0;
+  while (next<toScan.size() || !pending.empty()) {
+
+    while (next<toScan.size() && pending.size()<window) {
+      QString path = dir.absoluteFilePath(toScan[next].second);
+      QString name = toScan[next].second;
+      pending.push_back(std::make_pair(toScan[next].first,
+                                       std::async(std::launch::async, [path, name]() {
+        DataFileSummary summary(name);
+        DataFileIndex::scanFile(path, summary);
+        return summary;
+      })));
+      ++next;
+    }
+
+    current[pending.front().first] = pending.front().second.get();
+    pending.pop_front();
+  }
+
+  summaries_.swap(current);
+
+  return toScan.size();
+}
+
+void DataFileIndex::insert(const DataFileSummary& summary)
+{
+  DataFileDate key;
+  if (!DataFileDate::fromFilename(summary.getFilename(), key)) return;
+  summaries_[key] = summary;
+}
+
+std::vector<DataFileSummary> DataFileIndex::select(const QDateTime& start,
+                                                   const QDateTime& end) const
+{
+  std::vector<DataFileSummary> selection;
+
+  for (std::map<DataFileDate,DataFileSummary>::const_iterator it = summaries_.begin();
+       it!=summaries_.end();
+       ++it) {
+    if (it->second.overlaps(start, end)) selection.push_back(it->second);
+  }
+
+  return selection;
+}
+
+bool DataFileIndex::scanFile(const QString& filename, DataFileSummary& summary)
+{
+  QFile file(filename);
+  if (!file.open(QFile::ReadOnly)) return false;
+
+  QXmlStreamReader reader(&file);
+
+  int depth = 0;
+  qint64 resumeOffset = 0;
+
+  while (!reader.atEnd()) {
+
+    QXmlStreamReader::TokenType tokentype = reader.readNext();
+
+    if (tokentype==QXmlStreamReader::StartElement) {
+      ++depth;
+
+      // the log is plain ASCII, so character and byte offsets coincide
+      if (depth==1) resumeOffset = reader.characterOffset();
+
+      QXmlStreamAttributes attributes = reader.attributes();
+
+      QDateTime time;
+      if (attributes.hasAttribute("time")) {
+        time = QDateTime::fromString(attributes.value("time").toString(), Qt::ISODate);
+      }
+
+      if (depth==2 && reader.name()=="Status" && time.isValid()) {
+        summary.addCheckpoint(resumeOffset, time);
+      }
+
+      summary.addTime(time);
+
+      if (reader.name()=="ConradSwitch" &&
+          attributes.hasAttribute("id") &&
+          attributes.hasAttribute("state")) {
+        summary.setSwitchState(attributes.value("id").toString().toInt(),
+                               attributes.value("state").toString().toInt());
+      }
+
+      if (reader.name()=="LeyboldGraphixThree" &&
+          attributes.hasAttribute("id") &&
+          attributes.hasAttribute("p")) {
+        summary.addPressure(attributes.value("id").toString().toInt(),
+                            attributes.value("p").toString().toDouble());
+      }
+    }
+
+    if (tokentype==QXmlStreamReader::EndElement) {
+      --depth;
+      if (depth<=1) resumeOffset = reader.characterOffset();
+    }
+  }
+
+  QFileInfo fi(filename);
+  summary.setFileInfo(fi.size(), fi.lastModified().toTime_t());
+  summary.setComplete(!reader.hasError());
+
+  return true;
+}
@@ -0,0 +1,149 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DATAFILEINDEX_H
+#define DATAFILEINDEX_H
+
+#include <array>
+#include <map>
+#include <vector>
+
+#include <QString>
+#include <QDate>
+#include <QDateTime>
+#include <QDir>
+
+class DataFileDate
+{
+public:
+
+	DataFileDate();
+	DataFileDate(const DataFileDate& other);
+	DataFileDate(const QDate& date, int n);
+	DataFileDate(int y, int m, int d, int n);
+
+	const QDate& getDate() const { return date_; }
+	int getNumber() const { return n_; }
+
+	bool operator<(const DataFileDate& other) const {
+		if (date_==other.date_) return (n_<other.n_);
+		return date_<other.date_;
+	}
+
+	/// parses pumpstation_YYYYMMDD_NN.xml; returns false for any other name
+	static bool fromFilename(const QString& filename, DataFileDate& date);
+
+protected:
+
+	QDate date_;
+	int n_;
+};
+
+/**
+  Summary of a single pumpstation_YYYYMMDD_NN.xml log file: covered time
+  range, hours each switch spent in READY state, pressure range per gauge
+  and byte offsets of Status elements at which reading can be resumed.
+  */
+class DataFileSummary
+{
+public:
+
+  typedef struct {
+    qint64    offset;
+    QDateTime time;
+  } Checkpoint_t;
+
+  /// minimum spacing of checkpoints in seconds
+  static const int CheckpointInterval = 300;
+
+  DataFileSummary();
+  DataFileSummary(const QString& filename);
+
+  const QString& getFilename() const { return filename_; }
+  qint64 getSize() const { return size_; }
+  uint getModified() const { return modified_; }
+  bool isComplete() const { return complete_; }
+
+  const QDateTime& getFirstTime() const { return firstTime_; }
+  const QDateTime& getLastTime() const { return lastTime_; }
+  double getSwitchHours(int id) const { return switchHours_[id]; }
+  bool isPressureValid(int sensor) const { return pressureValid_[sensor-1]; }
+  double getPressureMin(int sensor) const { return pressureMin_[sensor-1]; }
+  double getPressureMax(int sensor) const { return pressureMax_[sensor-1]; }
+  const std::vector<Checkpoint_t>& getCheckpoints() const { return checkpoints_; }
+
+  void setFileInfo(qint64 size, uint modified);
+  void setComplete(bool complete) { complete_ = complete; }
+
+  void addTime(const QDateTime& time);
+  void addCheckpoint(qint64 offset, const QDateTime& time);
+  void setSwitchState(int id, int state);
+  void addPressure(int sensor, double p);
+  void setSwitchHours(int id, double hours);
+  void setPressureRange(int sensor, double pmin, double pmax);
+
+  bool overlaps(const QDateTime& start, const QDateTime& end) const;
+
+  /// offset of the last checkpoint not later than time (0 if none)
+  qint64 getOffset(const QDateTime& time) const;
+
+protected:
+
+  QString filename_;
+  qint64 size_;
+  uint modified_;
+  bool complete_;
+
+  QDateTime firstTime_;
+  QDateTime lastTime_;
+  std::array<int,5> switchState_;
+  std::array<double,5> switchHours_;
+  std::array<bool,3> pressureValid_;
+  std::array<double,3> pressureMin_;
+  std::array<double,3> pressureMax_;
+  std::vector<Checkpoint_t> checkpoints_;
+};
+
+/**
+  Persistent index of DataFileSummary objects, stored as XML next to the
+  log files. update() only rescans files that are new or whose size or
+  modification time changed since they were last indexed.
+  */
+class DataFileIndex
+{
+public:
+
+  static const char* IndexFilename;
+
+  DataFileIndex(const QDir& directory);
+
+  bool load();
+  bool save() const;
+
+  /// rescans new or modified data files in parallel; returns number of files scanned
+  int update();
+
+  void insert(const DataFileSummary& summary);
+
+  /// summaries overlapping [start, end] in file order; invalid times are open ends
+  std::vector<DataFileSummary> select(const QDateTime& start,
+                                      const QDateTime& end) const;
+
+  static bool scanFile(const QString& filename, DataFileSummary& summary);
+
+protected:
+
+  QDir directory_;
+  std::map<DataFileDate,DataFileSummary> summaries_;
+};
+
+#endif // DATAFILEINDEX_H
@@ -18,6 +18,7 @@
 #include <iostream>
 
 #include <QApplication>
+#include <QFileInfo>
 #include <QMutexLocker>
 #include <QProcess>
 #include <QXmlStreamWriter>
@@ -104,6 +105,8 @@ void DataLogger::start()
   ofilename_ = currentDir_.absoluteFilePath(filename);
   ofile_ = new QFile(ofilename_);
 
+  summary_ = DataFileSummary(filename);
+
   NQLog("logger") << "streaming to file " << ofilename_.toStdString();
 
   if (ofile_->open(QFile::WriteOnly | QFile::Truncate)) {
@@ -160,11 +163,23 @@ void DataLogger::stop()
   xml_->writeEndDocument();
 
   //stream_->device()->close();
+  ofile_->close();
   delete ofile_;
   delete xml_;
   //delete stream_;
 
   isStreaming_ = false;
+
+  QFileInfo fi(ofilename_);
+  summary_.setFileInfo(fi.size(), fi.lastModified().toTime_t());
+  summary_.setComplete(true);
+
+  DataFileIndex index(currentDir_);
+  index.load();
+  index.insert(summary_);
+  if (!index.save()) {
+    NQLogWarning("DataLogger") << "could not update index in " << currentDir_.absolutePath().toStdString();
+  }
 }
 
 void DataLogger::checkRestart()
@@ -188,10 +203,15 @@ void DataLogger::writeStatus()
 
   QDateTime utime = QDateTime::currentDateTime();
 
+  summary_.addCheckpoint(ofile_->pos(), utime);
+  summary_.addTime(utime);
+
   xml_->writeStartElement("Status");
   xml_->writeAttribute("time", utime.toString(Qt::ISODate));
 
   for (int i=0;i<5;++i) {
+    summary_.setSwitchState(i, (int)model_->getSwitchState(i));
+
     xml_->writeStartElement("ConradSwitch");
     xml_->writeAttribute("id", QString::number(i));
     xml_->writeAttribute("state", QString::number((int)model_->getSwitchState(i)));
@@ -199,6 +219,8 @@ void DataLogger::writeStatus()
   }
 
   for (int i=1;i<4;++i) {
+    summary_.addPressure(i, model_->getPressure(i));
+
     xml_->writeStartElement("LeyboldGraphixThree");
     xml_->writeAttribute("id", QString::number(i));
     xml_->writeAttribute("status", QString::number(model_->getSensorStatus(i)));
@@ -221,6 +243,9 @@ void DataLogger::switchStateChanged(int device, State newState)
 
   QDateTime utime = QDateTime::currentDateTime();
 
+  summary_.addTime(utime);
+  summary_.setSwitchState(device, (int)newState);
+
   xml_->writeStartElement("ConradSwitch");
   xml_->writeAttribute("time", utime.toString(Qt::ISODate));
   xml_->writeAttribute("id", QString::number(device));
@@ -238,6 +263,9 @@ void DataLogger::pressureChanged(int sensor, double p)
 
   QDateTime utime = QDateTime::currentDateTime();
 
+  summary_.addTime(utime);
+  summary_.addPressure(sensor, p);
+
   xml_->writeStartElement("LeyboldGraphixThree");
   xml_->writeAttribute("time", utime.toString(Qt::ISODate));
   xml_->writeAttribute("id", QString::number(sensor));
@@ -26,6 +26,8 @@
 #include <PumpStationModel.h>
 #include <CommunicationThread.h>
 
+#include "DataFileIndex.h"
+
 class DataLogger : public QObject
 {
   Q_OBJECT
@@ -74,6 +76,7 @@ protected:
   QDateTime fileDateTime_;
   QTimer* restartTimer_;
   QTimer* statusTimer_;
+  DataFileSummary summary_;
 
   void writeToStream(QString& buffer);
 
@@ -14,21 +14,12 @@
 
 $ini_array = parse_ini_file ( "pumpstation.ini" );
 
-$command = $ini_array ['DocumentRoot'] . "/PumpStationControl --web getSwitchBlockedStatus";
-exec ( $command, $switchblocked, $return );
-list ($SwitchBlocked0, $SwitchBlocked1, $SwitchBlocked2, $SwitchBlocked3, $SwitchBlocked4) = split(';', $switchblocked[0]);
-
-$command = $ini_array ['DocumentRoot'] . "/PumpStationControl --web getSwitchStatus";
-exec ( $command, $switchstate, $return );
-list ($SwitchState0, $SwitchState1, $SwitchState2, $SwitchState3, $SwitchState4) = split(';', $switchstate[0]);
-
-$command = $ini_array ['DocumentRoot'] . "/PumpStationControl --web getVacuumStatus";
-exec ( $command, $vacuumstate, $return );
-list ($SensorState0, $Pressure0, $SensorState1, $Pressure1, $SensorState2, $Pressure2) = split(';', $vacuumstate[0]);
-
-$command = $ini_array ['DocumentRoot'] . "/PumpStationControl --web getPumpOperatingHours";
-exec ( $command, $pumphours, $return );
-list ($Pump0Hours, $Pump1Hours) = split(';', $pumphours[0]);
+$command = $ini_array ['DocumentRoot'] . "/PumpStationControl --web getStatus";
+exec ( $command, $status, $return );
+list ($SwitchBlocked0, $SwitchBlocked1, $SwitchBlocked2, $SwitchBlocked3, $SwitchBlocked4,
+      $SwitchState0, $SwitchState1, $SwitchState2, $SwitchState3, $SwitchState4,
+      $SensorState0, $Pressure0, $SensorState1, $Pressure1, $SensorState2, $Pressure2,
+      $Pump0Hours, $Pump1Hours) = split(';', $status[0]);
 
 $Timestamp = date('c');
 
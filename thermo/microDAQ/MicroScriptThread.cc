@@ -12,6 +12,8 @@ MicroScriptThread::MicroScriptThread(MicroScriptModel* scriptModel,
                                      ArduinoPresModel* arduinoPresModel,
                                      QObject *parent) :
     QThread(parent),
+    engine_(0),
+    runtime_(0),
     scriptModel_(scriptModel),
     iotaModel_(iotaModel),
     arduinoPresModel_(arduinoPresModel)
@@ -25,6 +27,7 @@ void MicroScriptThread::executeScript(const QString & script)
 
     engine_ = new QScriptEngine();
     engine_->setProcessEventsInterval(1000);
+    runtime_ = new ScriptRuntime(engine_);
 
     MicroScriptableGlobals *globalsObj = new MicroScriptableGlobals(scriptModel_, this);
     QScriptValue globalsValue = engine_->newQObject(globalsObj);
@@ -44,9 +47,10 @@ void MicroScriptThread::executeScript(const QString & script)
 void MicroScriptThread::abortScript()
 {
     NQLog("MicroScriptThread") << "abort";
-    if (engine_) {
+    QMutexLocker locker(&mutex_);
+    if (runtime_) {
         NQLog("MicroScriptThread") << "abort " << (int)engine_->isEvaluating();
-        engine_->abortEvaluation();
+        runtime_->abort();
         //delete engine_;
         //engine_ = 0;
         //terminate();
@@ -55,16 +59,17 @@ void MicroScriptThread::abortScript()
 
 void MicroScriptThread::run()
 {
-    if (engine_->canEvaluate(script_)) {
-        QScriptValue fun = engine_->evaluate(script_);
-        //QScriptContext * context = engine_->pushContext();
-        //QScriptValue v = context->activationObject();
-        //v.setProperty("fun", fun);
-        //engine_->evaluate("fun()");
-        //engine_->popContext();
-        delete engine_;
+    runtime_->evaluate(script_, "microDAQ script");
+
+    // cleared before the delete, so that a concurrent abortScript() does not use them
+    QScriptEngine* engine;
+    {
+        QMutexLocker locker(&mutex_);
+        engine = engine_;
         engine_ = 0;
-    } else {
-        qDebug() << script_;
+        runtime_ = 0;
     }
+
+    // the engine owns and deletes the runtime
+    delete engine;
 }
@@ -3,8 +3,11 @@
 
 #include <QObject>
 #include <QThread>
+#include <QMutex>
 #include <QScriptEngine>
 
+#include "ScriptRuntime.h"
+
 class MicroScriptModel;
 
 #include "IotaModel.h"
@@ -26,6 +29,9 @@ protected:
 
     QString script_;
     QScriptEngine* engine_;
+    ScriptRuntime* runtime_;
+    // guards engine_ and runtime_ between abortScript() and the end of run()
+    QMutex mutex_;
 
     MicroScriptModel* scriptModel_;
     IotaModel* iotaModel_;
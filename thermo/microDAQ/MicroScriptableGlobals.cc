@@ -10,6 +10,7 @@
 
 #include <nqlogger.h>
 #include <SlackBot.h>
+#include <ScriptRuntime.h>
 
 #include "MicroScriptableGlobals.h"
 
@@ -32,23 +33,22 @@ void MicroScriptableGlobals::stopMeasurement() {
 
 void MicroScriptableGlobals::wait(int seconds) {
 
-  static QString TIME_FORMAT = "yyyy-MM-dd hh:mm:ss";
+  ScriptRuntime::waitLogged(seconds, "microDAQ", [this](const QString& text) { this->message(text); });
+}
+
+void MicroScriptableGlobals::waitPeriod(int seconds) {
 
-  QString message;
-  QDateTime dt = QDateTime::currentDateTime().addSecs(seconds);
+  ScriptRuntime::waitPeriodLogged(seconds, "microDAQ", [this](const QString& text) { this->message(text); });
+}
 
-  message = QString("wait for %1 second(s)").arg(seconds);
-  this->message(message);
-  NQLog("MicroDAQ") << message;
+void MicroScriptableGlobals::waitUntil(uint utime) {
 
-  message = QString("estimated time of completion: %1 ...").arg(dt.toString(TIME_FORMAT));
-  this->message(message);
-  NQLog("MicroDAQ") << message;
+  ScriptRuntime::waitUntilLogged(utime, "microDAQ", [this](const QString& text) { this->message(text); });
+}
 
-  sleep(seconds);
+QScriptValue MicroScriptableGlobals::waitFor(QScriptValue condition, int timeout, int interval) {
 
-  this->message("done");
-  NQLog("MicroDAQ") << "done";
+  return QScriptValue(ScriptRuntime::waitForLogged(condition, timeout, interval, "microDAQ"));
 }
 
 void MicroScriptableGlobals::message(int value) {
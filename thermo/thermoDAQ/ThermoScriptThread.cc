@@ -32,6 +32,8 @@ ThermoScriptThread::ThermoScriptThread(ThermoScriptModel* scriptModel,
                                        ArduinoPresModel* arduinoPresModel,
                                        QObject *parent) :
     QThread(parent),
+    engine_(0),
+    runtime_(0),
     scriptModel_(scriptModel),
     huberModel_(huberModel),
     keithleyModel_(keithleyModel),
@@ -49,6 +51,7 @@ void ThermoScriptThread::executeScript(const QString & script)
 
   engine_ = new QScriptEngine();
   engine_->setProcessEventsInterval(1000);
+  runtime_ = new ScriptRuntime(engine_);
 
   ThermoScriptableGlobals *globalsObj = new ThermoScriptableGlobals(scriptModel_, this);
   QScriptValue globalsValue = engine_->newQObject(globalsObj);
@@ -84,9 +87,10 @@ void ThermoScriptThread::executeScript(const QString & script)
 void ThermoScriptThread::abortScript()
 {
   NQLog("ThermoScriptThread") << "abort";
-  if (engine_) {
+  QMutexLocker locker(&mutex_);
+  if (runtime_) {
     NQLog("ThermoScriptThread") << "abort " << (int)engine_->isEvaluating();
-    engine_->abortEvaluation();
+    runtime_->abort();
     //delete engine_;
     //engine_ = 0;
     //terminate();
@@ -95,16 +99,17 @@ void ThermoScriptThread::abortScript()
 
 void ThermoScriptThread::run()
 {
-  if (engine_->canEvaluate(script_)) {
-    QScriptValue fun = engine_->evaluate(script_);
-    //QScriptContext * context = engine_->pushContext();
-    //QScriptValue v = context->activationObject();
-    //v.setProperty("fun", fun);
-    //engine_->evaluate("fun()");
-    //engine_->popContext();
-    delete engine_;
+  runtime_->evaluate(script_, "thermoDAQ script");
+
+  // cleared before the delete, so that a concurrent abortScript() does not use them
+  QScriptEngine* engine;
+  {
+    QMutexLocker locker(&mutex_);
+    engine = engine_;
     engine_ = 0;
-  } else {
-    qDebug() << script_;
+    runtime_ = 0;
   }
+
+  // the engine owns and deletes the runtime
+  delete engine;
 }
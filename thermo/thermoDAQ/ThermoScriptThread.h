@@ -15,8 +15,11 @@
 
 #include <QObject>
 #include <QThread>
+#include <QMutex>
 #include <QScriptEngine>
 
+#include "ScriptRuntime.h"
+
 class ThermoScriptModel;
 
 #include "HuberPetiteFleurModel.h"
@@ -46,6 +49,9 @@ protected:
 
   QString script_;
   QScriptEngine* engine_;
+  ScriptRuntime* runtime_;
+  // guards engine_ and runtime_ between abortScript() and the end of run()
+  QMutex mutex_;
 
   ThermoScriptModel* scriptModel_;
   HuberPetiteFleurModel* huberModel_;
@@ -22,6 +22,7 @@
 
 #include <nqlogger.h>
 #include <SlackBot.h>
+#include <ScriptRuntime.h>
 
 #include "ThermoScriptableGlobals.h"
 
@@ -44,23 +45,22 @@ void ThermoScriptableGlobals::stopMeasurement() {
 
 void ThermoScriptableGlobals::wait(int seconds) {
 
-  static QString TIME_FORMAT = "yyyy-MM-dd hh:mm:ss";
+  ScriptRuntime::waitLogged(seconds, "thermoDAQ", [this](const QString& text) { this->message(text); });
+}
+
+void ThermoScriptableGlobals::waitPeriod(int seconds) {
 
-  QString message;
-  QDateTime dt = QDateTime::currentDateTime().addSecs(seconds);
+  ScriptRuntime::waitPeriodLogged(seconds, "thermoDAQ", [this](const QString& text) { this->message(text); });
+}
 
-  message = QString("wait for %1 second(s)").arg(seconds);
-  this->message(message);
-  NQLog("thermoDAQ") << message;
+void ThermoScriptableGlobals::waitUntil(uint utime) {
 
-  message = QString("estimated time of completion: %1 ...").arg(dt.toString(TIME_FORMAT));
-  this->message(message);
-  NQLog("thermoDAQ") << message;
+  ScriptRuntime::waitUntilLogged(utime, "thermoDAQ", [this](const QString& text) { this->message(text); });
+}
 
-  sleep(seconds);
+QScriptValue ThermoScriptableGlobals::waitFor(QScriptValue condition, int timeout, int interval) {
 
-  this->message("done");
-  NQLog("thermoDAQ") << "done";
+  return QScriptValue(ScriptRuntime::waitForLogged(condition, timeout, interval, "thermoDAQ"));
 }
 
 void ThermoScriptableGlobals::message(int value) {
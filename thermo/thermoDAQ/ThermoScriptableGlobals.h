@@ -35,6 +35,9 @@ public slots:
   void stopDAQ() { stopMeasurement(); }
 
   void wait(int seconds);
+  void waitPeriod(int seconds);
+  void waitUntil(uint utime);
+  QScriptValue waitFor(QScriptValue condition, int timeout, int interval = 1);
   void message(int value);
   void message(uint value);
   void message(double value);